@@ -25,31 +25,22 @@ const int JSON_MAJOR_VERSION = 2;
 const int JSON_MINOR_VERSION = 23;
 
 JsonObjects::JsonObjects() {
-    toplevel = new Util::JsonObject();
-    meta = new Util::JsonObject();
-    header_types = insert_array_field(toplevel, "header_types"_cs);
-    headers = insert_array_field(toplevel, "headers"_cs);
-    header_stacks = insert_array_field(toplevel, "header_stacks"_cs);
-    header_union_types = insert_array_field(toplevel, "header_union_types"_cs);
-    header_unions = insert_array_field(toplevel, "header_unions"_cs);
-    header_union_stacks = insert_array_field(toplevel, "header_union_stacks"_cs);
-    field_lists = insert_array_field(toplevel, "field_lists"_cs);
-    errors = insert_array_field(toplevel, "errors"_cs);
-    enums = insert_array_field(toplevel, "enums"_cs);
-    parsers = insert_array_field(toplevel, "parsers"_cs);
-    parse_vsets = insert_array_field(toplevel, "parse_vsets"_cs);
-    deparsers = insert_array_field(toplevel, "deparsers"_cs);
-    meter_arrays = insert_array_field(toplevel, "meter_arrays"_cs);
-    counters = insert_array_field(toplevel, "counter_arrays"_cs);
-    register_arrays = insert_array_field(toplevel, "register_arrays"_cs);
-    calculations = insert_array_field(toplevel, "calculations"_cs);
-    learn_lists = insert_array_field(toplevel, "learn_lists"_cs);
-    actions = insert_array_field(toplevel, "actions"_cs);
-    pipelines = insert_array_field(toplevel, "pipelines"_cs);
-    checksums = insert_array_field(toplevel, "checksums"_cs);
-    force_arith = insert_array_field(toplevel, "force_arith"_cs);
-    externs = insert_array_field(toplevel, "extern_instances"_cs);
-    field_aliases = insert_array_field(toplevel, "field_aliases"_cs);
+    header_stacks = new Util::JsonArray();
+    header_union_types = new Util::JsonArray();
+    header_unions = new Util::JsonArray();
+    header_union_stacks = new Util::JsonArray();
+    field_lists = new Util::JsonArray();
+    parse_vsets = new Util::JsonArray();
+    deparsers = new Util::JsonArray();
+    meter_arrays = new Util::JsonArray();
+    counters = new Util::JsonArray();
+    register_arrays = new Util::JsonArray();
+    calculations = new Util::JsonArray();
+    learn_lists = new Util::JsonArray();
+    checksums = new Util::JsonArray();
+    force_arith = new Util::JsonArray();
+    externs = new Util::JsonArray();
+    field_aliases = new Util::JsonArray();
 }
 
 Util::JsonArray *JsonObjects::get_field_list_contents(unsigned id) const {
@@ -90,17 +81,95 @@ Util::JsonArray *JsonObjects::create_parameters(Util::JsonObject *object) {
     return insert_array_field(object, "parameters"_cs);
 }
 
-void JsonObjects::add_program_info(const cstring &name) { toplevel->emplace("program", name); }
+void JsonObjects::add_program_info(const cstring &name) { program = name; }
 
-void JsonObjects::add_meta_info() {
-    static constexpr int version_major = JSON_MAJOR_VERSION;
-    static constexpr int version_minor = JSON_MINOR_VERSION;
-    auto version = insert_array_field(meta, "version"_cs);
-    version->append(version_major);
-    version->append(version_minor);
-    meta->emplace("compiler", "https://github.com/p4lang/p4c");
-    toplevel->emplace("__meta__", meta);
+void JsonObjects::add_meta_info() { meta_info = true; }
+
+void JsonObjects::serialize(Util::JsonWriter &out) const {
+    out.beginObject();
+    out.key("header_types").beginArray();
+    for (auto ht : header_types) {
+        out.beginObject().member("name", ht->name).member("id", ht->id);
+        out.member("fields", ht->fields);
+        if (ht->max_length > 0) out.member("max_length", ht->max_length);
+        out.endObject();
+    }
+    out.endArray();
+    out.key("headers").beginArray();
+    for (const auto &h : headers) {
+        out.beginObject().member("name", h.name).member("id", h.id);
+        out.member("header_type", h.type).member("metadata", h.metadata);
+        out.member("pi_omit", true).endObject();
+    }
+    out.endArray();
+    out.member("header_stacks", header_stacks);
+    out.member("header_union_types", header_union_types);
+    out.member("header_unions", header_unions);
+    out.member("header_union_stacks", header_union_stacks);
+    out.member("field_lists", field_lists);
+    out.key("errors").beginArray();
+    for (const auto &[name, type] : error_codes)
+        out.beginArray(true).value(name).value(type).endArray();
+    out.endArray();
+    out.key("enums").beginArray();
+    for (const auto &[name, entries] : enum_entries) {
+        out.beginObject().member("name", name);
+        out.key("entries").beginArray();
+        for (const auto &[entry_name, entry_value] : entries)
+            out.beginArray(true).value(entry_name).value(entry_value).endArray();
+        out.endArray().endObject();
+    }
+    out.endArray();
+    out.key("parsers").beginArray();
+    for (auto p : parsers) {
+        out.beginObject().member("name", p->name).member("id", p->id);
+        out.member("init_state", IR::ParserState::start);
+        out.key("parse_states").beginArray();
+        for (auto state : p->states) {
+            out.beginObject().member("name", state->name).member("id", state->id);
+            out.member("parser_ops", state->ops).member("transitions", state->transitions);
+            out.member("transition_key", state->key).endObject();
+        }
+        out.endArray().endObject();
+    }
+    out.endArray();
+    out.member("parse_vsets", parse_vsets);
+    out.member("deparsers", deparsers);
+    out.member("meter_arrays", meter_arrays);
+    out.member("counter_arrays", counters);
+    out.member("register_arrays", register_arrays);
+    out.member("calculations", calculations);
+    out.member("learn_lists", learn_lists);
+    out.key("actions").beginArray();
+    for (const auto &a : actions) {
+        out.beginObject().member("name", a.name).member("id", a.id);
+        out.member("runtime_data", a.params).member("primitives", a.body).endObject();
+    }
+    out.endArray();
+    out.key("pipelines").beginArray();
+    for (const auto &p : pipelines) {
+        out.beginObject().member("name", p.name).member("id", p.id);
+        if (p.source_info) out.member("source_info", p.source_info);
+        out.member("init_table", p.init_table);
+        out.member("tables", p.tables).member("action_profiles", p.action_profiles);
+        out.member("conditionals", p.conditionals).endObject();
+    }
+    out.endArray();
+    out.member("checksums", checksums);
+    out.member("force_arith", force_arith);
+    out.member("extern_instances", externs);
+    out.member("field_aliases", field_aliases);
+    if (program) out.member("program", program);
+    if (meta_info) {
+        out.key("__meta__").beginObject();
+        out.key("version").beginArray(true).value(JSON_MAJOR_VERSION).value(JSON_MINOR_VERSION);
+        out.endArray();
+        out.member("compiler", "https://github.com/p4lang/p4c");
+        out.endObject();
+    }
+    out.endObject();
 }
+
 /// Create a header type in json.
 /// @param name header name
 /// @param type header type
@@ -114,19 +183,10 @@ unsigned JsonObjects::add_header_type(const cstring &name, Util::JsonArray *&fie
     if (header_type_id_it != header_type_id.end()) {
         return header_type_id_it->second;
     }
-    auto header_type = new Util::JsonObject();
     unsigned id = BMV2::nextId("header_types"_cs);
     header_type_id[sname] = id;
-    header_type->emplace("name", name);
-    header_type->emplace("id", id);
-    if (fields != nullptr) {
-        header_type->emplace("fields"_cs, fields);
-    } else {
-        auto temp = new Util::JsonArray();
-        header_type->emplace("fields"_cs, temp);
-    }
-    if (max_length > 0) header_type->emplace("max_length", max_length);
-    header_types->append(header_type);
+    if (fields == nullptr) fields = new Util::JsonArray();
+    header_types.push_back(new HeaderType{name, id, fields, max_length});
     return id;
 }
 
@@ -155,35 +215,29 @@ unsigned JsonObjects::add_header_type(const cstring &name) {
     if (header_type_id_it != header_type_id.end()) {
         return header_type_id_it->second;
     }
-    auto header_type = new Util::JsonObject();
     unsigned id = BMV2::nextId("header_types"_cs);
     header_type_id[sname] = id;
-    header_type->emplace("name", name);
-    header_type->emplace("id", id);
-    auto temp = new Util::JsonArray();
-    header_type->emplace("fields", temp);
-    header_types->append(header_type);
+    header_types.push_back(new HeaderType{name, id, new Util::JsonArray(), 0});
     return id;
 }
 
+JsonObjects::HeaderType *JsonObjects::find_header_type(const cstring &name) const {
+    for (auto ht : header_types)
+        if (ht->name == name) return ht;
+    return nullptr;
+}
+
 void JsonObjects::add_header_field(const cstring &name, Util::JsonArray *&field) {
     CHECK_NULL(field);
-    Util::JsonObject *headerType = find_object_by_name(header_types, name);
-    Util::JsonArray *fields = headerType->getAs<Util::JsonArray>("fields");
-    BUG_CHECK(fields != nullptr, "header '%1%' not found", name);
-    fields->append(field);
+    auto headerType = find_header_type(name);
+    BUG_CHECK(headerType != nullptr, "header '%1%' not found", name);
+    headerType->fields->append(field);
 }
 
 unsigned JsonObjects::add_header(const cstring &type, const cstring &name) {
-    auto header = new Util::JsonObject();
     unsigned id = BMV2::nextId("headers"_cs);
     LOG1("add header id " << id);
-    header->emplace("name", name);
-    header->emplace("id", id);
-    header->emplace("header_type", type);
-    header->emplace("metadata", false);
-    header->emplace("pi_omit", true);
-    headers->append(header);
+    headers.push_back({name, id, type, false});
     return id;
 }
 
@@ -202,15 +256,9 @@ unsigned JsonObjects::add_union(const cstring &type, Util::JsonArray *&headers,
 }
 
 unsigned JsonObjects::add_metadata(const cstring &type, const cstring &name) {
-    auto header = new Util::JsonObject();
     unsigned id = BMV2::nextId("headers"_cs);
     LOG3("add metadata header id " << id);
-    header->emplace("name", name);
-    header->emplace("id", id);
-    header->emplace("header_type", type);
-    header->emplace("metadata", true);
-    header->emplace("pi_omit", true);  // Don't expose in PI.
-    headers->append(header);
+    headers.push_back({name, id, type, true});
     return id;
 }
 
@@ -247,45 +295,23 @@ void JsonObjects::add_header_union_stack(const cstring &type, const cstring &nam
 }
 
 void JsonObjects::add_error(const cstring &name, const unsigned type) {
-    auto arr = append_array(errors);
-    arr->append(name);
-    arr->append(type);
+    error_codes.emplace_back(name, type);
 }
 
 void JsonObjects::add_enum(const cstring &enum_name, const cstring &entry_name,
                            const unsigned entry_value) {
-    // look up enum in json by name
-    Util::JsonObject *enum_json = find_object_by_name(enums, enum_name);
-    if (enum_json == nullptr) {  // first entry in a new enum
-        enum_json = new Util::JsonObject();
-        enum_json->emplace("name", enum_name);
-        auto entries = insert_array_field(enum_json, "entries"_cs);
-        auto entry = new Util::JsonArray();
-        entry->append(entry_name);
-        entry->append(entry_value);
-        entries->append(entry);
-        enums->append(enum_json);
+    auto &entries = enum_entries[enum_name];
+    if (entries.empty())
         LOG3("new enum object: " << enum_name << " " << entry_name << " " << entry_value);
-    } else {  // add entry to existing enum
-        auto entries = enum_json->getAs<Util::JsonArray>("entries");
-        auto entry = new Util::JsonArray();
-        entry->append(entry_name);
-        entry->append(entry_value);
-        entries->append(entry);
+    else
         LOG3("new enum entry: " << enum_name << " " << entry_name << " " << entry_value);
-    }
+    entries.emplace_back(entry_name, entry_value);
 }
 
 unsigned JsonObjects::add_parser(const cstring &name) {
-    auto parser = new Util::JsonObject();
     unsigned id = BMV2::nextId("parser"_cs);
-    parser->emplace("name", name);
-    parser->emplace("id", id);
-    parser->emplace("init_state", IR::ParserState::start);
-    auto parse_states = new Util::JsonArray();
-    parser->emplace("parse_states", parse_states);
-    parsers->append(parser);
-
+    auto parser = new Parser{name, id, {}};
+    parsers.push_back(parser);
     map_parser.emplace(id, parser);
     return id;
 }
@@ -293,48 +319,32 @@ unsigned JsonObjects::add_parser(const cstring &name) {
 unsigned JsonObjects::add_parser_state(const unsigned parser_id, const cstring &state_name) {
     if (map_parser.find(parser_id) == map_parser.end()) BUG("parser %1% not found.", parser_id);
     auto parser = map_parser[parser_id];
-    auto states = parser->getAs<Util::JsonArray>("parse_states");
-    auto state = new Util::JsonObject();
     unsigned state_id = BMV2::nextId("parse_states"_cs);
-    state->emplace("name", state_name);
-    state->emplace("id", state_id);
-    auto operations = new Util::JsonArray();
-    state->emplace("parser_ops", operations);
-    auto transitions = new Util::JsonArray();
-    state->emplace("transitions", transitions);
-    states->append(state);
-    auto key = new Util::JsonArray();
-    state->emplace("transition_key", key);
-
+    auto state = new ParserState{state_name, state_id};
+    parser->states.push_back(state);
     map_parser_state.emplace(state_id, state);
     return state_id;
 }
 
+JsonObjects::ParserState *JsonObjects::find_parser_state(unsigned state_id) const {
+    auto it = map_parser_state.find(state_id);
+    if (it == map_parser_state.end()) BUG("parser state %1% not found.", state_id);
+    return it->second;
+}
+
 void JsonObjects::add_parser_transition(const unsigned state_id, Util::IJson *transition) {
-    if (map_parser_state.find(state_id) == map_parser_state.end())
-        BUG("parser state %1% not found.", state_id);
-    auto state = map_parser_state[state_id];
-    auto transitions = state->getAs<Util::JsonArray>("transitions");
-    CHECK_NULL(transitions);
     auto trans = transition->to<Util::JsonObject>();
     CHECK_NULL(trans);
-    transitions->append(trans);
+    find_parser_state(state_id)->transitions->append(trans);
 }
 
 void JsonObjects::add_parser_op(const unsigned state_id, Util::IJson *op) {
-    if (map_parser_state.find(state_id) == map_parser_state.end())
-        BUG("parser state %1% not found.", state_id);
-    auto state = map_parser_state[state_id];
-    auto statements = state->getAs<Util::JsonArray>("parser_ops");
-    CHECK_NULL(statements);
-    statements->append(op);
+    find_parser_state(state_id)->ops->append(op);
 }
 
 void JsonObjects::add_parser_transition_key(const unsigned state_id, Util::IJson *newKey) {
     if (map_parser_state.find(state_id) != map_parser_state.end()) {
-        auto state = map_parser_state[state_id];
-        auto keys = state->getAs<Util::JsonArray>("transition_key");
-        CHECK_NULL(keys);
+        auto keys = map_parser_state.at(state_id)->key;
         auto new_keys = newKey->to<Util::JsonArray>();
         for (auto k : *new_keys) {
             keys->append(k);
@@ -357,16 +367,20 @@ unsigned JsonObjects::add_action(const cstring &name, Util::JsonArray *&params,
                                  Util::JsonArray *&body) {
     CHECK_NULL(params);
     CHECK_NULL(body);
-    auto action = new Util::JsonObject();
-    action->emplace("name", name);
     unsigned id = BMV2::nextId("actions"_cs);
-    action->emplace("id", id);
-    action->emplace("runtime_data", params);
-    action->emplace("primitives", body);
-    actions->append(action);
+    actions.push_back({name, id, params, body});
     return id;
 }
 
+void JsonObjects::add_pipeline(const cstring &name, unsigned id, Util::IJson *source_info,
+                               Util::IJson *init_table, Util::JsonArray *tables,
+                               Util::JsonArray *action_profiles, Util::JsonArray *conditionals) {
+    CHECK_NULL(tables);
+    CHECK_NULL(action_profiles);
+    CHECK_NULL(conditionals);
+    pipelines.push_back({name, id, source_info, init_table, tables, action_profiles, conditionals});
+}
+
 void JsonObjects::add_extern_attribute(const cstring &name, const cstring &type,
                                        const cstring &value, Util::JsonArray *attributes) {
     auto attr = new Util::JsonObject();
@@ -18,6 +18,8 @@ limitations under the License.
 #define BACKENDS_BMV2_COMMON_JSONOBJECTS_H_
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "lib/json.h"
 #include "lib/ordered_map.h"
@@ -39,6 +41,13 @@ class JsonObjects {
     /// @brief Adds meta information to the JsonObject.
     void add_meta_info();
 
+    /// @brief Writes the whole program to @p out.
+    /// The program name, meta information, errors, enums, header types, headers, parsers,
+    /// actions and pipelines are kept as plain records and streamed here; only the pieces the
+    /// converters build (fields, parser ops, primitives, tables, ...) are JSON trees. The
+    /// other sections are written from their JSON trees.
+    void serialize(Util::JsonWriter &out) const;
+
     /// @brief Create a header type in json.
     /// @param name header name
     /// @param type header type
@@ -151,6 +160,18 @@ class JsonObjects {
     /// @return The ID of the newly created action.
     unsigned add_action(const cstring &name, Util::JsonArray *&params, Util::JsonArray *&body);
 
+    /// @brief Adds a pipeline to the JSON representation.
+    /// @param name The name of the pipeline.
+    /// @param id The ID of the pipeline.
+    /// @param source_info The source information of the control, may be nullptr.
+    /// @param init_table The name of the first table or conditional, nullptr if the pipeline
+    /// is empty.
+    /// @param tables, action_profiles, conditionals The contents of the pipeline; they may
+    /// still be extended until the program is serialized.
+    void add_pipeline(const cstring &name, unsigned id, Util::IJson *source_info,
+                      Util::IJson *init_table, Util::JsonArray *tables,
+                      Util::JsonArray *action_profiles, Util::JsonArray *conditionals);
+
     /// @brief Adds an extern attribute to the JSON representation.
     /// @param name The name of the attribute.
     /// @param type The type of the attribute.
@@ -166,7 +187,7 @@ class JsonObjects {
     void add_extern(const cstring &name, const cstring &type, Util::JsonArray *attributes);
 
     /// @brief Constructs a new JsonObjects instance.
-    /// Initializes the top-level JsonObject and other member arrays.
+    /// Initializes the member arrays.
     JsonObjects();
 
     /// @brief Inserts a JSON array into a parent object under a specified key.
@@ -195,23 +216,13 @@ class JsonObjects {
     /// found.
     Util::JsonArray *get_field_list_contents(unsigned id) const;
 
-    std::map<unsigned, Util::JsonObject *> map_parser;
-    std::map<unsigned, Util::JsonObject *> map_parser_state;
-
-    Util::JsonObject *toplevel;
-    Util::JsonObject *meta;
-    Util::JsonArray *actions;
     Util::JsonArray *calculations;
     Util::JsonArray *checksums;
     Util::JsonArray *counters;
     Util::JsonArray *deparsers;
-    Util::JsonArray *enums;
-    Util::JsonArray *errors;
     Util::JsonArray *externs;
     Util::JsonArray *field_lists;
-    Util::JsonArray *headers;
     Util::JsonArray *header_stacks;
-    Util::JsonArray *header_types;
     Util::JsonArray *header_union_types;
     Util::JsonArray *header_unions;
     Util::JsonArray *header_union_stacks;
@@ -219,12 +230,66 @@ class JsonObjects {
     ordered_map<std::string, unsigned> union_type_id;
     Util::JsonArray *learn_lists;
     Util::JsonArray *meter_arrays;
-    Util::JsonArray *parsers;
     Util::JsonArray *parse_vsets;
-    Util::JsonArray *pipelines;
     Util::JsonArray *register_arrays;
     Util::JsonArray *force_arith;
     Util::JsonArray *field_aliases;
+
+ private:
+    struct HeaderType {
+        cstring name;
+        unsigned id;
+        Util::JsonArray *fields;
+        unsigned max_length;
+    };
+    struct Header {
+        cstring name;
+        unsigned id;
+        cstring type;
+        bool metadata;
+    };
+    struct ParserState {
+        cstring name;
+        unsigned id;
+        Util::JsonArray *ops = new Util::JsonArray();
+        Util::JsonArray *transitions = new Util::JsonArray();
+        Util::JsonArray *key = new Util::JsonArray();
+    };
+    struct Parser {
+        cstring name;
+        unsigned id;
+        std::vector<ParserState *> states;
+    };
+    struct Action {
+        cstring name;
+        unsigned id;
+        Util::JsonArray *params;
+        Util::JsonArray *body;
+    };
+    struct Pipeline {
+        cstring name;
+        unsigned id;
+        Util::IJson *source_info;
+        Util::IJson *init_table;
+        Util::JsonArray *tables;
+        Util::JsonArray *action_profiles;
+        Util::JsonArray *conditionals;
+    };
+
+    HeaderType *find_header_type(const cstring &name) const;
+    ParserState *find_parser_state(unsigned state_id) const;
+
+    cstring program;
+    bool meta_info = false;
+    std::vector<std::pair<cstring, unsigned>> error_codes;
+    ordered_map<cstring, std::vector<std::pair<cstring, unsigned>>> enum_entries;
+    std::vector<HeaderType *> header_types;
+    std::vector<Header> headers;
+    std::vector<Parser *> parsers;
+    std::map<unsigned, Parser *> map_parser;
+    std::map<unsigned, ParserState *> map_parser_state;
+    std::vector<Action> actions;
+    std::vector<Pipeline> pipelines;
 };
 
 }  // namespace P4::BMV2
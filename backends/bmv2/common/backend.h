@@ -78,7 +78,11 @@ class Backend {
           json(new BMV2::JsonObjects()) {
         refMap->setIsV1(options.isv1());
     }
-    void serialize(std::ostream &out) const { json->toplevel->serialize(out); }
+    void serialize(std::ostream &out) const {
+        Util::JsonWriter writer(out);
+        json->serialize(writer);
+        BUG_CHECK(writer.complete(), "incomplete bmv2 json output");
+    }
     virtual void convert(const IR::ToplevelBlock *block) = 0;
 };
 
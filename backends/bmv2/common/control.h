@@ -766,29 +766,24 @@ class ControlConverter : public Inspector {
  public:
     const bool emitExterns;
     bool preorder(const IR::P4Control *cont) override {
-        auto result = new Util::JsonObject();
-
-        result->emplace("name", name);
-        result->emplace("id", nextId("control"_cs));
-        result->emplace_non_null("source_info"_cs, cont->sourceInfoJsonObj());
+        unsigned id = nextId("control"_cs);
 
         auto cfg = new CFG();
         cfg->build(cont, ctxt->refMap, ctxt->typeMap);
         bool success = cfg->checkImplementable();
         if (!success) return false;
 
-        if (cfg->entryPoint->successors.size() == 0) {
-            result->emplace("init_table", Util::JsonValue::null);
-        } else {
+        Util::IJson *init_table = nullptr;
+        if (cfg->entryPoint->successors.size() != 0) {
             BUG_CHECK(cfg->entryPoint->successors.size() == 1, "Expected 1 start node for %1%",
                       cont);
             auto start = (*(cfg->entryPoint->successors.edges.begin()))->endpoint;
-            result->emplace("init_table", nodeName(start));
+            init_table = nodeName(start);
         }
 
-        auto tables = mkArrayField(result, "tables"_cs);
-        auto action_profiles = mkArrayField(result, "action_profiles"_cs);
-        auto conditionals = mkArrayField(result, "conditionals"_cs);
+        auto tables = new Util::JsonArray();
+        auto action_profiles = new Util::JsonArray();
+        auto conditionals = new Util::JsonArray();
         ctxt->action_profiles = action_profiles;
 
         auto selector_check = new BMV2::SharedActionSelectorCheck<arch>(ctxt);
@@ -836,7 +831,8 @@ class ControlConverter : public Inspector {
             P4C_UNIMPLEMENTED("%1%: not yet handled", c);
         }
 
-        ctxt->json->pipelines->append(result);
+        ctxt->json->add_pipeline(name, id, cont->sourceInfoJsonObj(), init_table, tables,
+                                 action_profiles, conditionals);
         return false;
     }
 
@@ -92,7 +92,8 @@ void DpdkBackend::convert(const IR::ToplevelBlock *tlb) {
         new P4::TypeChecking(refMap, typeMap, true),
         new ConvertBinaryOperationTo2Params(refMap),
         new CollectProgramStructure(refMap, typeMap, &structure),
-        new CopyMatchKeysToSingleStruct(typeMap, &invokedInKey, &structure),
+        new CopyMatchKeysToSingleStruct(typeMap, &invokedInKey, &structure,
+                                        options.enableKeyLayoutOpt),
         new P4::ResolveReferences(refMap),
         new CollectLocalVariables(refMap, typeMap, &structure),
         new P4::ClearTypeMap(typeMap),
@@ -151,6 +152,10 @@ void DpdkBackend::convert(const IR::ToplevelBlock *tlb) {
         new EliminateUnusedAction(),
         new DpdkAsmOptimization,
         new CopyPropagationAndElimination(typeMap),
+    });
+    if (options.enableInstrFusion) postCodeGen.addPasses({new FuseHeaderFieldAccess});
+    if (options.enableCfgOpt) postCodeGen.addPasses({new DpdkCfgOptimization});
+    postCodeGen.addPasses({
         new CollectUsedMetadataField(usedFields),
         new RemoveUnusedMetadataFields(usedFields),
         new ShortenTokenLength(newNameMap),
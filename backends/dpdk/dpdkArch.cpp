@@ -22,6 +22,8 @@ limitations under the License.
 
 #include "dpdkArch.h"
 
+#include <algorithm>
+
 #include "dpdkHelpers.h"
 #include "dpdkUtils.h"
 #include "frontends/common/resolveReferences/referenceMap.h"
@@ -1672,42 +1674,50 @@ const IR::Node *CopyMatchKeysToSingleStruct::preorder(IR::Key *keys) {
     return keys;
 }
 
-const IR::Node *CopyMatchKeysToSingleStruct::postorder(IR::KeyElement *element) {
-    // If we got here we need to put the key element in metadata.
-    LOG3("Extracting key element " << element);
-    auto table = findOrigCtxt<IR::P4Table>();
-    auto control = findOrigCtxt<IR::P4Control>();
-    CHECK_NULL(table);
-    P4::TableInsertions *insertions;
+P4::TableInsertions *CopyMatchKeysToSingleStruct::getInsertions(const IR::P4Table *table) {
     auto it = toInsert.find(table);
-    if (it == toInsert.end()) {
-        insertions = new P4::TableInsertions();
-        toInsert.emplace(table, insertions);
-    } else {
-        insertions = it->second;
-    }
+    if (it != toInsert.end()) return it->second;
+    auto insertions = new P4::TableInsertions();
+    toInsert.emplace(table, insertions);
+    return insertions;
+}
 
-    cstring keyName = getTableKeyName(element->expression);
-    if (keyName.isNullOrEmpty()) return element;
-    bool isHeader = false;
+// Returns the name of the metadata copy for the key field 'keyName', or an empty string
+// when the field is used in place.
+cstring CopyMatchKeysToSingleStruct::getKeyCopyName(cstring keyName,
+                                                    const IR::P4Control *control,
+                                                    const IR::P4Table *table) {
     // All header fields are prefixed with "h." and metadata fields are prefixed with "m."
     // Prefix the match field with control and table name
     if (keyName.startsWith("h.")) {
-        isHeader = true;
         keyName = keyName.replace('.', '_');
-        keyName =
-            keyName.replace("h_", control->name.toString() + "_" + table->name.toString() + "_");
+        return keyName.replace("h_", control->name.toString() + "_" + table->name.toString() + "_");
     } else if (metaCopyNeeded) {
         if (keyName.startsWith("m.")) {
             keyName = keyName.replace('.', '_');
-            keyName = keyName.replace(
-                "m_", control->name.toString() + "_" + table->name.toString() + "_");
-        } else {
-            keyName = control->name.toString() + "_" + table->name.toString() + "_" + keyName;
+            return keyName.replace("m_",
+                                   control->name.toString() + "_" + table->name.toString() + "_");
         }
+        return control->name.toString() + "_" + table->name.toString() + "_" + keyName;
     }
+    return cstring::empty;
+}
 
-    if (isHeader || metaCopyNeeded) {
+const IR::Node *CopyMatchKeysToSingleStruct::postorder(IR::KeyElement *element) {
+    // With the layout optimization the key is copied as a whole in postorder(IR::Key *)
+    if (optimizeKeyLayout) return element;
+    // If we got here we need to put the key element in metadata.
+    LOG3("Extracting key element " << element);
+    auto table = findOrigCtxt<IR::P4Table>();
+    auto control = findOrigCtxt<IR::P4Control>();
+    CHECK_NULL(table);
+    auto insertions = getInsertions(table);
+
+    cstring keyName = getTableKeyName(element->expression);
+    if (keyName.isNullOrEmpty()) return element;
+    keyName = getKeyCopyName(keyName, control, table);
+
+    if (!keyName.isNullOrEmpty()) {
         IR::ID keyNameId(nameGen.newName(keyName.string_view()));
         auto decl = new IR::Declaration_Variable(keyNameId, element->expression->type, nullptr);
         // Store the compiler generated table keys in Program structure. These will be
@@ -1722,6 +1732,67 @@ const IR::Node *CopyMatchKeysToSingleStruct::postorder(IR::KeyElement *element)
     return element;
 }
 
+/* Lays out the metadata copies of a key that needs copying. The copies are ordered by
+   decreasing width, so the wide fields come first and the byte sized ones (bool, error,
+   sub-byte fields) are packed together at the end of the key region that the SWX pipeline
+   hashes and compares. No padding is added: a field only starts on its natural alignment
+   when all the fields before it have power of two byte widths, e.g. a 32-bit field after a
+   48-bit one starts 6 bytes into the key. The order of the key elements in the table, and
+   so the control plane view of the key, is unchanged. Tables of the same control that copy
+   exactly the same fields reuse the copies made for the first of them: the copies are
+   assigned right before each table is applied, so the values never need to live across
+   two lookups. */
+const IR::Node *CopyMatchKeysToSingleStruct::postorder(IR::Key *keys) {
+    if (!optimizeKeyLayout) return keys;
+    auto table = findOrigCtxt<IR::P4Table>();
+    auto control = findOrigCtxt<IR::P4Control>();
+    CHECK_NULL(table);
+    CHECK_NULL(control);
+
+    struct KeyCopy {
+        size_t index;
+        cstring name;
+        int size;
+    };
+    std::vector<KeyCopy> copies;
+    std::string signature = control->name.name.string();
+    for (size_t i = 0; i < keys->keyElements.size(); i++) {
+        auto expr = keys->keyElements.at(i)->expression;
+        cstring keyName = getTableKeyName(expr);
+        if (keyName.isNullOrEmpty()) continue;
+        cstring copyName = getKeyCopyName(keyName, control, table);
+        if (copyName.isNullOrEmpty()) continue;
+        copies.push_back({i, copyName, getFieldSizeBits(expr->type)});
+        signature += " " + keyName.string() + ":" + std::to_string(copies.back().size);
+    }
+    if (copies.empty()) return keys;
+    std::stable_sort(copies.begin(), copies.end(),
+                     [](const KeyCopy &a, const KeyCopy &b) { return a.size > b.size; });
+
+    auto &ids = sharedKeyCopies[cstring(signature)];
+    bool shared = !ids.empty();
+    for (size_t i = 0; i < copies.size(); i++) {
+        auto element = keys->keyElements.at(copies[i].index);
+        if (!shared) {
+            ids.push_back(IR::ID(nameGen.newName(copies[i].name.string_view())));
+            // Store the compiler generated table keys in Program structure. These will be
+            // inserted to Metadata by CollectLocalVariables pass.
+            structure->key_fields.push_back(
+                new IR::StructField(ids.back(), element->expression->type));
+        }
+        auto left = new IR::Member(new IR::PathExpression(IR::ID("m")), ids.at(i));
+        auto assign =
+            new IR::AssignmentStatement(element->expression->srcInfo, left, element->expression);
+        getInsertions(table)->statements.push_back(assign);
+        auto newElement = element->clone();
+        newElement->expression = left;
+        keys->keyElements[copies[i].index] = newElement;
+    }
+    LOG3("Key of table " << table->name << (shared ? " reuses " : " uses ") << copies.size()
+                         << " metadata copies");
+    return keys;
+}
+
 const IR::Node *CopyMatchKeysToSingleStruct::doStatement(const IR::Statement *statement,
                                                          const IR::Expression *expression,
                                                          const Visitor::Context *ctxt) {
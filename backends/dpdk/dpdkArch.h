@@ -826,19 +826,33 @@ struct keyInfo {
     std::vector<struct keyElementInfo *> elements;
 };
 
+// When optimizeKeyLayout is set, the copies of a key are laid out widest field first so that
+// the byte sized fields end up packed at the tail, and tables of the same control whose keys
+// copy exactly the same fields share one set of metadata copies instead of growing the
+// metadata struct for each of them.
 class CopyMatchKeysToSingleStruct : public P4::KeySideEffect {
     IR::IndexedVector<IR::Declaration> decls;
     DpdkProgramStructure *structure;
     bool metaCopyNeeded = false;
+    bool optimizeKeyLayout;
+    // Metadata copies created for a control and key signature, in layout order.
+    std::map<cstring, std::vector<IR::ID>> sharedKeyCopies;
+
+    P4::TableInsertions *getInsertions(const IR::P4Table *table);
+    cstring getKeyCopyName(cstring keyName, const IR::P4Control *control,
+                           const IR::P4Table *table);
 
  public:
     CopyMatchKeysToSingleStruct(P4::TypeMap *typeMap, std::set<const IR::P4Table *> *invokedInKey,
-                                DpdkProgramStructure *structure)
-        : P4::KeySideEffect(typeMap, invokedInKey), structure(structure) {
+                                DpdkProgramStructure *structure, bool optimizeKeyLayout = false)
+        : P4::KeySideEffect(typeMap, invokedInKey),
+          structure(structure),
+          optimizeKeyLayout(optimizeKeyLayout) {
         setName("CopyMatchKeysToSingleStruct");
     }
 
     const IR::Node *preorder(IR::Key *key) override;
+    const IR::Node *postorder(IR::Key *key) override;
     const IR::Node *postorder(IR::KeyElement *element) override;
     const IR::Node *doStatement(const IR::Statement *statement, const IR::Expression *expression,
                                 const Visitor::Context *ctxt) override;
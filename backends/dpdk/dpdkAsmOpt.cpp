@@ -16,6 +16,9 @@ limitations under the License.
 
 #include "dpdkAsmOpt.h"
 
+#include <optional>
+#include <set>
+
 #include "dpdkUtils.h"
 
 namespace P4::DPDK {
@@ -359,6 +362,521 @@ IR::IndexedVector<IR::DpdkAsmStatement> CopyPropagationAndElimination::copyPropA
     return instrr;
 }
 
+int FuseHeaderFieldAccess::fieldWidth(const IR::Expression *e) const {
+    auto m = e->to<IR::Member>();
+    if (!m) return -1;
+    if (m->expr->toString() == "m") {
+        auto it = metadataWidth.find(m->member.name);
+        return it != metadataWidth.end() ? it->second : -1;
+    }
+    if (auto bits = m->type->to<IR::Type_Bits>()) return bits->width_bits();
+    // h.<instance>.<field>
+    if (auto hdr = m->expr->to<IR::Member>()) {
+        if (hdr->expr->toString() != "h") return -1;
+        auto it = headerInstances.find(hdr->member.name);
+        if (it == headerInstances.end()) return -1;
+        auto field = it->second->getField(m->member.name);
+        if (field != nullptr)
+            if (auto bits = field->type->to<IR::Type_Bits>()) return bits->width_bits();
+    }
+    return -1;
+}
+
+bool FuseHeaderFieldAccess::isTemporary(const IR::Expression *e, unsigned uses) const {
+    auto m = e->to<IR::Member>();
+    if (!m || m->expr->toString() != "m" || pinned.count(m->member.name)) return false;
+    auto it = statementsUsing.find(m->member.name);
+    return it != statementsUsing.end() && it->second == uses;
+}
+
+IR::IndexedVector<IR::DpdkAsmStatement> FuseHeaderFieldAccess::fuse(
+    const IR::IndexedVector<IR::DpdkAsmStatement> &s) {
+    IR::IndexedVector<IR::DpdkAsmStatement> result;
+    for (size_t i = 0; i < s.size(); i++) {
+        auto load = s.at(i)->to<IR::DpdkMovStatement>();
+        if (!load || !load->src->is<IR::Member>()) {
+            result.push_back(s.at(i));
+            continue;
+        }
+        auto tmp = load->dst;
+        auto src = load->src;
+        int tmpWidth = fieldWidth(tmp), srcWidth = fieldWidth(src);
+        if (tmpWidth <= 0 || srcWidth <= 0 || srcWidth > 64 || tmpWidth < srcWidth) {
+            result.push_back(s.at(i));
+            continue;
+        }
+
+        // mov tmp X; <op> tmp Y; mov X tmp  =>  <op> X Y
+        if (i + 2 < s.size() && tmpWidth == srcWidth && isTemporary(tmp, 3)) {
+            auto op = s.at(i + 1)->to<IR::DpdkBinaryStatement>();
+            auto store = s.at(i + 2)->to<IR::DpdkMovStatement>();
+            if (op && store && op->dst->toString() == tmp->toString() &&
+                op->src1->toString() == tmp->toString() &&
+                store->src->toString() == tmp->toString() &&
+                store->dst->toString() == src->toString()) {
+                auto fused = op->clone();
+                fused->dst = src;
+                fused->src1 = src;
+                if (op->src2->toString() == tmp->toString()) fused->src2 = src;
+                LOG3("Fusing " << load << ", " << op << ", " << store << " into " << fused);
+                result.push_back(fused);
+                i += 2;
+                continue;
+            }
+        }
+
+        // mov tmp X; mov Y tmp  =>  mov Y X
+        if (i + 1 < s.size() && isTemporary(tmp, 2)) {
+            auto store = s.at(i + 1)->to<IR::DpdkMovStatement>();
+            int dstWidth = store ? fieldWidth(store->dst) : -1;
+            if (store && store->src->toString() == tmp->toString() && dstWidth > 0 &&
+                dstWidth <= 64) {
+                auto fused = new IR::DpdkMovStatement(store->dst, src);
+                LOG3("Fusing " << load << ", " << store << " into " << fused);
+                result.push_back(fused);
+                i += 1;
+                continue;
+            }
+        }
+        result.push_back(s.at(i));
+    }
+    return result;
+}
+
+const IR::Node *FuseHeaderFieldAccess::preorder(IR::DpdkAsmProgram *p) {
+    statementsUsing.clear();
+    pinned.clear();
+    metadataWidth.clear();
+    headerInstances.clear();
+    before = after = 0;
+
+    auto count = [this](const IR::IndexedVector<IR::DpdkAsmStatement> &stmts) {
+        for (auto stmt : stmts) {
+            ordered_set<cstring> fields;
+            CollectUsedMetadataField collect(fields);
+            stmt->apply(collect);
+            for (auto f : fields) statementsUsing[f]++;
+        }
+        before += stmts.size();
+    };
+    for (auto a : p->actions) count(a->statements);
+    for (auto stmt : p->statements)
+        if (auto list = stmt->to<IR::DpdkListStatement>()) count(list->statements);
+
+    CollectUsedMetadataField collect(pinned);
+    p->tables.apply(collect);
+    p->selectors.apply(collect);
+    p->learners.apply(collect);
+    p->externDeclarations.apply(collect);
+    p->globals.apply(collect);
+
+    for (auto st : p->structType) {
+        if (!isMetadataStruct(st)) continue;
+        for (auto field : st->fields)
+            if (auto bits = field->type->to<IR::Type_Bits>())
+                metadataWidth.emplace(field->name.name, bits->width_bits());
+    }
+    for (auto hi : p->headerInstance) headerInstances.emplace(hi->name->name.name, hi->headerType);
+    return p;
+}
+
+const IR::Node *FuseHeaderFieldAccess::postorder(IR::DpdkAsmProgram *p) {
+    LOG1("Instruction count before fusion: " << before << ", after: " << after);
+    return p;
+}
+
+bool DpdkControlFlowGraph::endsBlock(const IR::DpdkAsmStatement *s) {
+    return s->is<IR::DpdkJmpLabelStatement>() || s->is<IR::DpdkTxStatement>() ||
+           s->is<IR::DpdkReturnStatement>();
+}
+
+DpdkControlFlowGraph::DpdkControlFlowGraph(const IR::IndexedVector<IR::DpdkAsmStatement> &stmts)
+    : stmts(stmts) {
+    std::map<cstring, size_t> labelBlock;
+    bool open = false;
+    for (size_t i = 0; i < stmts.size(); i++) {
+        auto stmt = stmts.at(i);
+        if (!open || stmt->is<IR::DpdkLabelStatement>()) {
+            blocks.push_back(BasicBlock{i, i, {}, {}});
+            open = true;
+        }
+        if (auto label = stmt->to<IR::DpdkLabelStatement>())
+            labelBlock.emplace(label->label, blocks.size() - 1);
+        blocks.back().last = i + 1;
+        if (stmt->is<IR::DpdkJmpStatement>() || endsBlock(stmt)) open = false;
+    }
+
+    auto addEdge = [this](size_t from, size_t to) {
+        blocks[from].succs.push_back(to);
+        blocks[to].preds.push_back(from);
+    };
+    for (size_t b = 0; b < blocks.size(); b++) {
+        auto last = stmts.at(blocks[b].last - 1);
+        if (auto jmp = last->to<IR::DpdkJmpStatement>()) {
+            auto target = labelBlock.find(jmp->label);
+            if (target != labelBlock.end()) addEdge(b, target->second);
+        }
+        if (!endsBlock(last) && b + 1 < blocks.size()) addEdge(b, b + 1);
+    }
+}
+
+std::vector<bool> DpdkControlFlowGraph::reachable() const {
+    std::vector<bool> seen(blocks.size(), false);
+    if (blocks.empty()) return seen;
+    std::vector<size_t> work = {0};
+    seen[0] = true;
+    while (!work.empty()) {
+        auto b = work.back();
+        work.pop_back();
+        for (auto s : blocks[b].succs) {
+            if (!seen[s]) {
+                seen[s] = true;
+                work.push_back(s);
+            }
+        }
+    }
+    return seen;
+}
+
+IR::IndexedVector<IR::DpdkAsmStatement> RemoveUnreachableBlocks::removeUnreachable(
+    const IR::IndexedVector<IR::DpdkAsmStatement> &s) {
+    DpdkControlFlowGraph cfg(s);
+    auto reachable = cfg.reachable();
+    IR::IndexedVector<IR::DpdkAsmStatement> result;
+    for (size_t b = 0; b < cfg.blocks.size(); b++) {
+        if (!reachable[b]) {
+            LOG3("Removing unreachable instructions " << cfg.blocks[b].first << ".."
+                                                      << cfg.blocks[b].last);
+            continue;
+        }
+        for (size_t i = cfg.blocks[b].first; i < cfg.blocks[b].last; i++) result.push_back(s.at(i));
+    }
+    return result;
+}
+
+/// Metadata field name if @p e is a reference to the metadata struct, nullptr otherwise.
+static cstring metadataFieldName(const IR::Expression *e) {
+    if (auto m = e ? e->to<IR::Member>() : nullptr)
+        if (m->expr->toString() == "m") return m->member.name;
+    return nullptr;
+}
+
+/// Locations known to hold a value: destination -> source, both as printed in .spec.
+using AvailableMoves = std::map<cstring, cstring>;
+
+static void killLocation(AvailableMoves &moves, cstring loc) {
+    moves.erase(loc);
+    for (auto it = moves.begin(); it != moves.end();) {
+        if (it->second == loc)
+            it = moves.erase(it);
+        else
+            ++it;
+    }
+}
+
+/// Updates @p moves after @p stmt. Returns true if @p stmt is a mov whose effect is
+/// already known to hold.
+static bool transferMoves(const IR::DpdkAsmStatement *stmt, AvailableMoves &moves) {
+    if (auto mv = stmt->to<IR::DpdkMovStatement>()) {
+        auto dst = mv->dst->toString();
+        bool trackable = metadataFieldName(mv->dst) &&
+                         (mv->src->is<IR::Member>() || mv->src->is<IR::Constant>());
+        auto src = mv->src->toString();
+        if (trackable) {
+            auto known = moves.find(dst);
+            if (known != moves.end() && known->second == src) return true;
+        }
+        killLocation(moves, dst);
+        if (trackable && dst != src) moves.emplace(dst, src);
+    } else if (auto as = stmt->to<IR::DpdkAssignmentStatement>()) {
+        killLocation(moves, as->dst->toString());
+    } else if (auto cs = stmt->to<IR::DpdkCastStatement>()) {
+        killLocation(moves, cs->dst->toString());
+    } else if (stmt->is<IR::DpdkJmpStatement>() || stmt->is<IR::DpdkLabelStatement>() ||
+               stmt->is<IR::DpdkEmitStatement>() || stmt->is<IR::DpdkTxStatement>() ||
+               stmt->is<IR::DpdkCounterCountStatement>() ||
+               stmt->is<IR::DpdkRegisterWriteStatement>()) {
+        // Do not write any location.
+    } else {
+        moves.clear();
+    }
+    return false;
+}
+
+IR::IndexedVector<IR::DpdkAsmStatement> EliminateRedundantMoves::eliminateRedundantMoves(
+    const IR::IndexedVector<IR::DpdkAsmStatement> &s) {
+    DpdkControlFlowGraph cfg(s);
+    std::vector<std::optional<AvailableMoves>> out(cfg.blocks.size());
+
+    auto blockIn = [&](size_t b) -> std::optional<AvailableMoves> {
+        if (b == 0) return AvailableMoves();
+        std::optional<AvailableMoves> in;
+        for (auto p : cfg.blocks[b].preds) {
+            if (!out[p]) continue;
+            if (!in) {
+                in = *out[p];
+                continue;
+            }
+            for (auto it = in->begin(); it != in->end();) {
+                auto other = out[p]->find(it->first);
+                if (other == out[p]->end() || other->second != it->second)
+                    it = in->erase(it);
+                else
+                    ++it;
+            }
+        }
+        return in;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t b = 0; b < cfg.blocks.size(); b++) {
+            auto moves = blockIn(b);
+            if (!moves) continue;
+            for (size_t i = cfg.blocks[b].first; i < cfg.blocks[b].last; i++)
+                transferMoves(s.at(i), *moves);
+            if (out[b] != moves) {
+                out[b] = std::move(moves);
+                changed = true;
+            }
+        }
+    }
+
+    IR::IndexedVector<IR::DpdkAsmStatement> result;
+    for (size_t b = 0; b < cfg.blocks.size(); b++) {
+        auto moves = blockIn(b);
+        for (size_t i = cfg.blocks[b].first; i < cfg.blocks[b].last; i++) {
+            if (moves && transferMoves(s.at(i), *moves)) {
+                LOG3("Removing redundant " << s.at(i));
+                continue;
+            }
+            result.push_back(s.at(i));
+        }
+    }
+    return result;
+}
+
+/// Collects the metadata fields read by @p stmt into @p uses and returns the field it
+/// overwrites, if any. Returns false if the effect of @p stmt on metadata is not known.
+static bool metadataUseDef(const IR::DpdkAsmStatement *stmt, ordered_set<cstring> &uses,
+                           cstring &def) {
+    CollectUsedMetadataField collect(uses);
+    def = nullptr;
+    if (auto mv = stmt->to<IR::DpdkMovStatement>()) {
+        mv->src->apply(collect);
+        def = metadataFieldName(mv->dst);
+    } else if (auto cs = stmt->to<IR::DpdkCastStatement>()) {
+        cs->src->apply(collect);
+        def = metadataFieldName(cs->dst);
+    } else if (auto rd = stmt->to<IR::DpdkRegisterReadStatement>()) {
+        rd->index->apply(collect);
+        def = metadataFieldName(rd->dst);
+    } else if (auto bin = stmt->to<IR::DpdkBinaryStatement>()) {
+        // dst is also the first operand
+        bin->apply(collect);
+        def = metadataFieldName(bin->dst);
+    } else if (stmt->is<IR::DpdkJmpStatement>() || stmt->is<IR::DpdkLabelStatement>() ||
+               stmt->is<IR::DpdkApplyStatement>() || stmt->is<IR::DpdkEmitStatement>() ||
+               stmt->is<IR::DpdkValidateStatement>() || stmt->is<IR::DpdkInvalidateStatement>() ||
+               stmt->is<IR::DpdkCounterCountStatement>() ||
+               stmt->is<IR::DpdkRegisterWriteStatement>()) {
+        stmt->apply(collect);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/// Renames metadata fields according to @p renames.
+class RenameMetadataFields : public Transform {
+    const std::map<cstring, cstring> &renames;
+
+ public:
+    explicit RenameMetadataFields(const std::map<cstring, cstring> &renames) : renames(renames) {}
+    const IR::Node *preorder(IR::Member *m) override {
+        if (m->expr->toString() != "m") return m;
+        auto it = renames.find(m->member.name);
+        if (it != renames.end()) m->member = IR::ID(it->second);
+        return m;
+    }
+};
+
+bool CoalesceMetadataFields::analyze(const IR::IndexedVector<IR::DpdkAsmStatement> &s,
+                                     IR::IndexedVector<IR::DpdkAsmStatement> &out) {
+    std::vector<ordered_set<cstring>> uses(s.size());
+    std::vector<cstring> defs(s.size());
+    ordered_set<cstring> candidates;
+    ordered_set<cstring> localPinned;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (!metadataUseDef(s.at(i), uses[i], defs[i])) {
+            CollectUsedMetadataField collect(localPinned);
+            s.at(i)->apply(collect);
+            continue;
+        }
+        for (auto f : uses[i]) candidates.insert(f);
+        if (defs[i]) candidates.insert(defs[i]);
+    }
+    auto isCandidate = [&](cstring f) {
+        return f && candidates.count(f) && !localPinned.count(f) && !pinned.count(f) &&
+               fieldType.count(f);
+    };
+
+    // Backward liveness of candidate fields. Nothing is live at the end of the apply block.
+    DpdkControlFlowGraph cfg(s);
+    std::vector<std::set<cstring>> liveIn(cfg.blocks.size());
+    std::vector<std::set<cstring>> liveOut(s.size());
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t b = cfg.blocks.size(); b-- > 0;) {
+            std::set<cstring> live;
+            for (auto succ : cfg.blocks[b].succs)
+                live.insert(liveIn[succ].begin(), liveIn[succ].end());
+            for (size_t i = cfg.blocks[b].last; i-- > cfg.blocks[b].first;) {
+                liveOut[i] = live;
+                if (isCandidate(defs[i])) live.erase(defs[i]);
+                for (auto u : uses[i])
+                    if (isCandidate(u)) live.insert(u);
+            }
+            if (live != liveIn[b]) {
+                liveIn[b] = std::move(live);
+                changed = true;
+            }
+        }
+    }
+
+    // Anything read before being written holds a value set outside the apply block.
+    if (!cfg.blocks.empty())
+        for (auto f : liveIn[0]) localPinned.insert(f);
+
+    // Remove stores to fields that are never read afterwards.
+    bool removed = false;
+    std::vector<bool> keep(s.size(), true);
+    for (size_t i = 0; i < s.size(); i++) {
+        auto stmt = s.at(i);
+        if (!isCandidate(defs[i]) || liveOut[i].count(defs[i])) continue;
+        if (stmt->is<IR::DpdkMovStatement>() || stmt->is<IR::DpdkCastStatement>() ||
+            stmt->is<IR::DpdkBinaryStatement>()) {
+            LOG3("Removing dead store " << stmt);
+            keep[i] = false;
+            removed = true;
+        }
+    }
+    if (removed) {
+        // Liveness changes once the stores are gone, start over.
+        for (size_t i = 0; i < s.size(); i++)
+            if (keep[i]) out.push_back(s.at(i));
+        return true;
+    }
+
+    // Two fields interfere if one is written while the other is live. The source of a
+    // copy does not interfere with its destination.
+    std::map<cstring, std::set<cstring>> interference;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (!isCandidate(defs[i])) continue;
+        cstring copySrc;
+        if (auto mv = s.at(i)->to<IR::DpdkMovStatement>()) copySrc = metadataFieldName(mv->src);
+        for (auto v : liveOut[i]) {
+            if (v == defs[i] || v == copySrc) continue;
+            interference[defs[i]].insert(v);
+            interference[v].insert(defs[i]);
+        }
+    }
+
+    std::map<cstring, cstring> renames;
+    std::vector<std::vector<cstring>> classes;
+    for (auto f : candidates) {
+        if (!isCandidate(f)) continue;
+        bool placed = false;
+        for (auto &cls : classes) {
+            if (fieldType.at(cls.front()) != fieldType.at(f)) continue;
+            bool conflict = false;
+            for (auto member : cls) {
+                if (interference[f].count(member)) {
+                    conflict = true;
+                    break;
+                }
+            }
+            if (conflict) continue;
+            cls.push_back(f);
+            renames.emplace(f, cls.front());
+            LOG3("Coalescing metadata field " << f << " into " << cls.front());
+            placed = true;
+            break;
+        }
+        if (!placed) classes.push_back({f});
+    }
+    if (renames.empty()) {
+        out = s;
+        return false;
+    }
+
+    RenameMetadataFields rename(renames);
+    for (auto stmt : s) {
+        auto renamed = stmt->apply(rename)->to<IR::DpdkAsmStatement>();
+        if (auto mv = renamed->to<IR::DpdkMovStatement>())
+            if (mv->dst->toString() == mv->src->toString()) continue;
+        if (auto cs = renamed->to<IR::DpdkCastStatement>())
+            if (cs->dst->toString() == cs->src->toString()) continue;
+        out.push_back(renamed);
+    }
+    return true;
+}
+
+const IR::Node *CoalesceMetadataFields::preorder(IR::DpdkAsmProgram *p) {
+    bool unsafe = false;
+    forAllMatching<IR::DpdkRecirculateStatement>(
+        p, [&](const IR::DpdkRecirculateStatement *) { unsafe = true; });
+    forAllMatching<IR::DpdkLearnStatement>(p,
+                                           [&](const IR::DpdkLearnStatement *) { unsafe = true; });
+    if (unsafe || !p->learners.empty()) {
+        prune();
+        return p;
+    }
+
+    pinned.clear();
+    fieldType.clear();
+    CollectUsedMetadataField collect(pinned);
+    p->actions.apply(collect);
+    p->tables.apply(collect);
+    p->selectors.apply(collect);
+    p->learners.apply(collect);
+    p->externDeclarations.apply(collect);
+    p->globals.apply(collect);
+    forAllMatching<IR::DpdkGetHashStatement>(p, [&](const IR::DpdkGetHashStatement *h) {
+        // hash instructions read a range of contiguous fields
+        h->apply(collect);
+    });
+    for (auto st : p->structType) {
+        if (!isMetadataStruct(st)) continue;
+        for (auto field : st->fields) {
+            if (field->name.name.startsWith("pna_") || field->name.name.startsWith("psa_"))
+                pinned.insert(field->name.name);
+            fieldType.emplace(field->name.name, field->type->toString());
+        }
+    }
+
+    IR::IndexedVector<IR::DpdkAsmStatement> statements;
+    for (auto stmt : p->statements) {
+        auto list = stmt->to<IR::DpdkListStatement>();
+        if (!list) {
+            statements.push_back(stmt);
+            continue;
+        }
+        auto current = list->statements;
+        IR::IndexedVector<IR::DpdkAsmStatement> next;
+        while (analyze(current, next)) {
+            current = next;
+            next.clear();
+        }
+        statements.push_back(new IR::DpdkListStatement(current));
+    }
+    p->statements = statements;
+    prune();
+    return p;
+}
+
 cstring EmitDpdkTableConfig::getKeyMatchType(const IR::KeyElement *ke, P4::ReferenceMap *refMap) {
     auto path = ke->matchType->path;
     auto mt = refMap->getDeclaration(path, true)->to<IR::Declaration_ID>();
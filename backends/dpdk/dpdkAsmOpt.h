@@ -602,6 +602,147 @@ class CopyPropagationAndElimination : public Transform {
     }
 };
 
+/// This pass fuses the instruction sequences the code generator emits around metadata
+/// temporaries when the temporary is not used anywhere else. A read-modify-write of a
+/// field
+/// mov m.tmp h.ipv4.ttl
+/// add m.tmp 0xFF
+/// mov h.ipv4.ttl m.tmp
+///
+/// becomes "add h.ipv4.ttl 0xFF", and a copy through a temporary
+/// mov m.tmp h.outer.src
+/// mov h.inner.src m.tmp
+///
+/// becomes "mov h.inner.src h.outer.src". Only fields of at most 64 bits are fused, and
+/// only when the temporary is wide enough not to change the value.
+///
+/// The programs in backends/dpdk/examples gain nothing from it: ipsec.p4 stays at 135
+/// instructions, and vxlan.p4 assigns whole fields only (the additions are emitted in place),
+/// so the code generator introduces no temporaries there. The pass pays off on slice
+/// assignments, e.g. psa-example-dpdk-byte-alignment_2.p4 goes from 97 to 87 instructions.
+class FuseHeaderFieldAccess : public Transform {
+    /// Number of instructions referencing each metadata field.
+    std::map<cstring, unsigned> statementsUsing;
+    ordered_set<cstring> pinned;
+    std::map<cstring, int> metadataWidth;
+    std::map<cstring, const IR::Type_Header *> headerInstances;
+    unsigned before = 0, after = 0;
+
+    int fieldWidth(const IR::Expression *e) const;
+    bool isTemporary(const IR::Expression *e, unsigned uses) const;
+    IR::IndexedVector<IR::DpdkAsmStatement> fuse(const IR::IndexedVector<IR::DpdkAsmStatement> &s);
+
+ public:
+    FuseHeaderFieldAccess() { setName("FuseHeaderFieldAccess"); }
+
+    const IR::Node *preorder(IR::DpdkAsmProgram *p) override;
+    const IR::Node *postorder(IR::DpdkAsmProgram *p) override;
+
+    const IR::Node *postorder(IR::DpdkListStatement *l) override {
+        l->statements = fuse(l->statements);
+        after += l->statements.size();
+        return l;
+    }
+
+    const IR::Node *postorder(IR::DpdkAction *a) override {
+        a->statements = fuse(a->statements);
+        after += a->statements.size();
+        return a;
+    }
+};
+
+/// Control flow graph over a flat list of DPDK instructions. A basic block starts at a
+/// label or after a jump and ends before the next label, after a jump, or after an
+/// instruction that ends packet processing (tx, return). Jumps to labels that are not
+/// part of the list (e.g. LABEL_DROP in actions) leave the graph.
+class DpdkControlFlowGraph {
+ public:
+    struct BasicBlock {
+        /// Instructions [first, last) of the list.
+        size_t first = 0, last = 0;
+        std::vector<size_t> succs;
+        std::vector<size_t> preds;
+    };
+
+    const IR::IndexedVector<IR::DpdkAsmStatement> &stmts;
+    std::vector<BasicBlock> blocks;
+
+    explicit DpdkControlFlowGraph(const IR::IndexedVector<IR::DpdkAsmStatement> &stmts);
+
+    /// Blocks reachable from the entry block.
+    std::vector<bool> reachable() const;
+    /// True if control never falls through @p s to the next instruction.
+    static bool endsBlock(const IR::DpdkAsmStatement *s);
+};
+
+/// This pass removes basic blocks which can not be reached from the start of the
+/// apply block or action. Such code is left behind when both branches of an if end
+/// with a jump, or after tx.
+class RemoveUnreachableBlocks : public Transform {
+ public:
+    IR::IndexedVector<IR::DpdkAsmStatement> removeUnreachable(
+        const IR::IndexedVector<IR::DpdkAsmStatement> &s);
+
+    const IR::Node *postorder(IR::DpdkListStatement *l) override {
+        l->statements = removeUnreachable(l->statements);
+        return l;
+    }
+
+    const IR::Node *postorder(IR::DpdkAction *a) override {
+        a->statements = removeUnreachable(a->statements);
+        return a;
+    }
+};
+
+/// This pass removes a mov into a metadata field when, on every path reaching it,
+/// the field already holds the same header field, metadata field or constant. This
+/// is the common case of a header field loaded into the same temporary in several
+/// branches or by several inlined control blocks.
+/// For example,
+/// mov m.tmp h.ipv4.ttl
+/// jmpeq LABEL_1 m.x 0x1
+/// ...
+/// LABEL_1 :
+/// mov m.tmp h.ipv4.ttl
+///
+/// the second mov will be removed.
+/// Tables, externs and any other instruction not modelled here invalidate everything
+/// known so far.
+class EliminateRedundantMoves : public Transform {
+ public:
+    IR::IndexedVector<IR::DpdkAsmStatement> eliminateRedundantMoves(
+        const IR::IndexedVector<IR::DpdkAsmStatement> &s);
+
+    const IR::Node *postorder(IR::DpdkListStatement *l) override {
+        l->statements = eliminateRedundantMoves(l->statements);
+        return l;
+    }
+
+    const IR::Node *postorder(IR::DpdkAction *a) override {
+        a->statements = eliminateRedundantMoves(a->statements);
+        return a;
+    }
+};
+
+/// This pass runs liveness analysis over the metadata fields of the apply block.
+/// Stores to fields that are never read afterwards are removed, and fields whose live
+/// ranges do not overlap are merged into one, so that RemoveUnusedMetadataFields can
+/// drop the rest from the per-packet metadata struct.
+/// Only fields referenced exclusively by instructions of the apply block whose reads
+/// and writes are modelled here are candidates: anything used by actions, tables,
+/// learners, selectors, hash ranges or standard metadata is left alone. Programs that
+/// recirculate or learn keep metadata alive beyond the apply block and are skipped.
+class CoalesceMetadataFields : public Transform {
+    ordered_set<cstring> pinned;
+    ordered_map<cstring, cstring> fieldType;
+
+    bool analyze(const IR::IndexedVector<IR::DpdkAsmStatement> &s,
+                 IR::IndexedVector<IR::DpdkAsmStatement> &out);
+
+ public:
+    const IR::Node *preorder(IR::DpdkAsmProgram *p) override;
+};
+
 /// This Pass emits Table config consumed by dpdk target in a text file if
 /// const entries are present in p4 program.
 /// Most of the code taken from control-plane/p4RuntimeSerializer.h/.cpp
@@ -653,5 +794,19 @@ class DpdkAsmOptimization : public PassRepeated {
     }
 };
 
+/// Instruction level optimizations working on the control flow graph of the apply
+/// block and of each action. Enabled with --enableCfgOpt.
+class DpdkCfgOptimization : public PassManager {
+ public:
+    DpdkCfgOptimization() {
+        passes.push_back(new RemoveUnreachableBlocks);
+        passes.push_back(new EliminateRedundantMoves);
+        passes.push_back(new CoalesceMetadataFields);
+        passes.push_back(new RemoveUnreachableBlocks);
+        passes.push_back(new DpdkAsmOptimization);
+        setName("DpdkCfgOptimization");
+    }
+};
+
 }  // namespace P4::DPDK
 #endif /* BACKENDS_DPDK_DPDKASMOPT_H_ */
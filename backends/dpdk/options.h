@@ -36,6 +36,12 @@ class DpdkOptions : public CompilerOptions {
     bool loadIRFromJson = false;
     /// Enable/disable Egress pipeline in PSA.
     bool enableEgress = false;
+    /// Enable control flow graph based optimizations of the emitted instructions.
+    bool enableCfgOpt = false;
+    /// Fuse instruction sequences that go through metadata temporaries.
+    bool enableInstrFusion = false;
+    /// Reorder, pack and share the metadata copies of table keys.
+    bool enableKeyLayoutOpt = false;
 
     DpdkOptions() {
         registerOption(
@@ -54,6 +60,30 @@ class DpdkOptions : public CompilerOptions {
                 return true;
             },
             "[Dpdk back-end] Enable egress pipeline's codegen\n", OptionFlags::Hide);
+        registerOption(
+            "--enableCfgOpt", nullptr,
+            [this](const char *) {
+                enableCfgOpt = true;
+                return true;
+            },
+            "[Dpdk back-end] Remove unreachable code, redundant moves and dead metadata\n"
+            "stores, and merge metadata fields with disjoint live ranges\n");
+        registerOption(
+            "--enableInstrFusion", nullptr,
+            [this](const char *) {
+                enableInstrFusion = true;
+                return true;
+            },
+            "[Dpdk back-end] Fuse read-modify-write and copy sequences through metadata\n"
+            "temporaries into single instructions on the header fields\n");
+        registerOption(
+            "--enableKeyLayoutOpt", nullptr,
+            [this](const char *) {
+                enableKeyLayoutOpt = true;
+                return true;
+            },
+            "[Dpdk back-end] Lay out the metadata copies of table keys widest field first\n"
+            "and share them between tables that copy the same fields\n");
 
         registerOption(
             "--bf-rt-schema", "file",
@@ -47,6 +47,7 @@ class Options(object):
         self.runDebugger_skip = 0
         self.generateP4Runtime = False
         self.generateBfRt = False
+        self.outputsDir = None  # expected outputs, instead of the default for the input
 
 
 def usage(options):
@@ -62,6 +63,7 @@ def usage(options):
     print('          -a "args": pass args to the compiler')
     print("          --p4runtime: generate P4Info message in text format")
     print("          --bfrt: generate BfRt message in text format")
+    print("          --outputs dir: compare against the expected outputs in dir")
 
 
 def isError(p4filename):
@@ -264,7 +266,9 @@ def process_file(options, argv):
     basename = os.path.basename(options.p4filename)
     base, ext = os.path.splitext(basename)
     dirname = os.path.dirname(options.p4filename)
-    if "_samples/" in dirname:
+    if options.outputsDir:
+        expected_dirname = options.outputsDir
+    elif "_samples/" in dirname:
         expected_dirname = dirname.replace("_samples/", "_samples_outputs/", 1)
     elif "_errors/" in dirname:
         expected_dirname = dirname.replace("_errors/", "_errors_outputs/", 1)
@@ -403,6 +407,13 @@ def main(argv):
             options.generateP4Runtime = True
         elif argv[0] == "--bfrt":
             options.generateBfRt = True
+        elif argv[0] == "--outputs":
+            if len(argv) == 1:
+                print("Missing argument for --outputs option")
+                usage(options)
+                sys.exit(FAILURE)
+            options.outputsDir = argv[1]
+            argv = argv[1:]
         else:
             print("Unknown option ", argv[0], file=sys.stderr)
             usage(options)
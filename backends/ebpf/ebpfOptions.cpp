@@ -100,6 +100,13 @@ EbpfOptions::EbpfOptions() {
             return true;
         },
         "[psa only] Compile and generate the P4 prog for XDP hook");
+    registerOption(
+        "--emit-burst", nullptr,
+        [this](const char *) {
+            emitBurst = true;
+            return true;
+        },
+        "[ubpf only] Also generate an entry point that processes a burst of packets");
 }
 
 }  // namespace P4
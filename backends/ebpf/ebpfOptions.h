@@ -41,6 +41,8 @@ class EbpfOptions : public CompilerOptions {
     unsigned int maxTernaryMasks = 128;
     /// Enable table cache for LPM and ternary tables
     bool enableTableCache = false;
+    /// Generate an entry point processing a burst of packets
+    bool emitBurst = false;
 
     EbpfOptions();
 
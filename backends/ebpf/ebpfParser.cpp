@@ -377,9 +377,15 @@ void StateTranslationVisitor::compileExtractField(const IR::Expression *expr,
         }
     }
 
+    traceExtractedField(expr, fieldName, widthToExtract);
+}
+
+void StateTranslationVisitor::traceExtractedField(const IR::Expression *expr, cstring fieldName,
+                                                  unsigned width) {
+    cstring msgStr;
     // eBPF can pass 64 bits of data as one argument passed in 64 bit register,
     // so value of the field is printed only when it fits into that register
-    if (widthToExtract <= 64) {
+    if (width <= 64) {
         cstring exprStr = expr->is<IR::PathExpression>()
                               ? expr->to<IR::PathExpression>()->path->name.name
                               : expr->toString();
@@ -391,15 +397,84 @@ void StateTranslationVisitor::compileExtractField(const IR::Expression *expr,
         }
         auto tmp = absl::StrFormat("(unsigned long long) %v.%v", exprStr, fieldName);
 
-        msgStr =
-            absl::StrFormat("Parser: extracted %v=0x%%llx (%u bits)", fieldName, widthToExtract);
+        msgStr = absl::StrFormat("Parser: extracted %v=0x%%llx (%u bits)", fieldName, width);
         builder->target->emitTraceMessage(builder, msgStr.c_str(), 1, tmp.c_str());
     } else {
-        msgStr = absl::StrFormat("Parser: extracted %v (%u bits)", fieldName, widthToExtract);
+        msgStr = absl::StrFormat("Parser: extracted %v (%u bits)", fieldName, width);
         builder->target->emitTraceMessage(builder, msgStr.c_str());
     }
 }
 
+bool StateTranslationVisitor::canUseWideLoads(const IR::Type_StructLike *type) const {
+    if (type->width_bits() > maxWideLoadBits) return false;
+    for (auto f : type->fields) {
+        auto etype = EBPFTypeFactory::instance->create(state->parser->typeMap->getType(f));
+        auto et = etype->to<IHasWidth>();
+        // wide fields are stored as byte arrays; leave them to compileExtractField
+        if (et == nullptr || et->widthInBits() > 64) return false;
+    }
+    return true;
+}
+
+/// Copy the whole header into a block of 64-bit words converted to host byte order, then
+/// extract every field from those words with constant shifts and masks.  The copy has a
+/// constant size, so the compiler turns it into a few wide loads that never read past the
+/// end of the header.
+void StateTranslationVisitor::compileWideExtract(const IR::Expression *destination,
+                                                 const IR::Type_StructLike *type) {
+    auto program = state->parser->program;
+    cstring words = EBPFModel::reserved("hdrWords"_cs);
+    unsigned width = type->width_bits();
+    unsigned wordCount = ROUNDUP(width, 64);
+
+    builder->emitIndent();
+    builder->blockStart();
+    // zero-initialized, since the verifier rejects reads of uninitialized stack
+    builder->emitIndent();
+    builder->appendFormat("u64 %v[%u] = {0}", words, wordCount);
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("__builtin_memcpy(%v, %v, BYTES(%u))", words, program->headerStartVar,
+                          width);
+    builder->endOfStatement(true);
+    for (unsigned i = 0; i < wordCount; i++) {
+        builder->emitIndent();
+        builder->appendFormat("%v[%u] = load_dword(%v, %u)", words, i, words, i * 8);
+        builder->endOfStatement(true);
+    }
+
+    unsigned hdrOffsetBits = 0;
+    for (auto f : type->fields) {
+        auto etype = EBPFTypeFactory::instance->create(state->parser->typeMap->getType(f));
+        unsigned fieldWidth = etype->to<IHasWidth>()->widthInBits();
+        unsigned index = hdrOffsetBits / 64;
+        unsigned start = hdrOffsetBits % 64;
+
+        builder->emitIndent();
+        visit(destination);
+        builder->appendFormat(".%v = (", f->name.name);
+        etype->emit(builder);
+        builder->append(")(");
+        if (start + fieldWidth <= 64) {
+            builder->appendFormat("(%v[%u]", words, index);
+            if (start + fieldWidth != 64) builder->appendFormat(" >> %u", 64 - start - fieldWidth);
+            builder->append(")");
+        } else {
+            // the field straddles two words
+            builder->appendFormat("((%v[%u] << %u) | (%v[%u] >> %u))", words, index,
+                                  start + fieldWidth - 64, words, index + 1,
+                                  128 - start - fieldWidth);
+        }
+        if (fieldWidth != 64) builder->appendFormat(" & EBPF_MASK(u64, %u)", fieldWidth);
+        builder->append(")");
+        builder->endOfStatement(true);
+
+        traceExtractedField(destination, f->name.name, fieldWidth);
+        hdrOffsetBits += fieldWidth;
+    }
+    builder->blockEnd(true);
+}
+
 void StateTranslationVisitor::compileExtract(const IR::Expression *destination) {
     cstring msgStr;
     auto type = state->parser->typeMap->getType(destination);
@@ -431,9 +506,11 @@ void StateTranslationVisitor::compileExtract(const IR::Expression *destination)
     // we must ensure that the larger word is not outside of packet buffer.
     // FIXME: this can fail if a packet does not contain additional payload after header.
     //  However, we don't have better solution in case of using load_X functions to parse packet.
-    // TODO: consider using a collection of smaller widths.
+    //  Headers extracted with wide loads never read past their end and need no padding.
+    bool wideLoads = canUseWideLoads(ht);
     unsigned curr_padding = 0;
     for (auto f : ht->fields) {
+        if (wideLoads) break;
         auto ftype = state->parser->typeMap->getType(f);
         auto etype = EBPFTypeFactory::instance->create(ftype);
         if (etype->is<EBPFScalarType>()) {
@@ -468,18 +545,22 @@ void StateTranslationVisitor::compileExtract(const IR::Expression *destination)
     builder->target->emitTraceMessage(builder, msgStr.c_str());
     builder->newline();
 
-    unsigned hdrOffsetBits = 0;
-    for (auto f : ht->fields) {
-        auto ftype = state->parser->typeMap->getType(f);
-        auto etype = EBPFTypeFactory::instance->create(ftype);
-        auto et = etype->to<IHasWidth>();
-        if (et == nullptr) {
-            ::P4::error(ErrorType::ERR_UNSUPPORTED_ON_TARGET,
-                        "Only headers with fixed widths supported %1%", f);
-            return;
+    if (wideLoads) {
+        compileWideExtract(destination, ht);
+    } else {
+        unsigned hdrOffsetBits = 0;
+        for (auto f : ht->fields) {
+            auto ftype = state->parser->typeMap->getType(f);
+            auto etype = EBPFTypeFactory::instance->create(ftype);
+            auto et = etype->to<IHasWidth>();
+            if (et == nullptr) {
+                ::P4::error(ErrorType::ERR_UNSUPPORTED_ON_TARGET,
+                            "Only headers with fixed widths supported %1%", f);
+                return;
+            }
+            compileExtractField(destination, f, hdrOffsetBits, etype);
+            hdrOffsetBits += et->widthInBits();
         }
-        compileExtractField(destination, f, hdrOffsetBits, etype);
-        hdrOffsetBits += et->widthInBits();
     }
     builder->newline();
 
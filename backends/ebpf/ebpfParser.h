@@ -40,6 +40,13 @@ class StateTranslationVisitor : public CodeGenInspector {
     virtual void compileExtractField(const IR::Expression *expr, const IR::StructField *field,
                                      unsigned hdrOffsetBits, EBPFType *type);
     virtual void compileExtract(const IR::Expression *destination);
+    /// Headers up to this many bits may be extracted with wide loads.
+    static constexpr unsigned maxWideLoadBits = 512;
+    /// True if @p type can be copied out of the packet in one go and its fields extracted
+    /// with constant shifts, instead of one load_X() helper call per field.
+    virtual bool canUseWideLoads(const IR::Type_StructLike *type) const;
+    void compileWideExtract(const IR::Expression *destination, const IR::Type_StructLike *type);
+    void traceExtractedField(const IR::Expression *expr, cstring fieldName, unsigned width);
     virtual void compileLookahead(const IR::Expression *destination);
     void compileAdvance(const P4::ExternMethod *ext);
     void compileVerify(const IR::MethodCallExpression *expression);
@@ -664,6 +664,16 @@ void EBPFTablePSA::emitLookupDefault(CodeBuilder *builder, cstring key, cstring
     }
 }
 
+void EBPFTablePSA::emitLookup(CodeBuilder *builder, cstring key, cstring value) {
+    if (!hasConstTernaryEntries()) {
+        EBPFTable::emitLookup(builder, key, value);
+        return;
+    }
+
+    if (cacheEnabled()) emitCacheLookup(builder, key, value);
+    emitConstTernaryLookup(builder, key, value);
+}
+
 bool EBPFTablePSA::dropOnNoMatchingEntryFound() const {
     if (implementation != nullptr) return false;
     return EBPFTable::dropOnNoMatchingEntryFound();
@@ -864,6 +874,12 @@ EBPFTablePSA::EntriesGroupedByMask_t EBPFTablePSA::getConstEntriesGroupedByMask(
     for (auto &vec : entriesGroupedByMask) {
         result.emplace_back(std::move(vec.second));
     }
+    // Order tuples by the highest priority they contain; entries in each group are already in
+    // program order, so that is the first one. The tuple ids, and so the generated code, are
+    // then deterministic and lookup can stop early once no later tuple can beat a match.
+    std::sort(result.begin(), result.end(), [](const EntriesGroup_t &a, const EntriesGroup_t &b) {
+        return a.front().priority > b.front().priority;
+    });
     return result;
 }
 
@@ -872,6 +888,117 @@ bool EBPFTablePSA::hasConstEntries() {
     return entries && entries->size() > 0;
 }
 
+bool EBPFTablePSA::hasConstTernaryEntries() const {
+    if (!isTernaryTable() || implementation != nullptr) return false;
+    auto property =
+        table->container->properties->getProperty(IR::TableProperties::entriesPropertyName);
+    if (property == nullptr || !property->isConstant) return false;
+    auto entries = property->value->to<IR::EntriesList>();
+    if (entries == nullptr || entries->size() == 0) return false;
+    for (auto entry : entries->entries) {
+        for (auto k : entry->keys->components) {
+            if (k->is<IR::Constant>()) continue;
+            auto mask = k->to<IR::Mask>();
+            if (mask == nullptr || !mask->right->is<IR::Constant>()) return false;
+        }
+    }
+    return true;
+}
+
+/// Const entries cannot change at runtime, so the masks and the order of the tuples are known
+/// at compile time. Each tuple is probed with its mask applied field by field, in order of the
+/// highest priority it holds, and skipped once the best match found so far outranks it.
+void EBPFTablePSA::emitConstTernaryLookup(CodeBuilder *builder, cstring key, cstring value) {
+    auto entriesGroupedByMask = getConstEntriesGroupedByMask();
+    cstring maskedKey = "k"_cs;
+
+    builder->appendLine("/* const entries: probe tuples in order of decreasing priority */");
+    for (size_t i = 0; i < entriesGroupedByMask.size(); i++) {
+        auto &sameMaskEntries = entriesGroupedByMask[i];
+        builder->emitIndent();
+        builder->appendFormat("if (%v == NULL || %v->priority < %u) ", value, value,
+                              sameMaskEntries.front().priority);
+        builder->blockStart();
+
+        builder->emitIndent();
+        builder->appendFormat("struct %v %v = {}", keyTypeName, maskedKey);
+        builder->endOfStatement(true);
+        auto firstEntry = sameMaskEntries.front().entry;
+        for (size_t j = 0; j < keyGenerator->keyElements.size(); j++) {
+            emitMaskedKeyField(builder, keyGenerator->keyElements[j],
+                               firstEntry->keys->components[j], key, maskedKey);
+        }
+
+        builder->emitIndent();
+        builder->appendFormat("__u32 tuple_id = %u", i);
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->append("struct bpf_elf_map *");
+        builder->target->emitTableLookup(builder, tuplesMapName, "tuple_id"_cs, "tuple"_cs);
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->append("if (tuple) ");
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendFormat("struct %v *tuple_entry = bpf_map_lookup_elem(tuple, &%v)",
+                              valueTypeName, maskedKey);
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat(
+            "if (tuple_entry && (%v == NULL || tuple_entry->priority > %v->priority)) ", value,
+            value);
+        builder->blockStart();
+        builder->target->emitTraceMessage(builder, "Control: Ternary match found, priority=%d.", 1,
+                                          "tuple_entry->priority");
+        builder->emitIndent();
+        builder->appendFormat("%v = tuple_entry", value);
+        builder->endOfStatement(true);
+        builder->blockEnd(true);
+        builder->blockEnd(true);
+
+        builder->blockEnd(true);
+    }
+}
+
+void EBPFTablePSA::emitMaskedKeyField(CodeBuilder *builder, const IR::KeyElement *keyElement,
+                                      const IR::Expression *entryKey, cstring key,
+                                      cstring maskedKey) {
+    cstring fieldName = ::P4::get(keyFieldNames, keyElement);
+    unsigned width = EBPFInitializerUtils::ebpfTypeWidth(program->typeMap, keyElement->expression);
+    auto mask = entryKey->to<IR::Mask>();
+    if (mask != nullptr && mask->right->to<IR::Constant>()->value == 0) return;  // don't care
+
+    if (mask == nullptr) {
+        // exact match
+        builder->emitIndent();
+        if (EBPFScalarType::generatesScalar(width)) {
+            builder->appendFormat("%v.%v = %v.%v", maskedKey, fieldName, key, fieldName);
+        } else {
+            builder->appendFormat("__builtin_memcpy(%v.%v, %v.%v, sizeof(%v.%v))", maskedKey,
+                                  fieldName, key, fieldName, key, fieldName);
+        }
+        builder->endOfStatement(true);
+    } else if (EBPFScalarType::generatesScalar(width)) {
+        EBPFTablePSATernaryKeyMaskGenerator cg(program->refMap, program->typeMap);
+        cg.setBuilder(builder);
+        builder->emitIndent();
+        builder->appendFormat("%v.%v = %v.%v & ", maskedKey, fieldName, key, fieldName);
+        entryKey->apply(cg);
+        builder->endOfStatement(true);
+    } else {
+        auto &maskValue = mask->right->to<IR::Constant>()->value;
+        cstring hex = EBPFInitializerUtils::genHexStr(maskValue, width, mask->right);
+        for (size_t i = 0; i < hex.size() / 2; ++i) {
+            auto byteMask = hex.substr(2 * i, 2);
+            if (byteMask == "00") continue;
+            builder->emitIndent();
+            builder->appendFormat("%v.%v[%u] = %v.%v[%u] & 0x%v", maskedKey, fieldName, i, key,
+                                  fieldName, i, byteMask);
+            builder->endOfStatement(true);
+        }
+    }
+}
+
 cstring EBPFTablePSA::addPrefixFunc(bool trace) {
     cstring addPrefixFunc =
         "static __always_inline\n"
@@ -36,6 +36,12 @@ class EBPFTablePSA : public EBPFTable {
     typedef std::vector<EntriesGroup_t> EntriesGroupedByMask_t;
     EntriesGroupedByMask_t getConstEntriesGroupedByMask();
     bool hasConstEntries();
+    /// True for a ternary table whose entries are all known at compile time, so lookup can
+    /// probe its tuples directly with constant masks instead of walking the prefixes map.
+    bool hasConstTernaryEntries() const;
+    void emitConstTernaryLookup(CodeBuilder *builder, cstring key, cstring value);
+    void emitMaskedKeyField(CodeBuilder *builder, const IR::KeyElement *keyElement,
+                            const IR::Expression *entryKey, cstring key, cstring maskedKey);
     const cstring addPrefixFunctionName = "add_prefix_and_entries"_cs;
     const cstring tuplesMapName = instanceName + "_tuples_map"_cs;
     const cstring prefixesMapName = instanceName + "_prefixes"_cs;
@@ -84,6 +90,7 @@ class EBPFTablePSA : public EBPFTable {
     void emitAction(CodeBuilder *builder, cstring valueName, cstring actionRunVariable) override;
     void emitInitializer(CodeBuilder *builder) override;
     void emitDirectValueTypes(CodeBuilder *builder) override;
+    void emitLookup(CodeBuilder *builder, cstring key, cstring value) override;
     void emitLookupDefault(CodeBuilder *builder, cstring key, cstring value,
                            cstring actionRunVariable) override;
     bool dropOnNoMatchingEntryFound() const override;
@@ -22,6 +22,8 @@ limitations under the License.
 
 namespace P4::EBPF {
 
+const cstring EBPFCounterPSA::perCPUAnnotation = "per_cpu"_cs;
+
 EBPFCounterPSA::EBPFCounterPSA(const EBPFProgram *program, const IR::Declaration_Instance *di,
                                cstring name, CodeGenInspector *codeGen)
     : EBPFCounterTable(program, name, codeGen, 1, false) {
@@ -83,6 +85,17 @@ EBPFCounterPSA::EBPFCounterPSA(const EBPFProgram *program, const IR::Declaration
     // TODO: add more advance logic to decide whether used map will be HASH_MAP or ARRAY_MAP
     isHash = false;
 
+    if (di->hasAnnotation(perCPUAnnotation)) {
+        if (isDirect) {
+            ::P4::warning(ErrorType::WARN_UNSUPPORTED,
+                          "%1%: DirectCounter is stored in table entries and cannot be per-CPU, "
+                          "ignoring annotation",
+                          di);
+        } else {
+            isPerCPU = true;
+        }
+    }
+
     // check index type
     indexWidthType = nullptr;
     if (!isDirect) {
@@ -167,7 +180,7 @@ void EBPFCounterPSA::emitValueType(CodeBuilder *builder) {
 }
 
 void EBPFCounterPSA::emitInstance(CodeBuilder *builder) {
-    TableKind kind = isHash ? TableHash : TableArray;
+    TableKind kind = isHash ? TableHash : (isPerCPU ? TablePerCPUArray : TableArray);
     builder->target->emitTableDecl(builder, dataMapName, kind, keyTypeName,
                                    "struct " + valueTypeName, size);
 }
@@ -260,8 +273,12 @@ void EBPFCounterPSA::emitCounterUpdate(CodeBuilder *builder, const cstring targe
 
     if (type == CounterType::BYTES || type == CounterType::PACKETS_AND_BYTES) {
         builder->emitIndent();
-        builder->appendFormat("__sync_fetch_and_add(&(%vbytes), %v)", targetWAccess,
-                              program->lengthVar);
+        if (isPerCPU) {
+            builder->appendFormat("%vbytes += %v", targetWAccess, program->lengthVar);
+        } else {
+            builder->appendFormat("__sync_fetch_and_add(&(%vbytes), %v)", targetWAccess,
+                                  program->lengthVar);
+        }
         builder->endOfStatement(true);
 
         varStr = absl::StrFormat("%sbytes", targetWAccess.c_str());
@@ -269,7 +286,11 @@ void EBPFCounterPSA::emitCounterUpdate(CodeBuilder *builder, const cstring targe
     }
     if (type == CounterType::PACKETS || type == CounterType::PACKETS_AND_BYTES) {
         builder->emitIndent();
-        builder->appendFormat("__sync_fetch_and_add(&(%spackets), 1)", targetWAccess.c_str());
+        if (isPerCPU) {
+            builder->appendFormat("%vpackets += 1", targetWAccess);
+        } else {
+            builder->appendFormat("__sync_fetch_and_add(&(%vpackets), 1)", targetWAccess);
+        }
         builder->endOfStatement(true);
 
         varStr = absl::StrFormat("%spackets", targetWAccess.c_str());
@@ -28,10 +28,14 @@ class EBPFCounterPSA : public EBPFCounterTable {
     EBPFType *dataplaneWidthType;
     EBPFType *indexWidthType;
     bool isDirect;
+    /// Each CPU updates its own copy of the counter without atomics. Selected with the
+    /// @per_cpu annotation on a Counter instance; see the README for the read limitations.
+    bool isPerCPU = false;
 
  public:
     enum CounterType { PACKETS, BYTES, PACKETS_AND_BYTES };
     CounterType type;
+    static const cstring perCPUAnnotation;
 
     EBPFCounterPSA(const EBPFProgram *program, const IR::Declaration_Instance *di, cstring name,
                    CodeGenInspector *codeGen);
@@ -54,24 +54,26 @@ void CRCChecksumAlgorithm::emitUpdateMethod(CodeBuilder *builder, int crcWidth)
     // version may require other method of update. When data_size <= 64 bits,
     // applies host byte order for input data, otherwise network byte order is expected.
     if (crcWidth == 16) {
-        // This function calculates CRC16 by definition, it is bit by bit. If input data has more
-        // than 64 bit, the outer loop process bytes in network byte order - data pointer is
-        // incremented. For data shorter than or equal 64 bits, bytes are processed in little endian
-        // byte order - data pointer is decremented by outer loop in this case.
-        // There is no need for lookup table.
+        // This function calculates CRC16 a byte at a time. If input data has more than 64 bit,
+        // the outer loop process bytes in network byte order - data pointer is incremented. For
+        // data shorter than or equal 64 bits, bytes are processed in little endian byte order -
+        // data pointer is decremented by outer loop in this case.
+        // There is no need for lookup table: for the reflected 0x8005 polynomial (0xA001) the
+        // eight bit steps over a byte x reduce to (x << 6) ^ (x << 7), plus 0xC001 when x has odd
+        // parity. The polynomial is built into this closed form, so it is not a parameter.
         const char *code =
             "static __always_inline\n"
-            "void crc16_update(u16 * reg, const u8 * data, "
-            "u16 data_size, const u16 poly) {\n"
+            "void crc16_update(u16 * reg, const u8 * data, u16 data_size) {\n"
             "    if (data_size <= 8)\n"
             "        data += data_size - 1;\n"
             "    #pragma clang loop unroll(full)\n"
             "    for (u16 i = 0; i < data_size; i++) {\n"
             "        bpf_trace_message(\"CRC16: data byte: %x\\n\", *data);\n"
-            "        *reg ^= *data;\n"
-            "        for (u8 bit = 0; bit < 8; bit++) {\n"
-            "            *reg = (*reg) & 1 ? ((*reg) >> 1) ^ poly : (*reg) >> 1;\n"
-            "        }\n"
+            "        u16 x = ((*reg) ^ *data) & 0xFF;\n"
+            "        u16 parity = x ^ (x >> 4);\n"
+            "        parity ^= parity >> 2;\n"
+            "        parity ^= parity >> 1;\n"
+            "        *reg = ((*reg) >> 8) ^ (x << 6) ^ (x << 7) ^ ((0 - (parity & 1)) & 0xC001);\n"
             "        if (data_size <= 8)\n"
             "            data--;\n"
             "        else\n"
@@ -90,14 +92,14 @@ void CRCChecksumAlgorithm::emitUpdateMethod(CodeBuilder *builder, int crcWidth)
         //    big endian byte order.
         // 4. Data size more than 8 bytes and not multiply of 8 bytes - calculated using slice-by-8
         //    and Standard Implementation both in big endian byte order.
-        // Lookup table is necessary for both algorithms.
+        // Lookup table is necessary for both algorithms, the reflected 0x04C11DB7 polynomial
+        // (0xEDB88320) is built into it. It is looked up once per update statement by the caller
+        // and passed in, rather than once per field.
         const char *code =
             "static __always_inline\n"
-            "void crc32_update(u32 * reg, const u8 * data, u16 data_size, const u32 poly) {\n"
+            "void crc32_update(u32 * reg, const u8 * data, u16 data_size,\n"
+            "                  struct lookup_tbl_val* lookup_table) {\n"
             "    u32* current = (u32*) data;\n"
-            "    struct lookup_tbl_val* lookup_table;\n"
-            "    u32 index = 0;\n"
-            "    lookup_table = BPF_MAP_LOOKUP_ELEM(crc_lookup_tbl, &index);\n"
             "    u32 lookup_key = 0;\n"
             "    u32 lookup_value = 0;\n"
             "    u32 lookup_value1 = 0;\n"
@@ -222,14 +224,15 @@ void CRCChecksumAlgorithm::emitClear(CodeBuilder *builder) {
 /// Checksum<bit<32>>(PSA_HashAlgorithm_t.CRC32) checksum;
 /// checksum.update(parsed_hdr.crc.f1);
 /// There will be generated a C code:
-/// crc32_update(&c_0_reg, (u8 *) &(parsed_hdr->crc.f1), 5, 0xEDB88320);
+/// crc32_update(&c_0_reg, (u8 *) &(parsed_hdr->crc.f1), 5, c_0_tbl);
 /// Where:
 /// c_0_reg - a checksum internal state (CRC register)
 /// parsed_hdr->field1 - a data on which CRC is calculated
 /// 5 - a field size in bytes
-/// 0xEDB88320 - a polynomial in a reflected bit order.
+/// c_0_tbl - the CRC32 lookup table, fetched once for the whole update (CRC32 only).
 void CRCChecksumAlgorithm::emitAddData(CodeBuilder *builder, const ArgumentsList &arguments) {
     cstring tmpVar = program->refMap->newName(baseName + "_tmp");
+    cstring extraArgs = ""_cs;
 
     builder->emitIndent();
     builder->blockStart();
@@ -238,6 +241,20 @@ void CRCChecksumAlgorithm::emitAddData(CodeBuilder *builder, const ArgumentsList
     builder->appendFormat("u8 %s = 0", tmpVar.c_str());
     builder->endOfStatement(true);
 
+    if (usesLookupTable) {
+        cstring tableVar = program->refMap->newName(baseName + "_tbl");
+        cstring indexVar = program->refMap->newName(baseName + "_tbl_idx");
+        builder->emitIndent();
+        builder->appendFormat("u32 %v = 0", indexVar);
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat(
+            "struct lookup_tbl_val* %v = BPF_MAP_LOOKUP_ELEM(crc_lookup_tbl, &%v)", tableVar,
+            indexVar);
+        builder->endOfStatement(true);
+        extraArgs = ", " + tableVar;
+    }
+
     bool concatenateBits = false;
     int remainingBits = 8;
     for (auto field : arguments) {
@@ -277,8 +294,8 @@ void CRCChecksumAlgorithm::emitAddData(CodeBuilder *builder, const ArgumentsList
                 concatenateBits = false;
                 builder->endOfStatement(true);
                 builder->emitIndent();
-                builder->appendFormat("%s(&%s, &%s, 1, %s)", updateMethod.c_str(),
-                                      registerVar.c_str(), tmpVar.c_str(), polynomial.c_str());
+                builder->appendFormat("%v(&%v, &%v, 1%v)", updateMethod, registerVar, tmpVar,
+                                      extraArgs);
                 builder->endOfStatement(true);
             }
         } else {
@@ -291,7 +308,7 @@ void CRCChecksumAlgorithm::emitAddData(CodeBuilder *builder, const ArgumentsList
             builder->emitIndent();
             builder->appendFormat("%s(&%s, (u8 *) &(", updateMethod.c_str(), registerVar.c_str());
             visitor->visit(field);
-            builder->appendFormat("), %d, %s)", width / 8, polynomial.c_str());
+            builder->appendFormat("), %d%v)", width / 8, extraArgs);
             builder->endOfStatement(true);
         }
     }
@@ -367,6 +384,24 @@ void InternetChecksumAlgorithm::updateChecksum(CodeBuilder *builder, const Argum
     builder->appendFormat("u16 %s = 0", tmpVar.c_str());
     builder->endOfStatement(true);
 
+    // Words are summed into 32 bits and the carries folded back once at the end, which gives
+    // the same result as an end-around-carry csum16_add() per word.
+    cstring sumVar = program->refMap->newName(baseName + "_sum");
+    builder->emitIndent();
+    builder->appendFormat("u32 %v = %v", sumVar, stateVar);
+    builder->endOfStatement(true);
+    auto emitUpdate = [&]() {
+        builder->target->emitTraceMessage(builder, "InternetChecksum: word=0x%llx", 1,
+                                          tmpVar.c_str());
+        builder->emitIndent();
+        if (addData) {
+            builder->appendFormat("%v += %v", sumVar, tmpVar);
+        } else {
+            builder->appendFormat("%v += (u16) ~%v", sumVar, tmpVar);
+        }
+        builder->endOfStatement(true);
+    };
+
     int remainingBits = 16, bitsToRead;
     for (auto field : arguments) {
         auto fieldType = field->type->to<IR::Type_Bits>();
@@ -403,19 +438,7 @@ void InternetChecksumAlgorithm::updateChecksum(CodeBuilder *builder, const Argum
                 visitor->visit(field);
                 builder->appendFormat("))[%u])", i);
                 builder->endOfStatement(true);
-
-                // update checksum
-                builder->target->emitTraceMessage(builder, "InternetChecksum: word=0x%llx", 1,
-                                                  tmpVar.c_str());
-                builder->emitIndent();
-                if (addData) {
-                    builder->appendFormat("%s = csum16_add(%s, %s)", stateVar.c_str(),
-                                          stateVar.c_str(), tmpVar.c_str());
-                } else {
-                    builder->appendFormat("%s = csum16_sub(%s, %s)", stateVar.c_str(),
-                                          stateVar.c_str(), tmpVar.c_str());
-                }
-                builder->endOfStatement(true);
+                emitUpdate();
             }
         } else {  // fields smaller or equal than 64 bits
             while (bitsToRead > 0) {
@@ -448,24 +471,21 @@ void InternetChecksumAlgorithm::updateChecksum(CodeBuilder *builder, const Argum
                 if (remainingBits == 0) {
                     remainingBits = 16;
                     builder->endOfStatement(true);
-
-                    // update checksum
-                    builder->target->emitTraceMessage(builder, "InternetChecksum: word=0x%llx", 1,
-                                                      tmpVar.c_str());
-                    builder->emitIndent();
-                    if (addData) {
-                        builder->appendFormat("%s = csum16_add(%s, %s)", stateVar.c_str(),
-                                              stateVar.c_str(), tmpVar.c_str());
-                    } else {
-                        builder->appendFormat("%s = csum16_sub(%s, %s)", stateVar.c_str(),
-                                              stateVar.c_str(), tmpVar.c_str());
-                    }
-                    builder->endOfStatement(true);
+                    emitUpdate();
                 }
             }
         }
     }
 
+    for (int i = 0; i < 2; i++) {
+        builder->emitIndent();
+        builder->appendFormat("%v = (%v & 0xFFFF) + (%v >> 16)", sumVar, sumVar, sumVar);
+        builder->endOfStatement(true);
+    }
+    builder->emitIndent();
+    builder->appendFormat("%v = (u16) %v", stateVar, sumVar);
+    builder->endOfStatement(true);
+
     builder->target->emitTraceMessage(builder, "InternetChecksum: new state=0x%llx", 1,
                                       stateVar.c_str());
     builder->blockEnd(true);
@@ -77,8 +77,9 @@ class CRCChecksumAlgorithm : public EBPFHashAlgorithmPSA {
     cstring initialValue;
     cstring updateMethod;
     cstring finalizeMethod;
-    cstring polynomial;
     const int crcWidth;
+    /// The update method takes the crc_lookup_tbl value as its last argument.
+    bool usesLookupTable = false;
 
  public:
     CRCChecksumAlgorithm(const EBPFProgram *program, cstring name, int width)
@@ -111,9 +112,6 @@ class CRC16ChecksumAlgorithm : public CRCChecksumAlgorithm {
     CRC16ChecksumAlgorithm(const EBPFProgram *program, cstring name)
         : CRCChecksumAlgorithm(program, name, 16) {
         initialValue = "0"_cs;
-        // We use a 0x8005 polynomial.
-        // 0xA001 comes from 0x8005 value bits reflection.
-        polynomial = "0xA001"_cs;
         updateMethod = "crc16_update"_cs;
         finalizeMethod = "crc16_finalize"_cs;
     }
@@ -133,11 +131,9 @@ class CRC32ChecksumAlgorithm : public CRCChecksumAlgorithm {
     CRC32ChecksumAlgorithm(const EBPFProgram *program, cstring name)
         : CRCChecksumAlgorithm(program, name, 32) {
         initialValue = "0xffffffff"_cs;
-        // We use a 0x04C11DB7 polynomial.
-        // 0xEDB88320 comes from 0x04C11DB7 value bits reflection.
-        polynomial = "0xEDB88320"_cs;
         updateMethod = "crc32_update"_cs;
         finalizeMethod = "crc32_finalize"_cs;
+        usesLookupTable = true;
     }
 
     static void emitGlobals(CodeBuilder *builder);
@@ -25,6 +25,20 @@ enum bpf_flags {
     USER_BPF_EXIST  // only update existing element
 };
 
+// Must match enum bpf_map_type in ebpf_test.h.
+enum bpf_types {
+    USER_BPF_MAP_TYPE_HASH,
+    USER_BPF_MAP_TYPE_ARRAY,
+};
+
+// Hash map slots start with this header, followed by the key and the value.
+struct slot_header {
+    uint32_t used;
+    uint32_t hash;
+};
+
+#define ALIGN8(x) (((x) + 7) & ~7U)
+
 static int check_flags(void *elem, unsigned long long map_flags) {
     if (map_flags > USER_BPF_EXIST)
         // unknown flags
@@ -38,51 +52,163 @@ static int check_flags(void *elem, unsigned long long map_flags) {
     return EXIT_SUCCESS;
 }
 
+/// Hashes the key eight bytes at a time, which covers most table keys in one or
+/// two rounds. Zero is reserved for the hash of unused slots.
+static uint32_t hash_key(const void *key, unsigned int key_size) {
+    const uint8_t *p = (const uint8_t *) key;
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ key_size;
+    while (key_size >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+        p += 8;
+        key_size -= 8;
+    }
+    if (key_size) {
+        uint64_t w = 0;
+        memcpy(&w, p, key_size);
+        h = (h ^ w) * 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 32;
+    }
+    return (uint32_t) h | 1;
+}
+
+static inline uint8_t *slot_at(struct bpf_map *map, unsigned int index) {
+    return map->slots + (size_t) index * map->slot_size;
+}
+
+static inline void *slot_key(uint8_t *slot) {
+    return slot + sizeof(struct slot_header);
+}
+
+/// Returns the slot holding the key, or the empty slot that ends its probe sequence.
+static uint8_t *find_slot(struct bpf_map *map, const void *key, uint32_t hash) {
+    unsigned int index = hash & map->mask;
+    while (1) {
+        uint8_t *slot = slot_at(map, index);
+        struct slot_header *header = (struct slot_header *) slot;
+        if (!header->used)
+            return slot;
+        if (header->hash == hash && memcmp(slot_key(slot), key, map->key_size) == 0)
+            return slot;
+        index = (index + 1) & map->mask;
+    }
+}
+
+struct bpf_map *bpf_map_create(unsigned int type, unsigned int key_size,
+                               unsigned int value_size, unsigned int max_entries) {
+    if (max_entries == 0 || value_size == 0)
+        return NULL;
+    struct bpf_map *map = (struct bpf_map *) calloc(1, sizeof(struct bpf_map));
+    if (!map)
+        return NULL;
+    map->type = type == USER_BPF_MAP_TYPE_ARRAY ? USER_BPF_MAP_TYPE_ARRAY : USER_BPF_MAP_TYPE_HASH;
+    map->key_size = key_size;
+    map->value_size = value_size;
+    map->max_entries = max_entries;
+    size_t num_slots;
+    if (map->type == USER_BPF_MAP_TYPE_ARRAY) {
+        // Like the kernel, array values are 8-byte aligned and always present.
+        map->slot_size = ALIGN8(value_size);
+        map->value_offset = 0;
+        num_slots = max_entries;
+    } else {
+        map->value_offset = sizeof(struct slot_header) + ALIGN8(key_size);
+        map->slot_size = map->value_offset + ALIGN8(value_size);
+        // Keep the load factor at or below one half so probe sequences stay short.
+        num_slots = 1;
+        while (num_slots < 2 * (size_t) max_entries)
+            num_slots <<= 1;
+        map->mask = num_slots - 1;
+    }
+    map->slots = (uint8_t *) calloc(num_slots, map->slot_size);
+    if (!map->slots) {
+        free(map);
+        return NULL;
+    }
+    return map;
+}
+
 void *bpf_map_lookup_elem(struct bpf_map *map, void *key, unsigned int key_size) {
-    struct bpf_map *tmp_map;
-    HASH_FIND(hh, map, key, key_size, tmp_map);
-    if (tmp_map == NULL)
+    if (map == NULL)
+        return NULL;
+    assert(key_size == map->key_size);
+    if (map->type == USER_BPF_MAP_TYPE_ARRAY) {
+        uint32_t index = *(uint32_t *) key;
+        if (index >= map->max_entries)
+            return NULL;
+        return slot_at(map, index);
+    }
+    uint8_t *slot = find_slot(map, key, hash_key(key, key_size));
+    if (!((struct slot_header *) slot)->used)
         return NULL;
-    return tmp_map->value;
+    return slot + map->value_offset;
 }
 
-int bpf_map_update_elem(struct bpf_map **map, void *key, unsigned int key_size, void *value, unsigned int value_size, unsigned long long flags) {
-    struct bpf_map *tmp_map;
-    HASH_FIND(hh, *map, key, key_size, tmp_map);
-    int ret = check_flags(tmp_map, flags);
+int bpf_map_update_elem(struct bpf_map *map, void *key, unsigned int key_size, void *value, unsigned int value_size, unsigned long long flags) {
+    if (map == NULL)
+        return EXIT_FAILURE;
+    assert(key_size == map->key_size && value_size == map->value_size);
+    if (map->type == USER_BPF_MAP_TYPE_ARRAY) {
+        uint32_t index = *(uint32_t *) key;
+        // All the elements of an array exist, they can never be created.
+        if (index >= map->max_entries || flags == USER_BPF_NOEXIST)
+            return EXIT_FAILURE;
+        memcpy(slot_at(map, index), value, value_size);
+        return EXIT_SUCCESS;
+    }
+    uint32_t hash = hash_key(key, key_size);
+    uint8_t *slot = find_slot(map, key, hash);
+    struct slot_header *header = (struct slot_header *) slot;
+    int ret = check_flags(header->used ? slot : NULL, flags);
     if (ret)
         return ret;
-    if (tmp_map == NULL) {
-        tmp_map = (struct bpf_map *) malloc(sizeof(struct bpf_map));
-        tmp_map->key = malloc(key_size);
-        memcpy(tmp_map->key, key, key_size);
-        HASH_ADD_KEYPTR(hh, *map, tmp_map->key, key_size, tmp_map);
+    if (!header->used) {
+        // The map is full.
+        if (map->count >= map->max_entries)
+            return EXIT_FAILURE;
+        header->used = 1;
+        header->hash = hash;
+        memcpy(slot_key(slot), key, key_size);
+        map->count++;
     }
-    tmp_map->value = malloc(value_size);
-    memcpy(tmp_map->value, value, value_size);
+    memcpy(slot + map->value_offset, value, value_size);
     return EXIT_SUCCESS;
 }
 
 int bpf_map_delete_elem(struct bpf_map *map, void *key, unsigned int key_size) {
-    struct bpf_map *tmp_map;
-    HASH_FIND(hh, map, key, key_size, tmp_map);
-    if (tmp_map != NULL) {
-        HASH_DEL(map, tmp_map);
-        free(tmp_map->value);
-        free(tmp_map->key);
-        free(tmp_map);
+    if (map == NULL || map->type == USER_BPF_MAP_TYPE_ARRAY)
+        return EXIT_FAILURE;
+    uint8_t *slot = find_slot(map, key, hash_key(key, key_size));
+    if (!((struct slot_header *) slot)->used)
+        return EXIT_SUCCESS;
+    // Shift the following elements of the probe sequence back so that
+    // lookups never need tombstones.
+    unsigned int hole = (slot - map->slots) / map->slot_size;
+    unsigned int index = hole;
+    while (1) {
+        index = (index + 1) & map->mask;
+        uint8_t *next = slot_at(map, index);
+        struct slot_header *header = (struct slot_header *) next;
+        if (!header->used)
+            break;
+        unsigned int home = header->hash & map->mask;
+        // Move the element if its home slot is not between the hole and its slot.
+        if (((index - home) & map->mask) >= ((index - hole) & map->mask)) {
+            memcpy(slot_at(map, hole), next, map->slot_size);
+            hole = index;
+        }
     }
+    memset(slot_at(map, hole), 0, map->slot_size);
+    map->count--;
     return EXIT_SUCCESS;
 }
 
 int bpf_map_delete_map(struct bpf_map *map) {
-    struct bpf_map *curr_map, *tmp_map;
-    HASH_ITER(hh, map, curr_map, tmp_map) {
-        HASH_DEL(map, curr_map);
-        free(curr_map->value);
-        free(curr_map->key);
-        free(curr_map);
-    }
+    if (map == NULL)
+        return EXIT_SUCCESS;
+    free(map->slots);
     free(map);
     return EXIT_SUCCESS;
 }
@@ -15,26 +15,46 @@ limitations under the License.
 */
 
 
-/// This file defines a library of simple hashmap operations which emulate the behavior
-/// of the kernel ebpf map API. This library is currently not thread-safe.
+/// This file defines a library of simple map operations which emulate the behavior
+/// of the kernel ebpf map API. Like the preallocated kernel maps, all the storage of
+/// a map is allocated when the map is created: hash maps use open addressing with
+/// linear probing and refuse new elements once max_entries is reached, array maps
+/// hold max_entries zero-initialized values that can be updated but never deleted.
+/// This library is currently not thread-safe.
 #ifndef BACKENDS_EBPF_RUNTIME_EBPF_MAP_H_
 #define BACKENDS_EBPF_RUNTIME_EBPF_MAP_H_
 
-#include "contrib/uthash.h"  // exports string.h, stddef.h, and stdlib.h
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 struct bpf_map {
-    void *key;
-    void *value;
-    UT_hash_handle hh;  // makes this structure hashable
+    unsigned int type;          // BPF_MAP_TYPE_HASH or BPF_MAP_TYPE_ARRAY
+    unsigned int key_size;      // size of the key structure
+    unsigned int value_size;    // size of the value structure
+    unsigned int max_entries;   // maximum number of elements
+    unsigned int count;         // number of elements in a hash map
+    unsigned int mask;          // number of slots - 1, the number of slots is a power of 2
+    unsigned int slot_size;     // size of a slot: header, key and value, 8-byte aligned
+    unsigned int value_offset;  // offset of the value in a slot
+    uint8_t *slots;             // preallocated storage
 };
 
+/// @brief Create a map.
+/// @details Allocates all the storage needed to hold max_entries elements.
+/// Types other than BPF_MAP_TYPE_ARRAY are emulated with a hash map.
+///
+/// @return NULL if the map cannot be allocated
+struct bpf_map *bpf_map_create(unsigned int type, unsigned int key_size,
+                               unsigned int value_size, unsigned int max_entries);
+
 /// @brief Add/Update a value in the map
 /// @details Updates a value in the map based on the provided key.
 /// If the key does not exist, it depends on the provided flags if the
 /// element is added or the operation is rejected.
 ///
 /// @return EXIT_FAILURE if update operation fails
-int bpf_map_update_elem(struct bpf_map **map, void *key, unsigned int key_size, void *value,unsigned int value_size, unsigned long long flags);
+int bpf_map_update_elem(struct bpf_map *map, void *key, unsigned int key_size, void *value,unsigned int value_size, unsigned long long flags);
 
 /// @brief Find a value based on a key.
 /// @details Provides a pointer to a value in the map based on the provided key.
@@ -46,6 +66,7 @@ void *bpf_map_lookup_elem(struct bpf_map *map, void *key, unsigned int key_size)
 /// @brief Delete key and value from the map.
 /// @details Deletes the key and the corresponding value from the map.
 /// If the key does not exist, no operation is performed.
+/// Elements of array maps cannot be deleted.
 ///
 /// @return EXIT_FAILURE if operation fails.
 int bpf_map_delete_elem(struct bpf_map *map, void *key, unsigned int key_size);
@@ -16,6 +16,7 @@ limitations under the License.
 
 /// Implementation of ebpf registry. Intended to provide a common access interface between control and data plane. Emulates the linux userspace API which can access the kernel eBPF map using string and integer identifiers.
 #include <stdio.h>
+#include "contrib/uthash.h"
 #include "ebpf_registry.h"
 
 /// @brief Defines the structure of the central registry.
@@ -57,6 +58,14 @@ int registry_add(struct bpf_table *tbl) {
         fprintf(stderr, "Error: Key name %s exceeds maximum size %d", tbl->name, MAX_TABLE_NAME_LENGTH);
         return EXIT_FAILURE;
     }
+    // Preallocate the map, as the kernel does when the map is created
+    if (tbl->bpf_map == NULL) {
+        tbl->bpf_map = bpf_map_create(tbl->type, tbl->key_size, tbl->value_size, tbl->max_entries);
+        if (tbl->bpf_map == NULL) {
+            fprintf(stderr, "Error: Could not allocate table %s\n", tbl->name);
+            return EXIT_FAILURE;
+        }
+    }
     // Add the table
     tmp_reg = malloc(sizeof(registry_entry));
     if (!tmp_reg) {
@@ -79,6 +88,7 @@ void registry_delete() {
     HASH_ITER(h_name, reg_tables_name, curr_tbl, tmp_tbl) {
         HASH_DELETE(h_name, reg_tables_name, curr_tbl);
         bpf_map_delete_map(curr_tbl->tbl->bpf_map);
+        curr_tbl->tbl->bpf_map = NULL;
         free(curr_tbl);
     }
     curr_tbl = NULL;
@@ -92,6 +102,7 @@ int registry_delete_tbl(const char *name) {
     registry_entry *tmp_reg = find_register(name);
     if (tmp_reg != NULL) {
         bpf_map_delete_map(tmp_reg->tbl->bpf_map);
+        tmp_reg->tbl->bpf_map = NULL;
         HASH_DELETE(h_name, reg_tables_name, tmp_reg);
         HASH_DELETE(h_id, reg_tables_id, tmp_reg);
         free(tmp_reg);
@@ -120,7 +131,7 @@ int registry_update_table(const char *name, void *key, void *value, unsigned lon
     if (tmp_tbl == NULL)
         // not found, return
         return EXIT_FAILURE;
-    return bpf_map_update_elem(&tmp_tbl->bpf_map, key, tmp_tbl->key_size, value, tmp_tbl->value_size, flags);
+    return bpf_map_update_elem(tmp_tbl->bpf_map, key, tmp_tbl->key_size, value, tmp_tbl->value_size, flags);
 }
 
 int registry_update_table_id(int tbl_id, void *key, void *value, unsigned long long flags) {
@@ -128,7 +139,7 @@ int registry_update_table_id(int tbl_id, void *key, void *value, unsigned long l
     if (tmp_tbl == NULL)
         // not found, return
         return EXIT_FAILURE;
-    return bpf_map_update_elem(&tmp_tbl->bpf_map, key, tmp_tbl->key_size, value, tmp_tbl->value_size, flags);
+    return bpf_map_update_elem(tmp_tbl->bpf_map, key, tmp_tbl->key_size, value, tmp_tbl->value_size, flags);
 }
 
 int registry_delete_table_elem(const char *name, void *key) {
@@ -28,18 +28,17 @@ limitations under the License.
 /// @brief A helper structure used to describe attributes.
 /// @details This structure describes various properties of the ebpf table
 /// such as key and value size and the maximum amount of entries possible.
-/// In userspace, this space is theoretically unlimited.
-/// This table definition points to an actual hashmap managed by uthash,
-/// the relation is many-to-one.
+/// The map is preallocated for max_entries elements when the table is added
+/// to the registry, the relation is many-to-one.
 /// "name" should not exceed VAR_SIZE. Functions using bpf_table also assume
 /// that "name" is a conventional null-terminated string.
 struct bpf_table {
     char *name;                 // table name longer than VAR_SIZE is not accessed
-    unsigned int type;          // currently only hashmap is supported
+    unsigned int type;          // hash or array map
     unsigned int key_size;      // size of the key structure
     unsigned int value_size;    // size of the value structure
     unsigned int max_entries;   // Maximum of possible entries
-    struct bpf_map *bpf_map;    // Pointer to the actual hash map
+    struct bpf_map *bpf_map;    // Pointer to the actual map
 };
 
 /// @brief Adds a new table to the registry.
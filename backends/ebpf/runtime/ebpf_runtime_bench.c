@@ -0,0 +1,214 @@
+/*
+Copyright 2018 VMware, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <linux/perf_event.h>   // perf_event_attr
+#include <sys/ioctl.h>          // ioctl()
+#include <sys/syscall.h>        // SYS_perf_event_open
+#include <time.h>               // clock_gettime()
+#include <unistd.h>             // syscall(), read(), close()
+#include <string.h>             // memcpy()
+#include <stdlib.h>             // aligned_alloc()
+#include "ebpf_test.h"
+#include "ebpf_runtime_bench.h"
+
+#define DEFAULT_PACKETS 10000000ULL
+#define DEFAULT_BATCH   32
+/// Packets start on their own cache line, as they would in a NIC buffer.
+#define PKT_ALIGN       64
+
+/// The preloaded input packets. The filter may rewrite packets, so it is
+/// handed a working copy that is restored from the pristine one before each
+/// pass over the pool.
+typedef struct {
+    uint8_t *pristine;
+    uint8_t *data;
+    size_t size;
+    struct sk_buff *skbs;
+    uint32_t num_pkts;
+} pkt_pool_t;
+
+/// Hardware counters of the benchmark thread, fd is -1 when unavailable.
+typedef struct {
+    int fd;             // group leader, counts cycles
+    int instructions_fd;
+    uint64_t cycles;
+    uint64_t instructions;
+} perf_counters_t;
+
+static uint64_t env_or_default(const char *name, uint64_t value) {
+    const char *str = getenv(name);
+    if (str == NULL || *str == '\0')
+        return value;
+    uint64_t result = strtoull(str, NULL, 10);
+    return result ? result : value;
+}
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void build_pool(pkt_pool_t *pool, pcap_list_t *pkt_list) {
+    pool->num_pkts = get_pkt_list_length(pkt_list);
+    pool->size = 0;
+    for (uint32_t i = 0; i < pool->num_pkts; i++) {
+        pcap_pkt *pkt = get_packet(pkt_list, i);
+        pool->size += (pkt->pcap_hdr.len + PKT_ALIGN - 1) & ~(size_t) (PKT_ALIGN - 1);
+    }
+    pool->pristine = aligned_alloc(PKT_ALIGN, pool->size);
+    pool->data = aligned_alloc(PKT_ALIGN, pool->size);
+    pool->skbs = calloc(pool->num_pkts, sizeof(struct sk_buff));
+    if (!pool->pristine || !pool->data || !pool->skbs) {
+        perror("Fatal: Could not allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(pool->pristine, 0, pool->size);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < pool->num_pkts; i++) {
+        pcap_pkt *pkt = get_packet(pkt_list, i);
+        memcpy(pool->pristine + offset, pkt->data, pkt->pcap_hdr.caplen);
+        pool->skbs[i].data = pool->data + offset;
+        pool->skbs[i].len = pkt->pcap_hdr.len;
+        pool->skbs[i].ifindex = pkt->ifindex;
+        offset += (pkt->pcap_hdr.len + PKT_ALIGN - 1) & ~(size_t) (PKT_ALIGN - 1);
+    }
+}
+
+static void delete_pool(pkt_pool_t *pool) {
+    free(pool->pristine);
+    free(pool->data);
+    free(pool->skbs);
+}
+
+static void open_counters(perf_counters_t *counters, int debug) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    counters->fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (counters->fd >= 0) {
+        attr.disabled = 0;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        counters->instructions_fd = syscall(SYS_perf_event_open, &attr, 0, -1, counters->fd, 0);
+        if (counters->instructions_fd < 0) {
+            close(counters->fd);
+            counters->fd = -1;
+        }
+    }
+    if (counters->fd < 0 && debug)
+        printf("Hardware performance counters are not available\n");
+    counters->cycles = 0;
+    counters->instructions = 0;
+}
+
+static void start_counters(perf_counters_t *counters) {
+    if (counters && counters->fd >= 0)
+        ioctl(counters->fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static void stop_counters(perf_counters_t *counters) {
+    if (counters && counters->fd >= 0)
+        ioctl(counters->fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static void read_counters(perf_counters_t *counters) {
+    if (counters->fd < 0)
+        return;
+    // With PERF_FORMAT_GROUP the read returns the number of events and their values.
+    uint64_t values[3];
+    if (read(counters->fd, values, sizeof(values)) == sizeof(values)) {
+        counters->cycles = values[1];
+        counters->instructions = values[2];
+    }
+}
+
+/// @brief Feed a batch of packets into the eBPF program.
+/// @return The number of packets the program forwarded.
+static uint32_t run_batch(packet_filter ebpf_filter, struct sk_buff *skbs, uint32_t num) {
+    uint32_t forwarded = 0;
+    for (uint32_t i = 0; i < num; i++)
+        forwarded += ebpf_filter(&skbs[i]) != 0;
+    return forwarded;
+}
+
+/// @brief Run the whole pool through the program in batches.
+/// @details The pool is restored before the pass, the restore is neither
+/// accounted for in the returned time nor in the counters.
+/// @return The time spent in the program, in nanoseconds.
+static uint64_t run_pass(packet_filter ebpf_filter, pkt_pool_t *pool, uint32_t num,
+                         uint32_t batch, uint64_t *forwarded, perf_counters_t *counters) {
+    memcpy(pool->data, pool->pristine, pool->size);
+    start_counters(counters);
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < num; i += batch) {
+        uint32_t n = num - i < batch ? num - i : batch;
+        *forwarded += run_batch(ebpf_filter, pool->skbs + i, n);
+    }
+    uint64_t elapsed = now_ns() - start;
+    stop_counters(counters);
+    return elapsed;
+}
+
+void run_benchmark(packet_filter ebpf_filter, pcap_list_t *pkt_list, int debug) {
+    uint64_t total = env_or_default("EBPF_BENCH_PACKETS", DEFAULT_PACKETS);
+    uint32_t batch = env_or_default("EBPF_BENCH_BATCH", DEFAULT_BATCH);
+    pkt_pool_t pool;
+    build_pool(&pool, pkt_list);
+    if (pool.num_pkts == 0) {
+        fprintf(stderr, "No input packets to run the benchmark with\n");
+        delete_pool(&pool);
+        return;
+    }
+    if (debug)
+        printf("Preloaded %u packets (%zu bytes), batch size %u\n", pool.num_pkts, pool.size,
+               batch);
+
+    // Warm up the caches, the branch predictors and the maps.
+    uint64_t forwarded = 0;
+    run_pass(ebpf_filter, &pool, pool.num_pkts, batch, &forwarded, NULL);
+
+    perf_counters_t counters;
+    open_counters(&counters, debug);
+    forwarded = 0;
+    uint64_t elapsed = 0;
+    for (uint64_t done = 0; done < total;) {
+        uint32_t num = total - done < pool.num_pkts ? total - done : pool.num_pkts;
+        elapsed += run_pass(ebpf_filter, &pool, num, batch, &forwarded, &counters);
+        done += num;
+    }
+    read_counters(&counters);
+
+    printf("Packets:      %llu\n", (unsigned long long) total);
+    printf("Forwarded:    %llu\n", (unsigned long long) forwarded);
+    printf("Dropped:      %llu\n", (unsigned long long) (total - forwarded));
+    printf("Time:         %.3f s\n", elapsed / 1e9);
+    printf("Throughput:   %.3f Mpps\n", elapsed ? total * 1e3 / elapsed : 0.0);
+    printf("Latency:      %.2f ns/packet\n", (double) elapsed / total);
+    if (counters.fd >= 0) {
+        printf("Cycles:       %.2f /packet\n", (double) counters.cycles / total);
+        printf("Instructions: %.2f /packet (IPC %.2f)\n", (double) counters.instructions / total,
+               counters.cycles ? (double) counters.instructions / counters.cycles : 0.0);
+        close(counters.instructions_fd);
+        close(counters.fd);
+    }
+    delete_pool(&pool);
+}
@@ -0,0 +1,37 @@
+/*
+Copyright 2018 VMware, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+/// Throughput benchmark built on top of the test target. Instead of recording
+/// the output of each packet once, the input packets are preloaded into a
+/// memory pool and fed to the filter function in batches until the requested
+/// number of packets has been processed. The run is reported in packets per
+/// second, together with the cycles and instructions per packet when the
+/// hardware performance counters are accessible.
+/// Select it with "make -f runtime.mk TARGET=test RUNTIME=bench ...".
+/// The number of packets and the batch size are taken from the environment
+/// variables EBPF_BENCH_PACKETS and EBPF_BENCH_BATCH.
+#ifndef BACKENDS_EBPF_RUNTIME_EBPF_RUNTIME_BENCH_H_
+#define BACKENDS_EBPF_RUNTIME_EBPF_RUNTIME_BENCH_H_
+
+#include "ebpf_runtime_test.h"
+
+void run_benchmark(packet_filter ebpf_filter, pcap_list_t *pkt_list, int debug);
+
+#undef RUN
+#define RUN(ebpf_filter, pcap_base, num_pcaps, input_list, debug) \
+    run_benchmark(ebpf_filter, input_list, debug)
+
+#endif  // BACKENDS_EBPF_RUNTIME_EBPF_RUNTIME_BENCH_H_
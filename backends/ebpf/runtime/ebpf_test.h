@@ -89,12 +89,32 @@ struct bpf_table tables[] = {
     { 0, 0, 0, 0, 0 } \
 };
 
+/// Resolves a table by name once per call site, so that the per-packet map
+/// operations do not go through the registry. The table descriptor outlives
+/// its map, which is NULL while the table is not registered.
+#define REGISTRY_TABLE(table) \
+    ({ \
+        static struct bpf_table *____tbl = NULL; \
+        if (____tbl == NULL) \
+            ____tbl = registry_lookup_table(MAP_PATH"/"#table); \
+        ____tbl; \
+    })
 #define BPF_MAP_LOOKUP_ELEM(table, key) \
-    registry_lookup_table_elem(MAP_PATH"/"#table, key)
+    ({ \
+        struct bpf_table *____t = REGISTRY_TABLE(table); \
+        ____t ? bpf_map_lookup_elem(____t->bpf_map, key, ____t->key_size) : NULL; \
+    })
 #define BPF_MAP_UPDATE_ELEM(table, key, value, flags) \
-    registry_update_table(MAP_PATH"/"#table, key, value, flags)
+    ({ \
+        struct bpf_table *____t = REGISTRY_TABLE(table); \
+        ____t ? bpf_map_update_elem(____t->bpf_map, key, ____t->key_size, value, \
+                                    ____t->value_size, flags) : EXIT_FAILURE; \
+    })
 #define BPF_MAP_DELETE_ELEM(table, key) \
-    registry_delete_table_elem(MAP_PATH"/"#table, key)
+    ({ \
+        struct bpf_table *____t = REGISTRY_TABLE(table); \
+        ____t ? bpf_map_delete_elem(____t->bpf_map, key, ____t->key_size) : EXIT_FAILURE; \
+    })
 #define BPF_USER_MAP_UPDATE_ELEM(index, key, value, flags)\
     registry_update_table_id(index, key, value, flags)
 #define BPF_OBJ_PIN(table, name) registry_add(table)
@@ -17,13 +17,15 @@ P4FILE=
 P4C=p4c-ebpf
 # the default target is test but it can be overridden
 TARGET=test
+# The runtime linked with the program, "bench" runs the test target in a throughput loop
+RUNTIME ?= $(TARGET)
 # Extra arguments for the compiler
 P4ARGS=
 
 # Argument for the GCC compiler
 GCC ?= gcc
 BUILDDIR:= $(BPFDIR)build
-override INCLUDES+= -I$(ROOT_DIR) -include $(ROOT_DIR)ebpf_runtime_$(TARGET).h
+override INCLUDES+= -I$(ROOT_DIR) -include $(ROOT_DIR)ebpf_runtime_$(RUNTIME).h
 # Optimization flags to save space
 override CFLAGS+= -O2 -g # -Wall -Werror
 override LIBS+= -lpcap
@@ -31,6 +33,9 @@ override LIBS+= -lpcap
 # The base files required to build the runtime
 SOURCE_BASE= $(ROOT_DIR)ebpf_runtime.c $(ROOT_DIR)pcap_util.c
 SOURCE_BASE+= $(ROOT_DIR)ebpf_runtime_$(TARGET).c
+ifneq ($(RUNTIME),$(TARGET))
+SOURCE_BASE+= $(ROOT_DIR)ebpf_runtime_$(RUNTIME).c
+endif
 # Add the generated file and externs to the base sources
 override SOURCES+= $(SOURCE_BASE)
 SRC_PROCESSED= $(notdir $(SOURCES)) $(EXTERNOBJ)
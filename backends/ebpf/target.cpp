@@ -214,6 +214,11 @@ void XdpTarget::emitResizeBuffer(Util::SourceCodeBuilder *builder, cstring buffe
     builder->appendFormat("bpf_xdp_adjust_head(%v, -%v)", buffer, offsetVar);
 }
 
+void P4TCXdpTarget::emitResizeBuffer(Util::SourceCodeBuilder *builder, cstring buffer,
+                                     cstring offsetVar) const {
+    builder->appendFormat("bpf_xdp_adjust_head(%v, -%v)", buffer, offsetVar);
+}
+
 //////////////////////////////////////////////////////////////
 
 void TestTarget::emitIncludes(Util::SourceCodeBuilder *builder) const {
@@ -243,6 +243,29 @@ class P4TCTarget : public KernelSamplesTarget {
         return (width <= 8 || width <= 16 || (width > 24 && width <= 32) ||
                 (width > 56 && width <= 64));
     }
+
+    /// Name of the P4TC kfunc @p name for the context of this target, e.g. bpf_p4tc_tbl_read.
+    virtual cstring p4tcKfunc(cstring name) const { return "bpf_p4tc_"_cs + name; }
+};
+
+/// P4TC pipeline compiled for the XDP hook. The P4TC kfuncs have xdp_ variants that take
+/// the xdp_md context.
+class P4TCXdpTarget : public P4TCTarget {
+ public:
+    explicit P4TCXdpTarget(bool emitTrace) : P4TCTarget(emitTrace) {}
+
+    cstring forwardReturnCode() const override { return "XDP_PASS"_cs; }
+    cstring dropReturnCode() const override { return "XDP_DROP"_cs; }
+    cstring abortReturnCode() const override { return "XDP_ABORTED"_cs; }
+    cstring sysMapPath() const override { return "/sys/fs/bpf/xdp/globals"_cs; }
+    cstring packetDescriptorType() const override { return "struct xdp_md"_cs; }
+
+    cstring dataLength(cstring base) const override {
+        return cstring("(") + base + "->data_end - " + base + "->data)";
+    }
+    void emitResizeBuffer(Util::SourceCodeBuilder *builder, cstring buffer,
+                          cstring offsetVar) const override;
+    cstring p4tcKfunc(cstring name) const override { return "xdp_p4tc_"_cs + name; }
 };
 
 /// Target XDP.
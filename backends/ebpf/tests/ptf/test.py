@@ -992,3 +992,29 @@ class WideFieldTableSupport(P4EbpfTest):
             exp_pkt[IPv6].hlim = exp_pkt[IPv6].hlim - t.get("no_table_matches", 2)
             testutils.send_packet(self, PORT0, pkt)
             testutils.verify_packet_any_port(self, exp_pkt, PTF_PORTS)
+
+
+class WideLoadStraddlingFieldPSATest(P4EbpfTest):
+    """
+    Extracts fields that cross the boundary between the 64-bit words a header is loaded in,
+    and checks their values after masking.
+    """
+
+    p4_file_path = "p4testdata/wide-load-straddle.p4"
+
+    def runTest(self):
+        pkt = Ether(src="00:11:22:33:44:55", type=0x88B5) / bytes.fromhex(
+            "ffffffffffffff abcd ffffffffffffff" + "00" * 30
+        )
+        exp_pkt = Ether(src="00:11:22:33:44:55", type=0x88B5) / bytes.fromhex(
+            "0000000000abcd abcd 00001122334455" + "00" * 30
+        )
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, exp_pkt, PORT1)
+
+        # the bits around a straddling field must not leak into its value
+        pkt = Ether(src="00:11:22:33:44:56", type=0x88B5) / bytes.fromhex(
+            "ffffffffffffff abcd ffffffffffffff" + "00" * 30
+        )
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_no_other_packets(self)
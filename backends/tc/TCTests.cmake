@@ -40,6 +40,12 @@ endif()
 
 # Only enable P4TC and P4TC STF tests when all required tools are available.
 p4c_add_tests("p4tc" ${P4TC_COMPILER_DRIVER} "${P4_16_SUITES}" "")
+# --xdp-fastpath on one program inside the XDP subset and one outside of it.
+set (P4TC_XDP_SUITES
+  "${P4C_SOURCE_DIR}/testdata/p4tc_samples/simple_exact_example.p4"
+  "${P4C_SOURCE_DIR}/testdata/p4tc_samples/direct_counter_example.p4")
+p4c_add_tests("p4tc-xdp" ${P4TC_COMPILER_DRIVER} "${P4TC_XDP_SUITES}" ""
+  "--outputs ${P4C_SOURCE_DIR}/testdata/p4tc_samples_xdp_outputs --compiler-args=--xdp-fastpath")
 
 if (ENABLE_P4TC_STF_TESTS)
   # Setup fixture
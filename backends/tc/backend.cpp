@@ -16,7 +16,10 @@ and limitations under the License.
 
 #include "backend.h"
 
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 
 #include "backends/ebpf/ebpfOptions.h"
 #include "backends/ebpf/target.h"
@@ -118,6 +121,19 @@ bool Backend::ebpfCodeGen(P4::ReferenceMap *refMapEBPF, P4::TypeMap *typeMapEBPF
 
     ebpf_program = convertToEbpf->getEBPFProgram();
 
+    if (options.xdpFastPath && ebpf_program != nullptr) {
+        auto pipe = ebpf_program->pipeline;
+        xdpCheck = new XdpEligibilityCheck(refMapEBPF, typeMapEBPF);
+        xdpCheck->check(pipe->parser->parserBlock, pipe->control->controlBlock,
+                        pipe->deparser->controlBlock);
+        if (!xdpCheck->eligible()) {
+            ::P4::warning(ErrorType::WARN_UNSUPPORTED,
+                          "%1%: %2% construct(s) cannot run in XDP, falling back to TC; see "
+                          "the XDP eligibility report for details",
+                          main->type->name, xdpCheck->getReasons().size());
+        }
+    }
+
     return true;
 }
 
@@ -168,6 +184,30 @@ void Backend::serialize() const {
     cstream->flush();
     pstream->flush();
     hstream->flush();
+    if (xdpCheck != nullptr && xdpCheck->eligible()) {
+        EBPF::CodeBuilder x(new EBPF::P4TCXdpTarget(options.emitTraceMessages));
+        ebpf_program->emitXdp(&x);
+        std::filesystem::path xdpFile = options.outputFolder / (progName + "_xdp.c");
+        auto xstream = openFile(xdpFile, false);
+        if (xstream == nullptr) {
+            ::P4::error("Unable to open File %1%", xdpFile);
+            return;
+        }
+        *xstream << x.toString();
+        xstream->flush();
+    }
+    if (xdpCheck != nullptr) {
+        // The report is informational; openFile would turn a failure into an error, so the
+        // file is opened directly and a failure only warns.
+        std::filesystem::path reportFile = options.outputFolder / (progName + "_xdp_report.txt");
+        std::ofstream rstream(reportFile);
+        if (rstream.good()) xdpCheck->report(rstream, cstring(progName));
+        rstream.flush();
+        if (!rstream.good()) {
+            ::P4::warning(ErrorType::WARN_IGNORE, "Unable to write the XDP report %1%: %2%",
+                          reportFile, strerror(errno));
+        }
+    }
 }
 
 bool Backend::serializeIntrospectionJson(std::ostream &out) const {
@@ -34,6 +34,7 @@ and limitations under the License.
 #include "pnaProgramStructure.h"
 #include "tcAnnotations.h"
 #include "tc_defines.h"
+#include "xdpEligibility.h"
 
 namespace P4::TC {
 
@@ -162,6 +163,7 @@ class Backend : public PassManager {
     EbpfOptions ebpfOption;
     EBPF::Target *target;
     const PNAEbpfGenerator *ebpf_program;
+    XdpEligibilityCheck *xdpCheck = nullptr;
 
  public:
     explicit Backend(const IR::ToplevelBlock *toplevel, P4::ReferenceMap *refMap,
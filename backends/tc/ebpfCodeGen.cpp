@@ -298,6 +298,30 @@ void PNAArchTC::emitParser(EBPF::CodeBuilder *builder) const {
     builder->target->emitLicense(builder, pipeline->license);
 }
 
+void PNAArchTC::emitXdp(EBPF::CodeBuilder *builder) const {
+    /**
+     * Structure of a C XDP program for PNA
+     * 1. Automatically generated comment
+     * 2. Includes
+     * 3. Headers, structs
+     * 4. XDP program running the parser, control and deparser.
+     */
+    xdp->emitGeneratedComment(builder);
+    cstring headerFile = getProgramName() + "_parser.h";
+    builder->appendFormat("#include \"%v\"", headerFile);
+    builder->newline();
+    emitInternalStructures(builder);
+    emitTypes(builder);
+
+    pipeline->name = "xdp-ingress"_cs;
+    pipeline->sectionName = "p4tc/xdp"_cs;
+    pipeline->functionName = pipeline->name.replace('-', '_') + "_func";
+    pipeline->ifindexVar = "skb->ingress_ifindex"_cs;
+    pipeline->progTarget = builder->target;
+    pipeline->emit(builder);
+    builder->target->emitLicense(builder, pipeline->license);
+}
+
 void PNAArchTC::emitHeader(EBPF::CodeBuilder *builder) const {
     xdp->emitGeneratedComment(builder);
     builder->target->emitIncludes(builder);
@@ -318,6 +342,9 @@ void PNAArchTC::emitHeader(EBPF::CodeBuilder *builder) const {
 // =====================TCIngressPipelinePNA=============================
 void TCIngressPipelinePNA::emit(EBPF::CodeBuilder *builder) {
     cstring msgStr, varStr;
+    // The XDP program runs the parser, control and deparser in one function.
+    bool runParser = name == "tc-parse" || isXdp();
+    bool runControl = name == "tc-ingress" || isXdp();
 
     // firstly emit process() in-lined function and then the actual BPF section.
     builder->append("static __always_inline");
@@ -331,7 +358,7 @@ void TCIngressPipelinePNA::emit(EBPF::CodeBuilder *builder) {
         parser->headerType->as<EBPF::EBPFStructType>().kind,
         parser->headerType->as<EBPF::EBPFStructType>().name, parser->headers->name,
         compilerGlobalMetadata);
-    if (func_name == "process") builder->append(", struct skb_aggregate *sa");
+    if (name == "tc-ingress") builder->append(", struct skb_aggregate *sa");
     builder->append(")");
     builder->newline();
 
@@ -343,7 +370,7 @@ void TCIngressPipelinePNA::emit(EBPF::CodeBuilder *builder) {
     builder->newline();
     emitUserMetadataInstance(builder);
 
-    if (name == "tc-parse") {
+    if (runParser) {
         builder->newline();
         emitCPUMAPInitializers(builder);
         builder->newline();
@@ -371,7 +398,7 @@ void TCIngressPipelinePNA::emit(EBPF::CodeBuilder *builder) {
     emitMetadataFromCPUMAP(builder);
     builder->newline();
 
-    if (name == "tc-parse") {
+    if (runParser) {
         msgStr = absl::StrFormat(
             "%v parser: parsing new packet, input_port=%%d, path=%%d, "
             "pkt_len=%%d",
@@ -390,7 +417,7 @@ void TCIngressPipelinePNA::emit(EBPF::CodeBuilder *builder) {
         builder->newline();
     }
 
-    if (name == "tc-ingress") {
+    if (runControl) {
         // CONTROL
         builder->blockStart();
         msgStr = absl::StrFormat("%v control: packet processing started", sectionName);
@@ -422,7 +449,44 @@ void TCIngressPipelinePNA::emit(EBPF::CodeBuilder *builder) {
     builder->newline();
     builder->blockEnd(true);
 
-    if (name == "tc-ingress") {
+    if (isXdp()) {
+        builder->target->emitCodeSection(builder, sectionName);
+        builder->emitIndent();
+        builder->appendFormat("int %v(%v *%s)", functionName,
+                              builder->target->packetDescriptorType(), model.CPacketName.str());
+        builder->spc();
+
+        builder->blockStart();
+
+        emitGlobalMetadataInitializer(builder);
+
+        emitHeaderInstances(builder);
+        builder->newline();
+
+        builder->emitIndent();
+        builder->appendFormat("int ret = %d;", actUnspecCode);
+        builder->newline();
+        builder->emitIndent();
+        builder->appendFormat("ret = %v(skb, ", func_name);
+
+        builder->appendFormat("(%v %v *) %v, %v);",
+                              parser->headerType->as<EBPF::EBPFStructType>().kind,
+                              parser->headerType->as<EBPF::EBPFStructType>().name,
+                              parser->headers->name, compilerGlobalMetadata);
+
+        builder->newline();
+        builder->emitIndent();
+        builder->appendFormat(
+            "if (ret != %d) {\n"
+            "        return ret;\n"
+            "    }",
+            actUnspecCode);
+        builder->newline();
+
+        this->emitTrafficManager(builder);
+
+        builder->blockEnd(true);
+    } else if (name == "tc-ingress") {
         builder->target->emitCodeSection(builder, sectionName);
         builder->emitIndent();
         builder->appendFormat("int %v(%v *%s)", functionName,
@@ -527,6 +591,18 @@ void TCIngressPipelinePNA::emit(EBPF::CodeBuilder *builder) {
 }
 
 void TCIngressPipelinePNA::emitGlobalMetadataInitializer(EBPF::CodeBuilder *builder) {
+    if (isXdp()) {
+        // There is no skb->cb in XDP, and nothing is carried over from an earlier hook.
+        builder->emitIndent();
+        builder->append("struct pna_global_metadata xdp_meta = {};");
+        builder->newline();
+        builder->emitIndent();
+        builder->appendFormat("struct pna_global_metadata *%v = &xdp_meta;",
+                              compilerGlobalMetadata);
+        builder->newline();
+        return;
+    }
+
     builder->emitIndent();
     builder->appendFormat(
         "struct pna_global_metadata *%v = (struct pna_global_metadata *) skb->cb;",
@@ -569,24 +645,28 @@ void TCIngressPipelinePNA::emitGlobalMetadataInitializer(EBPF::CodeBuilder *buil
 }
 
 void TCIngressPipelinePNA::emitTrafficManager(EBPF::CodeBuilder *builder) {
-    builder->emitIndent();
-    builder->appendFormat("if (!%v->drop && %v->recirculate) ", compilerGlobalMetadata,
-                          compilerGlobalMetadata);
-    builder->blockStart();
-    builder->emitIndent();
-    builder->appendFormat("%v->recirculated = true;", compilerGlobalMetadata);
-    builder->newline();
-    builder->emitIndent();
-    builder->appendFormat("return TC_ACT_UNSPEC;");
-    builder->newline();
-    builder->blockEnd(true);
+    // Programs that recirculate are not compiled for XDP.
+    if (!isXdp()) {
+        builder->emitIndent();
+        builder->appendFormat("if (!%v->drop && %v->recirculate) ", compilerGlobalMetadata,
+                              compilerGlobalMetadata);
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendFormat("%v->recirculated = true;", compilerGlobalMetadata);
+        builder->newline();
+        builder->emitIndent();
+        builder->appendFormat("return TC_ACT_UNSPEC;");
+        builder->newline();
+        builder->blockEnd(true);
+    }
     builder->emitIndent();
     builder->appendFormat("if (!%v->drop && %v->egress_port == 0)", compilerGlobalMetadata,
                           compilerGlobalMetadata);
     builder->newline();
     builder->increaseIndent();
     builder->emitIndent();
-    builder->appendLine("return TC_ACT_OK;");
+    builder->appendFormat("return %v;", builder->target->forwardReturnCode());
+    builder->newline();
     builder->decreaseIndent();
 
     cstring eg_port = absl::StrFormat("%v->egress_port", compilerGlobalMetadata);
@@ -642,6 +722,14 @@ void TCIngressPipelinePNA::emitLocalVariables(EBPF::CodeBuilder *builder) {
     }
 }
 
+void TCIngressPipelinePNA::emitPacketLength(EBPF::CodeBuilder *builder) {
+    if (isXdp()) {
+        builder->appendFormat("%v->data_end - %v->data", contextVar, contextVar);
+        return;
+    }
+    EBPF::TCIngressPipeline::emitPacketLength(builder);
+}
+
 // =====================EBPFPnaParser=============================
 EBPFPnaParser::EBPFPnaParser(const EBPF::EBPFProgram *program, const IR::ParserBlock *block,
                              const P4::TypeMap *typeMap)
@@ -663,7 +751,7 @@ void EBPFPnaParser::emitRejectState(EBPF::CodeBuilder *builder) {
     builder->target->emitTraceMessage(
         builder, "Parser: Explicit transition to reject state, dropping packet..");
     builder->emitIndent();
-    builder->appendFormat("return %s", builder->target->abortReturnCode().c_str());
+    builder->appendFormat("return %s", builder->target->dropReturnCode().c_str());
     builder->endOfStatement(true);
     builder->blockEnd(true);
     builder->emitIndent();
@@ -871,7 +959,8 @@ bool PnaStateTranslationVisitor::preorder(const IR::Member *m) {
         if (auto st = m->expr->type->to<IR::Type_Struct>()) {
             if (st->name == "pna_main_parser_input_metadata_t") {
                 if (m->member.name == "input_port") {
-                    builder->append("skb->ifindex");
+                    builder->append(
+                        state->parser->program->checkedTo<EBPF::EBPFPipeline>()->ifindexVar);
                     return false;
                 } else {
                     ::P4::error(ErrorType::ERR_UNSUPPORTED_ON_TARGET,
@@ -1363,7 +1452,7 @@ void IngressDeparserPNA::emitPreDeparser(EBPF::CodeBuilder *builder) {
     builder->blockStart();
     builder->target->emitTraceMessage(builder, "PreDeparser: dropping packet..");
     builder->emitIndent();
-    builder->appendFormat("return %s;\n", builder->target->abortReturnCode().c_str());
+    builder->appendFormat("return %s;\n", builder->target->dropReturnCode().c_str());
     builder->blockEnd(true);
 }
 
@@ -1397,51 +1486,57 @@ void IngressDeparserPNA::emit(EBPF::CodeBuilder *builder) {
     prepareBufferTranslator->substitute(this->headers, this->parserHeaders);
     controlBlock->container->body->apply(*prepareBufferTranslator);
 
+    // XDP has neither skb->protocol nor the skb metadata kfuncs.
+    bool isXdp = program->checkedTo<TCIngressPipelinePNA>()->isXdp();
     builder->newline();
-    builder->emitIndent();
-    builder->appendFormat("__u16 saved_proto = 0");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("bool have_saved_proto = false");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendLine("// bpf_skb_adjust_room works only when protocol is IPv4 or IPv6");
-    builder->emitIndent();
-    builder->appendLine("// 0x0800 = IPv4, 0x86dd = IPv6");
-    builder->emitIndent();
-    builder->append(
-        "if ((skb->protocol != bpf_htons(0x0800)) && (skb->protocol != bpf_htons(0x86dd))) ");
-    builder->blockStart();
-    builder->emitIndent();
-    builder->appendFormat("saved_proto = skb->protocol");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("have_saved_proto = true");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("bpf_p4tc_skb_set_protocol(skb, &sa->set, bpf_htons(0x0800))");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("bpf_p4tc_skb_meta_set(skb, &sa->set, sizeof(sa->set))");
-    builder->endOfStatement(true);
-    builder->blockEnd(true);
-    builder->emitIndent();
-    builder->endOfStatement(true);
+    if (!isXdp) {
+        builder->emitIndent();
+        builder->appendFormat("__u16 saved_proto = 0");
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat("bool have_saved_proto = false");
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendLine("// bpf_skb_adjust_room works only when protocol is IPv4 or IPv6");
+        builder->emitIndent();
+        builder->appendLine("// 0x0800 = IPv4, 0x86dd = IPv6");
+        builder->emitIndent();
+        builder->append(
+            "if ((skb->protocol != bpf_htons(0x0800)) && (skb->protocol != bpf_htons(0x86dd))) ");
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendFormat("saved_proto = skb->protocol");
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat("have_saved_proto = true");
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat("bpf_p4tc_skb_set_protocol(skb, &sa->set, bpf_htons(0x0800))");
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat("bpf_p4tc_skb_meta_set(skb, &sa->set, sizeof(sa->set))");
+        builder->endOfStatement(true);
+        builder->blockEnd(true);
+        builder->emitIndent();
+        builder->endOfStatement(true);
+    }
 
     emitBufferAdjusts(builder);
 
     builder->newline();
-    builder->emitIndent();
-    builder->append("if (have_saved_proto) ");
-    builder->blockStart();
-    builder->emitIndent();
-    builder->appendFormat("bpf_p4tc_skb_set_protocol(skb, &sa->set, saved_proto)");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("bpf_p4tc_skb_meta_set(skb, &sa->set, sizeof(sa->set))");
-    builder->endOfStatement(true);
-    builder->blockEnd(true);
-    builder->newline();
+    if (!isXdp) {
+        builder->emitIndent();
+        builder->append("if (have_saved_proto) ");
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendFormat("bpf_p4tc_skb_set_protocol(skb, &sa->set, saved_proto)");
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat("bpf_p4tc_skb_meta_set(skb, &sa->set, sizeof(sa->set))");
+        builder->endOfStatement(true);
+        builder->blockEnd(true);
+        builder->newline();
+    }
 
     builder->emitIndent();
     builder->appendFormat("%v = %v;", program->packetStartVar,
@@ -1844,7 +1939,7 @@ bool ControlBodyTranslatorPNA::preorder(const IR::Member *m) {
         if (auto st = m->expr->type->to<IR::Type_Struct>()) {
             if (st->name == "pna_main_input_metadata_t") {
                 if (m->member.name == "input_port") {
-                    builder->append("skb->ifindex");
+                    builder->append(control->program->checkedTo<EBPF::EBPFPipeline>()->ifindexVar);
                     return false;
                 } else if (m->member.name == "parser_error") {
                     builder->append("compiler_meta__->parser_error");
@@ -2258,8 +2353,11 @@ void ControlBodyTranslatorPNA::processApply(const P4::ApplyMethod *method) {
         builder->appendLine("/* perform lookup */");
         builder->target->emitTraceMessage(builder, "Control: performing table lookup");
         builder->emitIndent();
-        builder->appendLine(
-            "act_bpf = bpf_p4tc_tbl_read(skb, &params, sizeof(params), &key, sizeof(key));");
+        auto tcTarget = dynamic_cast<const EBPF::P4TCTarget *>(builder->target);
+        builder->appendFormat(
+            "act_bpf = %v(skb, &params, sizeof(params), &key, sizeof(key));",
+            tcTarget->p4tcKfunc("tbl_read"_cs));
+        builder->newline();
         builder->emitIndent();
         builder->appendFormat("value = (struct %s *)act_bpf;", table->valueTypeName.c_str());
         builder->newline();
@@ -45,6 +45,7 @@ class PNAEbpfGenerator : public EBPF::EbpfCodeGenerator {
     virtual void emitInstances(EBPF::CodeBuilder *builder) const = 0;
     virtual void emitParser(EBPF::CodeBuilder *builder) const = 0;
     virtual void emitHeader(EBPF::CodeBuilder *builder) const = 0;
+    virtual void emitXdp(EBPF::CodeBuilder *builder) const = 0;
     void emitPNAIncludes(EBPF::CodeBuilder *builder) const;
     void emitPreamble(EBPF::CodeBuilder *builder) const override;
     void emitCommonPreamble(EBPF::CodeBuilder *builder) const override;
@@ -104,6 +105,7 @@ class PNAArchTC : public PNAEbpfGenerator {
     void emit(EBPF::CodeBuilder *builder) const override;
     void emitParser(EBPF::CodeBuilder *builder) const override;
     void emitHeader(EBPF::CodeBuilder *builder) const override;
+    void emitXdp(EBPF::CodeBuilder *builder) const override;
     void emitInstances(EBPF::CodeBuilder *builder) const override;
     void emitGlobalFunctions(EBPF::CodeBuilder *builder) const;
 };
@@ -114,10 +116,18 @@ class TCIngressPipelinePNA : public EBPF::TCIngressPipeline {
                          P4::TypeMap *typeMap)
         : EBPF::TCIngressPipeline(name, options, refMap, typeMap) {}
 
+    /// The parser, control and deparser are emitted into one XDP program
+    /// (see PNAArchTC::emitXdp).
+    bool isXdp() const { return name == "xdp-ingress"; }
+    cstring dropReturnCode() override {
+        return isXdp() ? "XDP_DROP"_cs : EBPF::TCIngressPipeline::dropReturnCode();
+    }
+
     void emit(EBPF::CodeBuilder *builder) override;
     void emitLocalVariables(EBPF::CodeBuilder *builder) override;
     void emitGlobalMetadataInitializer(EBPF::CodeBuilder *builder) override;
     void emitTrafficManager(EBPF::CodeBuilder *builder) override;
+    void emitPacketLength(EBPF::CodeBuilder *builder) override;
 
     DECLARE_TYPEINFO(TCIngressPipelinePNA, EBPF::TCIngressPipeline);
 };
@@ -133,6 +143,8 @@ class PnaStateTranslationVisitor : public EBPF::PsaStateTranslationVisitor {
  protected:
     void compileExtractField(const IR::Expression *expr, const IR::StructField *field,
                              unsigned hdrOffsetBits, EBPF::EBPFType *type) override;
+    /// Fields carry TC type annotations and advance the packet offset one by one.
+    bool canUseWideLoads(const IR::Type_StructLike *) const override { return false; }
     void compileLookahead(const IR::Expression *destination) override;
     bool preorder(const IR::SelectCase *selectCase) override;
 };
@@ -32,6 +32,8 @@ class TCOptions : public CompilerOptions {
     // XDP2TC mode for PSA-eBPF
     enum XDP2TC xdp2tcMode = XDP2TC_META;
     unsigned timerProfiles = 4;
+    // also compile the pipeline to XDP when it is eligible
+    bool xdpFastPath = false;
 
     TCOptions() {
         registerOption(
@@ -76,6 +78,15 @@ class TCOptions : public CompilerOptions {
                 return true;
             },
             "Defines the number of timer profiles. Default is 4.");
+        registerOption(
+            "--xdp-fastpath", nullptr,
+            [this](const char *) {
+                xdpFastPath = true;
+                return true;
+            },
+            "If the PNA pipeline only uses the XDP subset, also generate <prog>_xdp.c, which "
+            "runs the whole pipeline in XDP. The TC programs are generated either way, and "
+            "<prog>_xdp_report.txt explains the decision.");
     }
 };
 
@@ -77,6 +77,21 @@ PARSER.add_argument(
     action='store_true',
     help=("Replace"),
 )
+PARSER.add_argument(
+    "--outputs",
+    dest="outputsDir",
+    help=(
+        "Compare against the expected outputs in this directory. Files that are not "
+        "found there are compared against the default outputs of the input."
+    ),
+)
+PARSER.add_argument(
+    "--compiler-args",
+    dest="compilerArgs",
+    action="append",
+    default=[],
+    help="Additional argument for the compiler, e.g. --compiler-args=--xdp-fastpath",
+)
 
 
 class Options(object):
@@ -94,6 +109,7 @@ class Options(object):
         self.testdir = ""
         self.runtimedir = str(FILE_DIR.joinpath("runtime"))
         self.compilerOptions = []
+        self.outputsDir: Optional[Path] = None  # expected outputs, instead of the default
 
 
 def run_model(tc: TCInfra, testfile: Optional[Path]) -> int:
@@ -184,6 +200,10 @@ def main(argv: Any) -> None:
         options.testfile = testutils.check_if_file(Path(args.testfile))
     options.testdir = tempfile.mkdtemp(dir=os.path.abspath("./"))
 
+    if args.outputsDir:
+        options.outputsDir = testutils.check_if_dir(Path(args.outputsDir))
+    options.compilerOptions = args.compilerArgs
+
     if args.cleanupTmp:
         options.cleanupTmp = False
 
@@ -31,21 +31,29 @@ TMPL+=$(OUTPUT_DIR)/$(TEMPLATE).json
 SRCS+=$(OUTPUT_DIR)/$(TEMPLATE)_parser.c
 SRCS+=$(OUTPUT_DIR)/$(TEMPLATE)_control_blocks.c
 OBJS=$(SRCS:.c=.o)
+# Only generated with --xdp-fastpath, and only for eligible programs
+XDP_SRC=$(OUTPUT_DIR)/$(TEMPLATE)_xdp.c
 
-all: $(SRCS) $(OBJS)
+all: $(SRCS) $(OBJS) xdp
 
 $(SRCS): $(P4_FILE)
 	@if ! ($(P4C) --version); then \
 		echo "*** ERROR: Cannot find p4c-ebpf"; \
 		exit 1;\
 	fi;
-	$(P4C) $(P4_FILE) -o ${OUTPUT_DIR}
+	$(P4C) $(P4ARGS) $(P4_FILE) -o ${OUTPUT_DIR}
 
 $(OBJS): %.o : %.c
 	$(CLANG) $(CFLAGS) $(INCLUDES) --target=bpf -mcpu=probe -c $< -o $@
 
+.PHONY: xdp
+xdp: $(SRCS)
+	@if [ -f $(XDP_SRC) ]; then \
+		$(CLANG) $(CFLAGS) $(INCLUDES) --target=bpf -mcpu=probe -c $(XDP_SRC) -o $(XDP_SRC:.c=.o); \
+	fi
+
 clean:
-	rm -f $(OBJS)
+	rm -f $(OBJS) $(XDP_SRC:.c=.o)
 
 realclean:
-	rm -f $(OBJS) $(SRCS) $(TMPL) $(TEMPLATE)_parser.h
+	rm -f $(OBJS) $(SRCS) $(TMPL) $(TEMPLATE)_parser.h $(XDP_SRC) $(XDP_SRC:.c=.o)
@@ -298,6 +298,8 @@ class TCInfra:
         args += f"P4_FILE={self.options.p4filename} "
         args += f"OUTPUT_DIR={self.outputdir} "
         args += f"P4C={self.compiler} CLANG={self.options.clang}"
+        if self.options.compilerOptions:
+            args += f" P4ARGS=\"{' '.join(self.options.compilerOptions)}\""
         # add the folder local to the P4 file to the list of includes
         args += f" INCLUDES+=-I{os.path.dirname(self.options.p4filename)}"
         result = testutils.exec_process(args)
@@ -363,6 +365,14 @@ class TCInfra:
                 print("Checking", file)
             produced = self.outputdir + "/" + file
             expected = expected_dirname + "/" + file
+            if self.options.outputsDir:
+                # Outputs that do not depend on the extra compiler options are shared
+                # with the default run.
+                expected = str(self.options.outputsDir) + "/" + file
+                if not os.path.isfile(expected) and os.path.isfile(
+                    expected_dirname + "/" + file
+                ):
+                    expected = expected_dirname + "/" + file
             if not os.path.isfile(expected):
                 if self.options.verbose:
                     print("Expected file does not exist; creating", expected)
@@ -0,0 +1,97 @@
+/*
+Copyright (C) 2023 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions
+and limitations under the License.
+*/
+
+#include "xdpEligibility.h"
+
+#include "frontends/p4/methodInstance.h"
+#include "lib/stringify.h"
+
+namespace P4::TC {
+
+using namespace P4::literals;
+
+void XdpEligibilityCheck::reject(const IR::Node *node, cstring message) {
+    reasons.push_back({node, message});
+}
+
+void XdpEligibilityCheck::check(const IR::ParserBlock *parser, const IR::ControlBlock *control,
+                             const IR::ControlBlock *deparser) {
+    CHECK_NULL(parser);
+    CHECK_NULL(control);
+    CHECK_NULL(deparser);
+    reasons.clear();
+    parser->container->apply(*this);
+    control->container->apply(*this);
+    deparser->container->apply(*this);
+}
+
+bool XdpEligibilityCheck::preorder(const IR::Declaration_Instance *decl) {
+    auto type = typeMap->getType(decl, true);
+    if (auto spec = type->to<IR::Type_SpecializedCanonical>()) type = spec->baseType;
+    if (auto ext = type->to<IR::Type_Extern>()) {
+        reject(decl, cstring("extern " + ext->name.name + " " + decl->externalName() +
+                             " is implemented with P4TC kfuncs that require the TC context"));
+    }
+    return false;
+}
+
+bool XdpEligibilityCheck::preorder(const IR::ConstructorCallExpression *expr) {
+    // Externs instantiated in a table property, e.g. pna_direct_counter.
+    reject(expr, cstring("extern " + expr->constructedType->toString() +
+                         " is implemented with P4TC kfuncs that require the TC context"));
+    return false;
+}
+
+bool XdpEligibilityCheck::preorder(const IR::MethodCallExpression *expr) {
+    auto mi = P4::MethodInstance::resolve(expr, refMap, typeMap);
+    if (auto ef = mi->to<P4::ExternFunction>()) {
+        auto name = ef->method->name.name;
+        if (name != "drop_packet" && name != "send_to_port" && name != "verify") {
+            reject(expr, cstring("extern function " + name + " has no XDP equivalent"));
+        }
+    }
+    return true;
+}
+
+bool XdpEligibilityCheck::preorder(const IR::Member *member) {
+    auto type = typeMap->getType(member->expr);
+    if (auto st = type ? type->to<IR::Type_Struct>() : nullptr) {
+        if (st->name == "pna_main_output_metadata_t") {
+            reject(member, cstring("output metadata field " + member->member.name +
+                                   " is carried in the skb and is not available to XDP"));
+            return false;
+        }
+    }
+    return true;
+}
+
+void XdpEligibilityCheck::report(std::ostream &out, cstring progName) const {
+    if (eligible()) {
+        out << progName << ": eligible for the XDP fast path, see " << progName << "_xdp.c"
+            << std::endl;
+        return;
+    }
+    out << progName << ": not eligible for the XDP fast path, falling back to TC; "
+        << reasons.size() << (reasons.size() == 1 ? " construct needs" : " constructs need")
+        << " the TC hook" << std::endl;
+    for (const auto &r : reasons) {
+        out << "  ";
+        if (r.node->srcInfo.isValid()) out << r.node->srcInfo.toPositionString() << ": ";
+        out << r.message << std::endl;
+    }
+}
+
+}  // namespace P4::TC
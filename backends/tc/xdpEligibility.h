@@ -0,0 +1,73 @@
+/*
+Copyright (C) 2023 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions
+and limitations under the License.
+*/
+
+#ifndef BACKENDS_TC_XDPELIGIBILITY_H_
+#define BACKENDS_TC_XDPELIGIBILITY_H_
+
+#include <ostream>
+#include <vector>
+
+#include "frontends/p4/typeMap.h"
+#include "ir/ir.h"
+#include "ir/visitor.h"
+
+namespace P4::TC {
+
+/// Decides whether the PNA main parser, control and deparser can be compiled into a native
+/// XDP program (PNAArchTC::emitXdp). The eligible subset is headers, actions, tables without
+/// direct externs or entry management, and the drop_packet, send_to_port and verify extern
+/// functions. Table lookups have an XDP kfunc; externs, skb metadata and recirculation
+/// need the TC hook. Each construct outside the subset is recorded with its source
+/// position for the report.
+class XdpEligibilityCheck : public Inspector {
+ public:
+    struct Reason {
+        const IR::Node *node;
+        cstring message;
+    };
+
+ private:
+    P4::ReferenceMap *refMap;
+    P4::TypeMap *typeMap;
+    std::vector<Reason> reasons;
+
+    void reject(const IR::Node *node, cstring message);
+
+ public:
+    XdpEligibilityCheck(P4::ReferenceMap *refMap, P4::TypeMap *typeMap)
+        : refMap(refMap), typeMap(typeMap) {
+        setName("XdpEligibilityCheck");
+    }
+
+    /// Checks the blocks that make up the PNA_NIC pipeline.
+    void check(const IR::ParserBlock *parser, const IR::ControlBlock *control,
+               const IR::ControlBlock *deparser);
+
+    bool eligible() const { return reasons.empty(); }
+    const std::vector<Reason> &getReasons() const { return reasons; }
+
+    /// Writes a human-readable summary of the decision.
+    void report(std::ostream &out, cstring progName) const;
+
+    bool preorder(const IR::Declaration_Instance *decl) override;
+    bool preorder(const IR::ConstructorCallExpression *expr) override;
+    bool preorder(const IR::MethodCallExpression *expr) override;
+    bool preorder(const IR::Member *member) override;
+};
+
+}  // namespace P4::TC
+
+#endif /* BACKENDS_TC_XDPELIGIBILITY_H_ */
@@ -15,5 +15,5 @@ if (CPACK_GENERATOR MATCHES "DEB")
     set (CPACK_DEBIAN_PACKAGE_ARCHITECTURE "i386")
   endif()
 
-  set (CPACK_DEBIAN_PACKAGE_DEPENDS "cpp (>= 4.8), libboost-iostreams1.58.0, libgmp10, libgmpxx4ldbl, libgc1c2, libstdc++6, libc6, libbz2-1.0, libssl1.0.0, python (>= 2.7)")
+  set (CPACK_DEBIAN_PACKAGE_DEPENDS "cpp (>= 4.8), libgmp10, libgmpxx4ldbl, libgc1c2, libstdc++6, libc6, libbz2-1.0, libssl1.0.0, python (>= 2.7)")
 endif()
@@ -34,6 +34,7 @@
 #include "misc.h"
 #include "parser-tofino-jbay.h"
 #include "sections.h"
+#include "stage_cache.h"
 #include "top_level.h"
 
 #define MAJOR_VERSION 1
@@ -66,6 +67,8 @@ option_t options = {
     .num_stages_override = 0,
     .tof1_egr_parse_depth_checks_disabled = false,
     .fill_noop_slot = nullptr,
+    .jobs = 0,
+    .stage_cache = "",
 };
 
 std::string asmfile_name;                       // NOLINT(runtime/string)
@@ -106,6 +109,21 @@ void createSingleAsmParser() {
     asm_parser = new AsmParser;
 }
 
+/* The register trees are written to their files in many small pieces, so give the output
+ * files a bigger buffer than the default one.  The buffer must outlive the flush done when the
+ * file is closed, hence the explicit close. */
+class output_file : public std::ofstream {
+    static constexpr size_t buffer_size = 256 * 1024;
+    std::unique_ptr<char[]> buffer;
+
+ public:
+    explicit output_file(const char *name) : buffer(new char[buffer_size]) {
+        rdbuf()->pubsetbuf(buffer.get(), buffer_size);
+        open(name);
+    }
+    ~output_file() { close(); }
+};
+
 std::unique_ptr<std::ostream> open_output(const char *name, ...) {
     char namebuf[1024], *p = namebuf, *end = namebuf + sizeof(namebuf);
     va_list args;
@@ -117,7 +135,7 @@ std::unique_ptr<std::ostream> open_output(const char *name, ...) {
         std::cerr << "File name too long: " << namebuf << "..." << std::endl;
         snprintf(namebuf, sizeof(namebuf), "/dev/null");
     }
-    auto rv = std::unique_ptr<std::ostream>(new std::ofstream(namebuf));
+    auto rv = std::unique_ptr<std::ostream>(new output_file(namebuf));
     if (!*rv) {
         std::cerr << "Failed to open " << namebuf << " for writing: " << strerror(errno)
                   << std::endl;
@@ -167,6 +185,7 @@ void output_all() {
 
     Section::output_all(ctxtJson);
     TopLevel::output_all(ctxtJson);
+    if (StageCache::enabled()) StageCache::save();
 
     json::map driver_options;
     driver_options["hash_parity_enabled"] = !options.disable_gfm_parity;
@@ -282,6 +301,20 @@ int run(int ac, char **av) {
                 break;
             }
             options.stage_dependency_pattern = av[i];
+        } else if (!strcmp(av[i], "--stage-cache")) {
+            ++i;
+            if (!av[i]) {
+                std::cerr << "No stage cache directory specified '--stage-cache <dir>'"
+                          << std::endl;
+                error_count++;
+                break;
+            }
+            if (stat(av[i], &st) ? mkdir(av[i], 0777) < 0 : !S_ISDIR(st.st_mode)) {
+                std::cerr << "Can't use " << av[i] << " as stage cache dir" << std::endl;
+                error_count++;
+            } else {
+                options.stage_cache = av[i];
+            }
         } else if (!strcmp(av[i], "--noop-fill-instruction")) {
             ++i;
             if (!av[i] || !valid_noop_fill.count(av[i])) {
@@ -300,6 +333,8 @@ int run(int ac, char **av) {
             unique_table_offset = val;
         } else if (sscanf(av[i], "--num-stages-override%d", &val) > 0 && val >= 0) {
             options.num_stages_override = val;
+        } else if (sscanf(av[i], "--jobs%d", &val) > 0 && val >= 0) {
+            options.jobs = val;
         } else if (!strcmp(av[i], "--target")) {
             ++i;
             if (!av[i]) {
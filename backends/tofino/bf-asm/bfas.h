@@ -74,6 +74,8 @@ extern struct option_t {
     int num_stages_override;
     bool tof1_egr_parse_depth_checks_disabled;
     const char *fill_noop_slot;
+    int jobs;  // threads writing the output files, 0 for one per core
+    std::string stage_cache;  // directory of the stage output cache, empty for none
 } options;
 
 extern unsigned unique_action_handle;
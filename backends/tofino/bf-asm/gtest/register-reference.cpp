@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the
+ * License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied.  See the License for the specific language governing permissions
+ * and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-asm/register_reference.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+void print_regname(std::ostream &, const void *, const void *);
+
+namespace {
+
+struct test_regs {
+    mutable int emitted = 0;
+    void emit_binary(std::ostream &out, uint64_t a) const {
+        ++emitted;
+        out << "regs@" << a << ';';
+    }
+};
+
+TEST(register_reference, emit_binary) {
+    test_regs regs;
+    register_reference<test_regs> ref;
+    std::ostringstream empty;
+    ref.emit_binary(empty, 0x100);
+    EXPECT_EQ(empty.str(), "");
+
+    ref.set("regs", &regs);
+    std::ostringstream out;
+    ref.emit_binary(out, 0x100);
+    EXPECT_EQ(out.str(), "regs@256;");
+    EXPECT_TRUE(ref.read);
+}
+
+TEST(register_reference, binary_cache) {
+    test_regs regs;
+    register_reference<test_regs> ref;
+    binary_output_cache cache;
+    cache[0x200] = std::string("cached\0", 7);
+    ref.set("regs", &regs).set_binary_cache(&cache);
+
+    // the cached binary replaces the tree at its address
+    std::ostringstream out;
+    ref.emit_binary(out, 0x200);
+    EXPECT_EQ(out.str(), std::string("cached\0", 7));
+    EXPECT_EQ(regs.emitted, 0);
+
+    // the tree is dumped once at any other address and its binary saved
+    ref.emit_binary(out, 0x100);
+    ref.emit_binary(out, 0x100);
+    EXPECT_EQ(regs.emitted, 1);
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_EQ(cache[0x100], "regs@256;");
+    EXPECT_EQ(out.str(), std::string("cached\0", 7) + "regs@256;regs@256;");
+}
+
+}  // namespace
@@ -0,0 +1,157 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the
+ * License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied.  See the License for the specific language governing permissions
+ * and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-asm/stage_cache.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "backends/tofino/bf-asm/bfas.h"
+#include "backends/tofino/bf-asm/stage.h"
+
+namespace {
+
+value_t str_value(const char *s, int lineno) {
+    value_t v;
+    memset(&v, 0, sizeof(v));
+    v.type = tSTR;
+    v.lineno = lineno;
+    v.s = const_cast<char *>(s);
+    return v;
+}
+
+value_t int_value(int64_t i, int lineno) {
+    value_t v;
+    memset(&v, 0, sizeof(v));
+    v.type = tINT;
+    v.lineno = lineno;
+    v.i = i;
+    return v;
+}
+
+class StageCacheTest : public ::testing::Test {
+ protected:
+    std::filesystem::path dir;
+    std::string saved_stage_cache;
+    int saved_error_count = 0;
+
+    void SetUp() override {
+        if (options.target == NO_TARGET) asm_parse_string("version:\n  target: Tofino2\n");
+        dir = std::filesystem::temp_directory_path() /
+              ("stage_cache_" +
+               std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        saved_stage_cache = options.stage_cache;
+        options.stage_cache = dir.string();
+        // Nothing is saved after an error, other tests check error messages
+        saved_error_count = error_count;
+        error_count = 0;
+        StageCache::test_clear();
+    }
+    void TearDown() override {
+        StageCache::test_clear();
+        options.stage_cache = saved_stage_cache;
+        error_count += saved_error_count;
+        std::filesystem::remove_all(dir);
+    }
+
+    /// Feeds the sections of a run, the stage 3 section depends on @p dependency. The line
+    /// numbers move with @p lineno, as they do when an unrelated part of the .bfa changes.
+    void input(const char *dependency, int lineno = 1) {
+        VECTOR(value_t) args;
+        VECTOR_init(args);
+        value_t global = str_value("W0", lineno);
+        StageCache::input("phv", args, global);
+        VECTOR_init2(args, int_value(3, lineno), str_value("ingress", lineno));
+        value_t data;
+        memset(&data, 0, sizeof(data));
+        data.type = tMAP;
+        data.lineno = lineno;
+        data.map.push_back("dependency", str_value(dependency, lineno + 1));
+        StageCache::input("stage", args, data);
+        VECTOR_fini(data.map);
+        VECTOR_fini(args);
+    }
+
+    /// Runs the lookup of stage 3 and, if it was not found, saves @p json and @p binary
+    /// as its outputs.
+    StageCache::Entry *run(const char *dependency, int lineno = 1) {
+        StageCache::test_clear();
+        input(dependency, lineno);
+        Stage stage(3, false);
+        auto *entry = StageCache::lookup(stage, false);
+        if (!entry->have_json) {
+            entry->json = "{ \"stage\" : 3 }";
+            entry->binary[0x100] = std::string("regs\0", 5);
+        }
+        return entry;
+    }
+};
+
+TEST_F(StageCacheTest, hit_when_unchanged) {
+    auto *first = run("match");
+    EXPECT_FALSE(first->have_json);
+    EXPECT_EQ(first->have_binary, 0U);
+    StageCache::save();
+
+    auto *second = run("match", 10);
+    EXPECT_EQ(second->name, first->name);
+    EXPECT_TRUE(second->have_json);
+    EXPECT_EQ(second->json, "{ \"stage\" : 3 }");
+    EXPECT_EQ(second->have_binary, 1U);
+    EXPECT_EQ(second->binary[0x100], std::string("regs\0", 5));
+}
+
+TEST_F(StageCacheTest, miss_when_stage_changes) {
+    auto *first = run("match");
+    StageCache::save();
+
+    auto *second = run("action");
+    EXPECT_NE(second->name, first->name);
+    EXPECT_FALSE(second->have_json);
+    EXPECT_EQ(second->have_binary, 0U);
+}
+
+TEST_F(StageCacheTest, miss_when_option_changes) {
+    auto *first = run("match");
+    StageCache::save();
+
+    bool disable_long_branch = options.disable_long_branch;
+    options.disable_long_branch = !disable_long_branch;
+    auto *second = run("match");
+    options.disable_long_branch = disable_long_branch;
+    EXPECT_NE(second->name, first->name);
+    EXPECT_FALSE(second->have_json);
+}
+
+TEST_F(StageCacheTest, miss_when_key_file_differs) {
+    auto *first = run("match");
+    StageCache::save();
+
+    // Another key with the same hash, the entry must not be used
+    std::ofstream(dir / (first->name + ".key")) << "some other key";
+    auto *second = run("match");
+    EXPECT_EQ(second->name, first->name);
+    EXPECT_FALSE(second->have_json);
+    EXPECT_EQ(second->have_binary, 0U);
+}
+
+}  // namespace
@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the
+ * License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied.  See the License for the specific language governing permissions
+ * and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "parallel_output.h"
+
+#ifdef MULTITHREAD
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#endif
+
+#include "backends/tofino/bf-p4c/lib/parallel_for.h"
+#include "bfas.h"
+#include "lib/exceptions.h"
+
+#ifdef MULTITHREAD
+namespace {
+
+struct OutputJobs {
+    const std::vector<std::function<void()>> &jobs;
+    std::vector<std::exception_ptr> exceptions;
+    std::atomic<size_t> next{0};
+};
+
+/* Each worker takes the next job not started yet, so one big stage does not hold up the
+ * small ones queued behind it. */
+void run_jobs(OutputJobs *run) {
+    for (size_t i; (i = run->next++) < run->jobs.size();) {
+        try {
+            run->jobs[i]();
+        } catch (...) {
+            run->exceptions[i] = std::current_exception();
+        }
+    }
+}
+
+}  // namespace
+#endif
+
+void run_output_jobs(const std::vector<std::function<void()>> &jobs) {
+#ifdef MULTITHREAD
+    size_t threads = options.jobs > 0 ? options.jobs : std::thread::hardware_concurrency();
+    threads = std::min(threads, jobs.size());
+    if (threads > 1) {
+        OutputJobs run{jobs, std::vector<std::exception_ptr>(jobs.size())};
+        // The calling thread is one of the workers.
+        std::function<void()> worker = [&run] { run_jobs(&run); };
+        std::vector<pthread_t> workers;
+        for (size_t i = 1; i < threads; i++) workers.push_back(BFN::start_gc_thread(worker));
+        run_jobs(&run);
+        for (auto tid : workers) pthread_join(tid, NULL);
+        for (auto &e : run.exceptions)
+            if (e) std::rethrow_exception(e);
+        return;
+    }
+#endif
+    for (auto &job : jobs) job();
+}
@@ -0,0 +1,33 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the
+ * License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied.  See the License for the specific language governing permissions
+ * and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef BACKENDS_TOFINO_BF_ASM_PARALLEL_OUTPUT_H_
+#define BACKENDS_TOFINO_BF_ASM_PARALLEL_OUTPUT_H_
+
+#include <functional>
+#include <vector>
+
+/* Run the output jobs -- each writing one register tree to one stream -- on up to
+ * options.jobs threads when bfas is built with MULTITHREAD, and one after another otherwise.
+ * A job must only touch its own register tree and its own stream (reading a register marks
+ * it as read, so two jobs may not even read the same tree), and must not report errors.
+ * The jobs are all complete on return; if any of them threw, the exception of the first
+ * one in the list is rethrown. */
+void run_output_jobs(const std::vector<std::function<void()>> &jobs);
+
+#endif /* BACKENDS_TOFINO_BF_ASM_PARALLEL_OUTPUT_H_ */
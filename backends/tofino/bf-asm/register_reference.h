@@ -18,8 +18,12 @@
 #ifndef BACKENDS_TOFINO_BF_ASM_REGISTER_REFERENCE_H_
 #define BACKENDS_TOFINO_BF_ASM_REGISTER_REFERENCE_H_
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
 
 #include "lib/log.h"
 
@@ -39,15 +43,21 @@ inline std::ostream &operator<<(std::ostream &out, const prefix *p) {
     return out;
 }
 
+/* binary of a register tree by the address it was dumped at, see register_reference */
+using binary_output_cache = std::map<uint64_t, std::string>;
+
 /* Class to link register trees together into a larger dag that will expand into a tree
  * when dumped as binary (so trees that appear in mulitple places will be duplicated)
  * 'name' is the json file name to use when dumping as cfg.json, and the name for logging
  * 'tree' is the subtree to dump as binary at the appropriate offset
+ * 'binary_cache', if set, holds binary to dump in place of the tree at given addresses, and
+ * gets the binary of the tree added for any other address it is dumped at
  */
 template <class REG>
 class register_reference {
     REG *tree = nullptr;
     std::string name;
+    binary_output_cache *binary_cache = nullptr;
 
  public:
     mutable bool read = false, write = false, disabled_ = false;
@@ -73,6 +83,25 @@ class register_reference {
         return tree;
     }
     explicit operator bool() const { return tree != nullptr; }
+    void set_binary_cache(binary_output_cache *cache) { binary_cache = cache; }
+    void emit_binary(std::ostream &out, uint64_t a) const {
+        if (binary_cache) {
+            auto it = binary_cache->find(a);
+            if (it != binary_cache->end()) {
+                out << it->second;
+                return;
+            }
+        }
+        if (!tree) return;
+        read = true;
+        if (!binary_cache) {
+            tree->emit_binary(out, a);
+            return;
+        }
+        std::ostringstream binary;
+        tree->emit_binary(binary, a);
+        out << ((*binary_cache)[a] = binary.str());
+    }
     bool modified() const { return write; }
     void set_modified(bool v = true) { write = v; }
     void rewrite() { write = false; }
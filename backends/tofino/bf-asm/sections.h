@@ -26,6 +26,7 @@
 #include "backends/tofino/bf-asm/json.h"
 #include "bfas.h"
 #include "map.h"
+#include "stage_cache.h"
 
 /// A Section represents a top level section in assembly
 /// Current sections include:
@@ -70,7 +71,10 @@ class Section : virtual public Parsable, virtual public Contextable {
         }
     }
     static void asm_section(char *name, VECTOR(value_t) args, value_t data) {
-        if (Section *sec = get(name)) sec->input(args, data);
+        if (Section *sec = get(name)) {
+            if (StageCache::enabled()) StageCache::input(name, args, data);
+            sec->input(args, data);
+        }
     }
     static void process_all() {
         if (sections)
@@ -20,6 +20,7 @@
 #include <time.h>
 
 #include <fstream>
+#include <sstream>
 
 #include "backends/tofino/bf-asm/config.h"
 #include "backends/tofino/bf-asm/target.h"
@@ -27,9 +28,11 @@
 #include "input_xbar.h"
 #include "lib/range.h"
 #include "misc.h"
+#include "parallel_output.h"
 #include "parser.h"
 #include "phv.h"
 #include "sections.h"
+#include "stage_cache.h"
 #include "top_level.h"
 
 extern std::string asmfile_name;
@@ -372,7 +375,12 @@ void AsmStage::output(json::map &ctxt_json) {
     // Re-propagate group_table_use to account for any stages that may now be match dependent.
     propagate_group_table_use();
 
-    for (auto &stage : pipe) SWITCH_FOREACH_TARGET(options.target, stage.output<TARGET>(ctxt_json);)
+    // The register trees of the stages are separate, so their cfg.json files can be written
+    // concurrently once every stage is complete.
+    std::vector<std::function<void()>> json_jobs;
+    for (auto &stage : pipe)
+        SWITCH_FOREACH_TARGET(options.target, stage.output<TARGET>(ctxt_json, json_jobs);)
+    run_output_jobs(json_jobs);
 
     if (options.log_hashes) {
         std::ofstream hash_out;
@@ -692,9 +700,11 @@ void Stage::fixup_regs(REGS &regs) {
 }
 
 template <class TARGET>
-void Stage::output(json::map &ctxt_json, bool egress_only) {
+void Stage::output(json::map &ctxt_json, std::vector<std::function<void()>> &json_jobs,
+                   bool egress_only) {
     auto *regs = new typename TARGET::mau_regs();
     declare_registers(regs, egress_only, stageno);
+    auto *cached = StageCache::enabled() ? StageCache::lookup(*this, egress_only) : nullptr;
     json::vector &ctxt_tables = ctxt_json["tables"];
     for (auto table : tables) {
         table->write_regs(*regs);
@@ -712,10 +722,25 @@ void Stage::output(json::map &ctxt_json, bool egress_only) {
     char buf[64];
     snprintf(buf, sizeof(buf), "regs.match_action_stage%s.%02x", egress_only ? ".egress" : "",
              stageno);
-    if (error_count == 0 && options.gen_json)
-        regs->emit_json(*open_output("%s.cfg.json", buf), stageno);
+    if (error_count == 0 && options.gen_json) {
+        json_jobs.push_back([regs, cached, name = std::string(buf), stageno = stageno]() {
+            auto out = open_output("%s.cfg.json", name.c_str());
+            if (!cached) {
+                regs->emit_json(*out, stageno);
+                return;
+            }
+            if (!cached->have_json) {
+                std::ostringstream json;
+                regs->emit_json(json, stageno);
+                cached->json = json.str();
+            }
+            *out << cached->json;
+        });
+    }
     auto NUM_STAGES = egress_only ? Target::NUM_EGRESS_STAGES() : Target::NUM_MAU_STAGES();
-    if (stageno < NUM_STAGES) TopLevel::all->set_mau_stage(stageno, buf, regs, egress_only);
+    if (stageno < NUM_STAGES)
+        TopLevel::all->set_mau_stage(stageno, buf, regs, egress_only,
+                                     cached ? &cached->binary : nullptr);
     gen_mau_stage_characteristics(*regs, ctxt_json["mau_stage_characteristics"]);
     gen_configuration_cache(*regs, ctxt_json["configuration_cache"]);
     if (stageno == NUM_STAGES - 1 && Target::OUTPUT_STAGE_EXTENSION())
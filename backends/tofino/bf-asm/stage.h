@@ -19,6 +19,7 @@
 #define BACKENDS_TOFINO_BF_ASM_STAGE_H_
 
 #include <fstream>
+#include <functional>
 #include <vector>
 
 #include "alloc.h"
@@ -129,8 +130,11 @@ class Stage : public Stage_data {
     Stage(const Stage &) = delete;
     Stage(Stage &&);
     ~Stage();
+    /// Writes the registers of the stage and adds it to @p ctxt_json.  Writing the cfg.json
+    /// file of the registers is added to @p json_jobs, to be run once all stages are done.
     template <class TARGET>
-    void output(json::map &ctxt_json, bool egress_only = false);
+    void output(json::map &ctxt_json, std::vector<std::function<void()>> &json_jobs,
+                bool egress_only = false);
     template <class REGS>
     void fixup_regs(REGS &regs);
     template <class REGS>
@@ -0,0 +1,251 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the
+ * License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied.  See the License for the specific language governing permissions
+ * and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "stage_cache.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "backends/tofino/bf-p4c/git_sha_version.h"  // for BF_P4C_GIT_SHA
+#include "backends/tofino/bf-p4c/version.h"
+#include "binary_output.h"
+#include "deparser.h"
+#include "lib/exceptions.h"
+#include "lib/hash.h"
+#include "lib/log.h"
+#include "lib/range.h"
+#include "phv.h"
+#include "stage.h"
+#include "version.h"
+
+namespace {
+
+std::string global_input;                // NOLINT(runtime/string)
+std::string global_key_text;             // NOLINT(runtime/string)
+std::map<int, std::string> stage_input;  // by stage number
+std::vector<std::unique_ptr<StageCache::Entry>> entries;
+
+/* Writes a value in a form that differs for any two values that differ in something other
+ * than their line numbers */
+void write_value(std::ostream &out, const value_t &v) {
+    switch (v.type) {
+        case tINT:
+            out << 'i' << v.i;
+            break;
+        case tBIGINT:
+            out << 'b' << v.bigi.size;
+            for (int i = 0; i < v.bigi.size; ++i) out << ':' << uint64_t(v.bigi.data[i]);
+            break;
+        case tRANGE:
+            out << 'r' << v.range.lo << ':' << v.range.hi;
+            break;
+        case tSTR:
+            out << 's' << strlen(v.s) << ':' << v.s;
+            break;
+        case tMATCH:
+            out << 'm' << v.m.word0 << ':' << v.m.word1;
+            break;
+        case tBIGMATCH:
+            out << 'M' << v.bigm.size;
+            for (int i = 0; i < v.bigm.size; ++i)
+                out << ':' << v.bigm.data[i].word0 << ':' << v.bigm.data[i].word1;
+            break;
+        case tVEC:
+        case tCMD:
+            out << (v.type == tVEC ? 'v' : 'c') << v.vec.size << '[';
+            for (int i = 0; i < v.vec.size; ++i) write_value(out, v.vec.data[i]);
+            out << ']';
+            break;
+        case tMAP:
+            out << 'p' << v.map.size << '{';
+            for (int i = 0; i < v.map.size; ++i) {
+                write_value(out, v.map.data[i].key);
+                write_value(out, v.map.data[i].value);
+            }
+            out << '}';
+            break;
+        default:
+            BUG("unknown value type %d", v.type);
+    }
+}
+
+/* The part of the key shared by all the stages.  It is built when the first stage is
+ * output, once everything it covers has been computed. */
+const std::string &global_key() {
+    if (!global_key_text.empty()) return global_key_text;
+    std::ostringstream out;
+    out << "bfas " << BFASM::Version::getVersion() << ' ' << BF_P4C_VERSION << ' '
+        << BF_P4C_GIT_SHA << '\n';
+    out << "target " << options.target << ' ' << AsmStage::numstages() << '\n';
+    out << "options " << options.condense_json << options.disable_gfm_parity
+        << options.disable_long_branch << options.disable_power_gating
+        << options.high_availability_enabled << options.match_compiler << options.singlewrite
+        << options.tof2lab44_workaround << ' ' << options.version << ' '
+        << options.num_stages_override << ' ' << unique_table_offset << ' '
+        << (options.fill_noop_slot ? options.fill_noop_slot : "-") << '\n';
+    out << global_input;
+    for (gress_t gress : Range(INGRESS, GHOST)) out << "phv " << Phv::use(gress) << '\n';
+    for (gress_t gress : Range(INGRESS, EGRESS))
+        out << "deparser " << Deparser::PhvUse(gress) << '\n';
+    for (auto &t : Stage::teop)
+        out << "teop " << t.first << ' ' << t.second.first << ' ' << t.second.second << '\n';
+    for (auto &stage : AsmStage::stages(INGRESS)) {
+        out << "stage " << stage.stageno;
+        for (gress_t gress : Range(INGRESS, EGRESS)) {
+            out << ' ' << stage.stage_dep[gress] << ' ' << stage.table_use[gress] << ' '
+                << stage.group_table_use[gress] << ' ' << stage.pipelength(gress) << ' '
+                << stage.pred_cycle(gress) << ' ' << stage.tcam_delay(gress) << ' '
+                << stage.adr_dist_delay(gress);
+        }
+        for (gress_t gress : Range(INGRESS, GHOST)) {
+            out << ' ' << stage.long_branch_thread[gress] << ' '
+                << stage.mpr_bus_dep_glob_exec[gress] << ' '
+                << stage.mpr_bus_dep_long_branch[gress];
+        }
+        out << ' ' << stage.long_branch_terminate << ' ' << stage.mpr_always_run << '\n';
+    }
+    if (Table::all) {
+        for (auto &tbl : *Table::all) {
+            out << "table " << tbl.first << ' ' << tbl.second->gress << ' '
+                << (tbl.second->stage ? tbl.second->stage->stageno : -1) << ' '
+                << tbl.second->logical_id << '\n';
+        }
+    }
+    global_key_text = out.str();
+    return global_key_text;
+}
+
+bool read_file(const std::string &name, std::string &data) {
+    std::ifstream in(name, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    data = buf.str();
+    return true;
+}
+
+/* Files are written under a temporary name and renamed, so concurrent runs sharing the
+ * cache directory never see a partial file */
+void write_file(const std::string &name, const std::string &data) {
+    std::string tmp = name + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        out << data;
+        if (out.flush() && std::rename(tmp.c_str(), name.c_str()) == 0) return;
+    }
+    std::cerr << "Can't write " << name << " to the stage cache: " << strerror(errno)
+              << std::endl;
+    std::remove(tmp.c_str());
+}
+
+uint64_t get_byte8(const std::string &data, size_t at) {
+    uint64_t rv = 0;
+    for (int i = 7; i >= 0; --i) rv = (rv << 8) | uint8_t(data[at + i]);
+    return rv;
+}
+
+/* The binary of an entry is a sequence of records: the address and size of the binary of
+ * the registers, 8 bytes each, followed by the binary itself */
+void read_binary(const std::string &data, binary_output_cache &binary) {
+    for (size_t at = 0; at + 16 <= data.size();) {
+        uint64_t addr = get_byte8(data, at), size = get_byte8(data, at + 8);
+        at += 16;
+        if (size > data.size() - at) break;
+        binary[addr] = data.substr(at, size);
+        at += size;
+    }
+}
+
+}  // namespace
+
+void StageCache::input(const char *section, VECTOR(value_t) args, const value_t &data) {
+    // Sections that only go into the context.json or the parser and deparser registers
+    static const std::set<std::string> not_in_key = {"parser", "deparser", "primitives"};
+    std::ostringstream out;
+    out << section;
+    for (auto &arg : args) {
+        out << ' ';
+        write_value(out, arg);
+    }
+    out << '\n';
+    write_value(out, data);
+    out << '\n';
+    if (!strcmp(section, "stage")) {
+        if (args.size > 0 && args[0].type == tINT) stage_input[args[0].i] += out.str();
+    } else if (!not_in_key.count(section)) {
+        global_input += out.str();
+    }
+}
+
+StageCache::Entry *StageCache::lookup(const Stage &stage, bool egress_only) {
+    auto *entry = new Entry;
+    entries.emplace_back(entry);
+    entry->key = global_key();
+    entry->key += "stage " + std::to_string(stage.stageno) + (egress_only ? " egress\n" : "\n");
+    if (stage_input.count(stage.stageno)) entry->key += stage_input.at(stage.stageno);
+    char name[32];
+    snprintf(name, sizeof(name), "%016" PRIx64,
+             P4::Util::hash(entry->key.data(), entry->key.size()));
+    entry->name = name;
+
+    std::string path = options.stage_cache + "/" + entry->name, key, binary;
+    if (read_file(path + ".key", key) && key == entry->key) {
+        entry->have_json = read_file(path + ".cfg.json", entry->json);
+        if (read_file(path + ".bin", binary)) read_binary(binary, entry->binary);
+        entry->have_binary = entry->binary.size();
+        LOG1("stage " << stage.stageno << " found in the stage cache as " << entry->name);
+    } else {
+        LOG1("stage " << stage.stageno << " not in the stage cache");
+    }
+    return entry;
+}
+
+void StageCache::save() {
+    if (error_count > 0) return;
+    for (auto &entry : entries) {
+        std::string path = options.stage_cache + "/" + entry->name;
+        bool found = entry->have_json || entry->have_binary;
+        if (!entry->have_json && !entry->json.empty()) write_file(path + ".cfg.json", entry->json);
+        if (entry->binary.size() > entry->have_binary) {
+            std::ostringstream binary;
+            for (auto &bin : entry->binary)
+                binary << binout::byte8(bin.first) << binout::byte8(bin.second.size())
+                       << bin.second;
+            write_file(path + ".bin", binary.str());
+        }
+        // The key goes last, an entry is not used before it is there.
+        if (!found) write_file(path + ".key", entry->key);
+    }
+    entries.clear();
+}
+
+void StageCache::test_clear() {
+    global_input.clear();
+    global_key_text.clear();
+    stage_input.clear();
+    entries.clear();
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the
+ * License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied.  See the License for the specific language governing permissions
+ * and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BACKENDS_TOFINO_BF_ASM_STAGE_CACHE_H_
+#define BACKENDS_TOFINO_BF_ASM_STAGE_CACHE_H_
+
+#include <string>
+
+#include "asm-types.h"
+#include "bfas.h"
+#include "register_reference.h"
+
+class Stage;
+
+/* The register output of MAU stages from earlier runs, kept in the --stage-cache directory.
+ * A stage is looked up by its key, which is the text of
+ *  - the stage sections of that stage,
+ *  - every other section except the parser, deparser and primitives ones,
+ *  - the assembler version, the target and the options that change the registers, and
+ *  - the state derived from other stages that the registers of the stage depend on: stage
+ *    dependencies and latencies, long branches, phv use, teop buses and the stage and
+ *    logical id of every table.
+ * An entry holds the cfg.json file of the stage and the binary of its registers at each
+ * address it has been output at, which are written out in place of the registers when the
+ * key matches.  The registers themselves are still computed for every stage, as the
+ * context.json is generated along with them.  Entries are named by a hash of their key but
+ * only used when the whole key matches, so a hash collision just misses. */
+class StageCache {
+ public:
+    struct Entry {
+        std::string key, name;
+        std::string json;  // contents of the cfg.json file, empty if not known yet
+        binary_output_cache binary;
+        bool have_json = false;
+        size_t have_binary = 0;
+    };
+
+    static bool enabled() { return !options.stage_cache.empty(); }
+    /// Adds a section of the input to the keys of the stages, called before it is parsed
+    static void input(const char *section, VECTOR(value_t) args, const value_t &data);
+    /// @returns the entry of @p stage, with the outputs found in the cache directory
+    static Entry *lookup(const Stage &stage, bool egress_only);
+    /// Writes the outputs of the entries that were not in the cache directory yet
+    static void save();
+
+    // for gtest
+    static void test_clear();
+};
+
+#endif /* BACKENDS_TOFINO_BF_ASM_STAGE_CACHE_H_ */
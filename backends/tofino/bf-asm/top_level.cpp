@@ -17,9 +17,12 @@
 
 #include "top_level.h"
 
+#include <sstream>
+
 #include "bfas.h"
 #include "binary_output.h"
 #include "bson.h"
+#include "parallel_output.h"
 #include "version.h"
 
 TopLevel *TopLevel::all = nullptr;
@@ -82,10 +85,13 @@ void TopLevelRegs<TARGET>::output(json::map &ctxt_json) {
     }
     if (error_count == 0) {
         if (options.gen_json) {
-            this->mem_top.emit_json(*open_output("memories.top.cfg.json"));
-            this->mem_pipe.emit_json(*open_output("memories.pipe.cfg.json"));
-            this->reg_top.emit_json(*open_output("regs.top.cfg.json"));
-            this->reg_pipe.emit_json(*open_output("regs.pipe.cfg.json"));
+            // Each tree only names the trees it references, so the files are independent.
+            run_output_jobs({
+                [this]() { this->mem_top.emit_json(*open_output("memories.top.cfg.json")); },
+                [this]() { this->mem_pipe.emit_json(*open_output("memories.pipe.cfg.json")); },
+                [this]() { this->reg_top.emit_json(*open_output("regs.top.cfg.json")); },
+                [this]() { this->reg_pipe.emit_json(*open_output("regs.pipe.cfg.json")); },
+            });
         }
         if (options.binary != NO_BINARY) {
             auto binfile = open_output("%s.bin", TARGET::name);
@@ -100,13 +106,17 @@ void TopLevelRegs<TARGET>::output(json::map &ctxt_json) {
             header["target"] = Target::name();
             header["stages"] = Target::NUM_MAU_STAGES();
             *binfile << binout::tag('H') << json::binary(header);
+            // The memories are streamed to the file while the registers, which do not share
+            // any subtree with them, are serialized on another thread and appended after them.
+            std::ostringstream regs_bin;
             if (options.binary != ONE_PIPE) {
-                this->mem_top.emit_binary(*binfile, 0);
-                this->reg_top.emit_binary(*binfile, 0);
+                run_output_jobs({[&]() { this->mem_top.emit_binary(*binfile, 0); },
+                                 [&]() { this->reg_top.emit_binary(regs_bin, 0); }});
             } else {
-                this->mem_pipe.emit_binary(*binfile, 0);
-                this->reg_pipe.emit_binary(*binfile, 0);
+                run_output_jobs({[&]() { this->mem_pipe.emit_binary(*binfile, 0); },
+                                 [&]() { this->reg_pipe.emit_binary(regs_bin, 0); }});
             }
+            if (regs_bin.tellp() > 0) *binfile << regs_bin.rdbuf();
 
             if (options.multi_parsers) {
                 emit_parser_registers(this, *binfile);
@@ -117,9 +127,10 @@ void TopLevelRegs<TARGET>::output(json::map &ctxt_json) {
 
 template <class TARGET>
 void TopLevelRegs<TARGET>::set_mau_stage(int stage, const char *file,
-                                         typename TARGET::mau_regs *regs, bool egress_only) {
+                                         typename TARGET::mau_regs *regs, bool egress_only,
+                                         binary_output_cache *binary) {
     BUG_CHECK(!egress_only, "separate egress MAU on target that does not support it");
-    this->reg_pipe.mau[stage].set(file, regs);
+    this->reg_pipe.mau[stage].set(file, regs).set_binary_cache(binary);
 }
 
 #define TOP_LEVEL_REGS(REGSET) template class TopLevelRegs<Target::REGSET>;
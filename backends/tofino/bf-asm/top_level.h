@@ -20,6 +20,7 @@
 
 #include "backends/tofino/bf-asm/json.h"
 #include "backends/tofino/bf-asm/target.h"
+#include "register_reference.h"
 
 template <class REGSET>
 class TopLevelRegs;
@@ -35,9 +36,10 @@ class TopLevel {
     static void output_all(json::map &ctxtJson) { all->output(ctxtJson); }
     template <class T>
     static TopLevelRegs<typename T::register_type> *regs();
-#define SET_MAU_STAGE(TARGET)                                                         \
-    virtual void set_mau_stage(int, const char *, Target::TARGET::mau_regs *, bool) { \
-        BUG("register mismatch");                                                     \
+#define SET_MAU_STAGE(TARGET)                                                       \
+    virtual void set_mau_stage(int, const char *, Target::TARGET::mau_regs *, bool, \
+                               binary_output_cache *) {                             \
+        BUG("register mismatch");                                                   \
     }
     FOR_ALL_REGISTER_SETS(SET_MAU_STAGE)
 };
@@ -50,7 +52,7 @@ class TopLevelRegs : public TopLevel, public REGSET::top_level_regs {
 
     void output(json::map &);
     void set_mau_stage(int stage, const char *file, typename REGSET::mau_regs *regs,
-                       bool egress_only);
+                       bool egress_only, binary_output_cache *binary);
 };
 
 template <class T>
@@ -452,7 +452,7 @@ class csr_composite_object(csr_object):
             outfile.write("%sif (disabled_) {\n" % indent)
             outfile.write('%s  out << "0";\n' % indent)
             outfile.write("%s  return; }\n" % indent)
-        outfile.write("%sout << '{' << std::endl;\n" % indent)
+        outfile.write("%sout << '{' << '\\n';\n" % indent)
         first = True
         if self.top_level():
             if len(nameargs) > 0:
@@ -686,11 +686,11 @@ class csr_composite_object(csr_object):
                 indent = indent[2:]
                 outfile.write("%s}\n" % indent)
             else:
+                # a top level child is a register_reference, which dumps the tree it refers
+                # to (if any) itself
                 outfile.write(indent)
-                if a.top_level():
-                    outfile.write("if (%s)" % field_name(a))
                 outfile.write(field_name(a))
-                outfile.write("->" if a.top_level() else ".")
+                outfile.write(".")
                 outfile.write(
                     "emit_binary(out, %s + 0x%x);\n" % (addr_var, a.offset // address_unit)
                 )
@@ -342,6 +342,20 @@ BFN_Options::BFN_Options() {
             return true;
         },
         "Do not reorder tables in a basic block");
+    registerOption(
+        "--table-placement-lookahead", "K",
+        [this](const char *arg) {
+            int temp = std::atoi(arg);
+            if (temp < 0 || (!temp && *arg != '0')) {
+                ::error("Invalid table placement lookahead %s, expected a number of candidates",
+                        arg);
+                return false;
+            }
+            table_placement_lookahead = temp;
+            return true;
+        },
+        "At each table placement decision, complete the stage speculatively for the K best "
+        "candidates and keep the one that fits the most tables in the stage. Default:0 (off)");
     registerOption(
         "--disable_backfill", nullptr,
         [this](const char *) {
@@ -505,6 +519,44 @@ BFN_Options::BFN_Options() {
         },
         "DEPRECATED. Use the pa_quick_phv_alloc annotation instead. "
         "Reduce PHV allocation search space for faster compilation");
+    registerOption(
+        "--phv-slicing-cache", "file",
+        [this](const char *arg) {
+            phv_slicing_cache = cstring(arg);
+            return true;
+        },
+        "Read and update <file> with hints learned while slicing PHV super clusters, "
+        "so that later compiles of the same program search for slicings faster");
+    registerOption(
+        "--phv-alloc-jobs", "N",
+        [this](const char *arg) {
+            int temp = std::atoi(arg);
+            if (temp < 0 || (!temp && *arg != '0')) {
+                ::error("Invalid number of PHV allocation jobs %s, expected a number", arg);
+                return false;
+            }
+            phv_alloc_jobs = temp;
+            return true;
+        },
+        "Run the PHV allocation configs on at most N threads when the compiler is built with "
+        "multithreading. 1 runs them one after another. Default:0 (one thread per config)");
+    registerOption(
+        "--warm-start", "dir",
+        [this](const char *arg) {
+            warm_start = cstring(arg);
+            return true;
+        },
+        "Start PHV allocation and table placement from the allocation logged in <dir>, the "
+        "output directory of a previous compile of the same program built with debug info (-g). "
+        "Slices and tables that still fit stay where they were");
+    registerOption(
+        "--preflight", nullptr,
+        [this](const char *) {
+            preflight = true;
+            return true;
+        },
+        "Only estimate the stages, SRAMs, TCAMs, hash bits and PHV the program needs and report "
+        "whether it can fit and its bottleneck, without allocating PHVs or placing tables");
 #if 1 || BAREFOOT_INTERNAL
     registerOption(
         "--alt-phv-alloc", nullptr,
@@ -55,9 +55,14 @@ class BFN_Options : public CompilerOptions {
     bool disable_egress_latency_padding = false;
     bool table_placement_in_order = false;
     bool table_placement_long_branch_backtrack = false;
+    int table_placement_lookahead = 0;
     bool disable_gfm_parity = true;
     int relax_phv_init = 0;
     bool quick_phv_alloc = false;
+    cstring phv_slicing_cache = nullptr;
+    int phv_alloc_jobs = 0;
+    cstring warm_start = nullptr;
+    bool preflight = false;
 #ifdef ALT_PHV_ALLOC_DEFAULT
     bool alt_phv_alloc = ALT_PHV_ALLOC_DEFAULT;
 #else
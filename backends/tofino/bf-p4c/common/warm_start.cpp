@@ -0,0 +1,193 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/common/warm_start.h"
+
+#include <rapidjson/document.h>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "backends/tofino/bf-p4c/bf-p4c-options.h"
+#include "backends/tofino/bf-p4c/common/asm_output.h"
+#include "backends/tofino/bf-p4c/device.h"
+#include "backends/tofino/bf-p4c/phv/phv_fields.h"
+#include "backends/tofino/bf-p4c/phv/utils/slice_alloc.h"
+#include "lib/error.h"
+#include "lib/log.h"
+
+namespace {
+
+/// A log that exists but does not have the layout written by PhvLogging / ResourcesLogging.
+struct MalformedLog : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+const rapidjson::Value &member(const rapidjson::Value &obj, const char *name) {
+    if (!obj.IsObject() || !obj.HasMember(name))
+        throw MalformedLog(std::string("no \"") + name + "\"");
+    return obj[name];
+}
+
+int int_member(const rapidjson::Value &obj, const char *name) {
+    const auto &v = member(obj, name);
+    if (!v.IsInt()) throw MalformedLog(std::string("\"") + name + "\" is not an integer");
+    return v.GetInt();
+}
+
+cstring string_member(const rapidjson::Value &obj, const char *name) {
+    const auto &v = member(obj, name);
+    if (!v.IsString()) throw MalformedLog(std::string("\"") + name + "\" is not a string");
+    return cstring(v.GetString());
+}
+
+rapidjson::Value::ConstArray array_member(const rapidjson::Value &obj, const char *name) {
+    const auto &v = member(obj, name);
+    if (!v.IsArray()) throw MalformedLog(std::string("\"") + name + "\" is not an array");
+    return v.GetArray();
+}
+
+/// @returns false if there is no log at @p path, throws MalformedLog if it is not JSON.
+bool read_log(const std::string &path, rapidjson::Document &doc) {
+    std::ifstream in(path);
+    if (!in) {
+        LOG1("No warm start log at " << path);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    doc.Parse(buffer.str().c_str());
+    if (doc.HasParseError() || !doc.IsObject()) throw MalformedLog("not a JSON log");
+    return true;
+}
+
+/// The name under which ResourcesLogging logs @p table.
+cstring logged_name(const IR::MAU::Table *table) {
+    if (table->match_table) return canon_name(table->match_table->externalName());
+    return table->build_gateway_name();
+}
+
+}  // namespace
+
+const WarmStart *WarmStart::get(int pipe_id) {
+    // Keyed on the directory too, as one process may compile several programs (e.g. gtest)
+    static std::map<std::pair<cstring, int>, const WarmStart *> pipes;
+    cstring dir = BackendOptions().warm_start;
+    if (!dir) return nullptr;
+    auto key = std::make_pair(dir, pipe_id);
+    if (pipes.count(key)) return pipes.at(key);
+
+    // Same layout as BFNContext::getOutputDirectory
+    auto pipe_name = BFNContext::get().getPipeName(pipe_id);
+    if (!pipe_name.isNullOrEmpty() &&
+        BackendOptions().langVersion == BFN_Options::FrontendVersion::P4_16)
+        dir = dir + "/" + pipe_name;
+    return pipes[key] = load(dir);
+}
+
+const WarmStart *WarmStart::load(cstring dir) {
+    auto *rv = new WarmStart;
+    std::string path = dir + "/logs/phv.json";
+    try {
+        bool found = rv->load_phv(path);
+        path = dir + "/logs/resources.json";
+        found |= rv->load_resources(path);
+        if (!found) {
+            warning("--warm-start: no allocation found in %1%/logs, compiling from scratch", dir);
+            return nullptr;
+        }
+    } catch (const MalformedLog &e) {
+        // Half of a previous allocation is worse than none, drop both logs
+        warning("--warm-start: ignoring %1%, %2%; compiling from scratch", path, e.what());
+        return nullptr;
+    }
+    return rv;
+}
+
+bool WarmStart::load_phv(const std::string &path) {
+    rapidjson::Document doc;
+    if (!read_log(path, doc)) return false;
+
+    const auto &phvSpec = Device::phvSpec();
+    int count = 0;
+    for (const auto &c : array_member(doc, "containers")) {
+        int phv_number = int_member(c, "phv_number");
+        if (phv_number < 0) throw MalformedLog("negative \"phv_number\"");
+        auto container = phvSpec.physicalAddressToContainer(phv_number, PhvSpec::MAU);
+        gress_t gress;
+        if (!container || !(string_member(c, "gress") >> gress)) continue;
+        for (const auto &cs : array_member(c, "slices")) {
+            const auto &fs = member(cs, "field_slice");
+            const auto &fs_info = member(fs, "slice_info");
+            int lo = int_member(fs_info, "lsb"), hi = int_member(fs_info, "msb");
+            if (lo < 0 || hi < lo) throw MalformedLog("bad \"slice_info\" range");
+            slices[{gress, string_member(fs, "field_name")}].push_back(
+                {le_bitrange(FromTo(lo, hi)), *container,
+                 int_member(member(cs, "slice_info"), "lsb")});
+            count++;
+        }
+    }
+    LOG1("Warm start: " << count << " PHV slices from " << path);
+    return true;
+}
+
+bool WarmStart::load_resources(const std::string &path) {
+    rapidjson::Document doc;
+    if (!read_log(path, doc)) return false;
+
+    const auto &mau = member(member(doc, "resources"), "mau");
+    for (const auto &stage : array_member(mau, "mau_stages")) {
+        int stage_number = int_member(stage, "stage_number");
+        for (const auto &lt : array_member(member(stage, "logical_tables"), "ids")) {
+            cstring name = string_member(lt, "table_name");
+            // Split tables are logged in every stage they use, keep the first one
+            auto it = stages.find(name);
+            if (it == stages.end() || it->second > stage_number) stages[name] = stage_number;
+        }
+    }
+    LOG1("Warm start: " << stages.size() << " tables from " << path);
+    return true;
+}
+
+std::optional<PHV::Container> WarmStart::container(const PHV::Field *field, int bit) const {
+    auto it = slices.find({field->gress, stripThreadPrefix(field->name)});
+    if (it == slices.end()) return std::nullopt;
+    for (const auto &prev : it->second)
+        if (prev.field_bits.contains(bit)) return prev.container;
+    return std::nullopt;
+}
+
+bool WarmStart::matches(const PHV::AllocSlice &slice) const {
+    auto it = slices.find({slice.field()->gress, stripThreadPrefix(slice.field()->name)});
+    if (it == slices.end()) return false;
+    for (const auto &prev : it->second) {
+        if (prev.container != slice.container()) continue;
+        if (!prev.field_bits.contains(slice.field_slice())) continue;
+        if (prev.container_lo + slice.field_slice().lo - prev.field_bits.lo ==
+            slice.container_slice().lo)
+            return true;
+    }
+    return false;
+}
+
+std::optional<int> WarmStart::stage(const IR::MAU::Table *table) const {
+    auto it = stages.find(logged_name(table));
+    if (it == stages.end()) return std::nullopt;
+    return it->second;
+}
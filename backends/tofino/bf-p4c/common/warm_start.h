@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BACKENDS_TOFINO_BF_P4C_COMMON_WARM_START_H_
+#define BACKENDS_TOFINO_BF_P4C_COMMON_WARM_START_H_
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "backends/tofino/bf-p4c/ir/gress.h"
+#include "backends/tofino/bf-p4c/phv/phv.h"
+#include "ir/ir.h"
+#include "lib/bitrange.h"
+#include "lib/cstring.h"
+
+namespace PHV {
+class AllocSlice;
+class Field;
+}  // namespace PHV
+
+/// The allocation of a previous compile of the same program, read from the phv.json and
+/// resources.json logs of its output directory, see --warm-start.
+///
+/// PHV allocation tries the previous container of a slice list first, and keeps it when the
+/// slices land on the same bits. Table placement prefers the table that was placed in an earlier
+/// stage. A small change to the program then leaves the rest of the layout where it was. These
+/// are only preferences: every constraint is still checked and anything that does not fit the
+/// previous allocation anymore is allocated as if there was no previous compile.
+class WarmStart {
+    struct PrevSlice {
+        le_bitrange field_bits;
+        PHV::Container container;
+        int container_lo;
+    };
+    std::map<std::pair<gress_t, cstring>, std::vector<PrevSlice>> slices;
+    std::map<cstring, int> stages;
+
+    bool load_phv(const std::string &path);
+    bool load_resources(const std::string &path);
+
+ public:
+    /// @returns the previous allocation of pipe @p pipe_id, nullptr without --warm-start or when
+    /// the previous compile did not log this pipe.
+    static const WarmStart *get(int pipe_id);
+    /// @returns the allocation logged in @p dir/logs, nullptr with a warning when neither log
+    /// is there or either one is malformed.
+    static const WarmStart *load(cstring dir);
+
+    /// @returns the container of bit @p bit of @p field in the previous allocation.
+    std::optional<PHV::Container> container(const PHV::Field *field, int bit) const;
+    /// @returns true if @p slice is allocated as in the previous allocation.
+    bool matches(const PHV::AllocSlice &slice) const;
+    /// @returns the first stage of @p table in the previous placement.
+    std::optional<int> stage(const IR::MAU::Table *table) const;
+};
+
+#endif /* BACKENDS_TOFINO_BF_P4C_COMMON_WARM_START_H_ */
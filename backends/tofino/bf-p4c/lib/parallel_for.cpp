@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/lib/parallel_for.h"
+
+#ifdef MULTITHREAD
+#include <gc/gc.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lib/exceptions.h"
+#endif
+
+namespace BFN {
+
+#ifdef MULTITHREAD
+namespace {
+
+void *gc_thread_main(void *arg) {
+    GC_stack_base sb;
+    GC_get_stack_base(&sb);
+    GC_register_my_thread(&sb);
+    (*static_cast<const std::function<void()> *>(arg))();
+    GC_unregister_my_thread();
+    return NULL;
+}
+
+struct ParallelForRange {
+    const std::function<void(size_t, size_t)> *body;
+    size_t lo, hi;
+    std::exception_ptr exception;
+};
+
+/// The worker threads of parallel_for.  They are started on demand and wait for the ranges
+/// of the next call until the compiler exits.
+class ParallelForPool {
+    std::mutex mutex;
+    std::condition_variable work_ready, work_done;
+    std::vector<ParallelForRange> *ranges = nullptr;
+    size_t next = 0;     // the first range not handed out yet
+    size_t running = 0;  // ranges handed out and not finished
+    std::vector<pthread_t> workers;
+    const std::function<void()> worker_body = [this] { work(); };
+
+    // Runs ranges of the current call until they are all handed out; called with @p lock held.
+    void run_ranges(std::unique_lock<std::mutex> &lock) {
+        while (ranges && next < ranges->size()) {
+            auto &range = (*ranges)[next++];
+            ++running;
+            lock.unlock();
+            try {
+                (*range.body)(range.lo, range.hi);
+            } catch (...) {
+                range.exception = std::current_exception();
+            }
+            lock.lock();
+            if (--running == 0 && next == ranges->size()) work_done.notify_all();
+        }
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            work_ready.wait(lock, [this] { return ranges && next < ranges->size(); });
+            run_ranges(lock);
+        }
+    }
+
+ public:
+    /// Held by the parallel_for call using the workers.
+    std::mutex in_use;
+
+    void run(std::vector<ParallelForRange> &call_ranges) {
+        std::unique_lock<std::mutex> lock(mutex);
+        // The calling thread takes a range too.
+        while (workers.size() + 1 < call_ranges.size()) {
+            pthread_t tid = start_gc_thread(worker_body);
+            int err = pthread_detach(tid);
+            BUG_CHECK(!err, "Pthread Detach fail with error: %d", err);
+            workers.push_back(tid);
+        }
+        ranges = &call_ranges;
+        next = running = 0;
+        work_ready.notify_all();
+        run_ranges(lock);
+        work_done.wait(lock, [&] { return next == call_ranges.size() && running == 0; });
+        ranges = nullptr;
+    }
+};
+
+}  // namespace
+
+pthread_t start_gc_thread(const std::function<void()> &body) {
+    static std::once_flag init_mt;
+    std::call_once(init_mt, [] { GC_allow_register_threads(); });
+
+    pthread_t tid;
+    pthread_attr_t attr;
+    int err;
+    // This value is to make sure the created stack will not be cached
+    size_t stack_size = 1024 * 1024 * 64;  // 64MB
+    err = pthread_attr_init(&attr);
+    BUG_CHECK(!err, "Pthread Attribute initialization fail with error: %d", err);
+    err = pthread_attr_setstacksize(&attr, stack_size);
+    BUG_CHECK(!err, "Pthread Attribute Set Stack Size fail with error: %d", err);
+    err = pthread_create(&tid, &attr, gc_thread_main, const_cast<std::function<void()> *>(&body));
+    BUG_CHECK(!err, "Pthread Creation fail with error: %d", err);
+    err = pthread_attr_destroy(&attr);
+    BUG_CHECK(!err, "Pthread Attribute destroy fail with error: %d", err);
+    return tid;
+}
+#endif
+
+void parallel_for(size_t n, const std::function<void(size_t, size_t)> &body, size_t grain) {
+    if (n == 0) return;
+#ifdef MULTITHREAD
+    size_t threads = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()),
+                                      n / std::max<size_t>(grain, 1));
+    if (threads > 1) {
+        // Never destroyed: the workers keep waiting on it until the compiler exits.
+        static auto *pool = new ParallelForPool;
+        std::unique_lock<std::mutex> use(pool->in_use, std::try_to_lock);
+        if (use.owns_lock()) {
+            std::vector<ParallelForRange> ranges;
+            size_t chunk = (n + threads - 1) / threads;
+            for (size_t lo = 0; lo < n; lo += chunk)
+                ranges.push_back({&body, lo, std::min(n, lo + chunk), nullptr});
+            pool->run(ranges);
+
+            for (auto &range : ranges)
+                if (range.exception) std::rethrow_exception(range.exception);
+            return;
+        }
+    }
+#else
+    (void)grain;
+#endif
+    body(0, n);
+}
+
+}  // namespace BFN
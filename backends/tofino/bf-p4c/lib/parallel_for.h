@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BACKENDS_TOFINO_BF_P4C_LIB_PARALLEL_FOR_H_
+#define BACKENDS_TOFINO_BF_P4C_LIB_PARALLEL_FOR_H_
+
+#include <cstddef>
+#include <functional>
+
+#ifdef MULTITHREAD
+#include <pthread.h>
+#endif
+
+namespace BFN {
+
+/// Calls @p body on consecutive ranges [lo, hi) that together cover [0, @p n).  When the
+/// compiler is built with MULTITHREAD and there are at least 2 * @p grain items, the ranges
+/// are handed to worker threads, otherwise @p body is called once for the whole range.
+///
+/// @p body must only write state owned by its range (e.g. one result slot per row); the
+/// caller merges the results afterwards, in index order, so that the outcome does not depend
+/// on the number of threads.  An exception thrown by @p body is rethrown once every range
+/// has finished, the one of the lowest range first.
+///
+/// The worker threads are started by the first call and reused by the later ones.  A call
+/// made while another one is using them, e.g. from inside @p body, runs on the calling thread.
+void parallel_for(size_t n, const std::function<void(size_t lo, size_t hi)> &body,
+                  size_t grain = 64);
+
+#ifdef MULTITHREAD
+/// Starts a thread running @p body, registered with the garbage collector and with a 64MB
+/// stack, as the recursive walks over the IR need.  @p body must stay alive until the thread
+/// has returned; the caller joins it with pthread_join.
+pthread_t start_gc_thread(const std::function<void()> &body);
+#endif
+
+}  // namespace BFN
+
+#endif /* BACKENDS_TOFINO_BF_P4C_LIB_PARALLEL_FOR_H_ */
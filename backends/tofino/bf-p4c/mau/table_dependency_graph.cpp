@@ -41,6 +41,7 @@
 #include "backends/tofino/bf-p4c/phv/phv_fields.h"
 #include "ir/ir.h"
 #include "lib/cstring.h"
+#include "lib/hash.h"
 #include "lib/log.h"
 #include "table_injected_deps.h"
 
@@ -2418,7 +2419,8 @@ FindDependencyGraph::FindDependencyGraph(const PhvInfo &phv, DependencyGraph &ou
       options(o),
       dotFile(dotFileName),
       passContext(passCont),
-      summary(s) {
+      summary(s),
+      phv(phv) {
     addPasses({new NameToTableMapBuilder(dg), &mutex, &ntp, &con_paths, &ignore,
                new GatherReductionOrReqs(dg.red_info), new PrintPipe,
                new TableFindInjectedDependencies(phv, dg, fg, options, summary),
@@ -2431,12 +2433,80 @@ Visitor::profile_t FindDependencyGraph::init_apply(const IR::Node *node) {
     if (!passContext.isNullOrEmpty())
         LOG1("FindDependencyGraph : " << passContext << " : "
                                       << (summary ? summary->getActualStateStr().c_str() : " NA "));
+    reuse_graph = dg.finalized && dg.built_from == build_inputs(node);
+    if (reuse_graph) {
+        LOG1("Dependency graph inputs unchanged, keeping the graph");
+        return rv;
+    }
     dg.clear();
     return rv;
 }
 
+const IR::Node *FindDependencyGraph::apply_visitor(const IR::Node *root, const char *name) {
+    if (reuse_graph) return root;
+    return Logging::PassManager::apply_visitor(root, name);
+}
+
+/// Everything the graph is built from goes in here, so that a graph is only kept when building
+/// it again would give the same result.  Besides the IR, that is the PHV allocation (including
+/// the liveness of the slices), the PHV analyses consulted by FindDataDependencyGraph and
+/// TableFindInjectedDependencies, the min and physical stages recorded in PhvInfo and the
+/// stages the last table placement round gave to the tables, which TableSummary::stages returns
+/// for the dep_stages_control_anti_split chains.  The latter is looked up for the tables of the
+/// graph currently in @a dg, which are the tables of @p root whenever the roots match.
+DependencyGraph::BuildInputs FindDependencyGraph::build_inputs(const IR::Node *root) const {
+    DependencyGraph::BuildInputs rv;
+    rv.root = root;
+    rv.options = options;
+    rv.summary = summary;
+    rv.field_mutex = phv.field_mutex();
+    rv.metadata_mutex = phv.metadata_mutex();
+
+    std::stringstream ss;
+    ss << phv.alloc_done() << ' ' << PhvInfo::getDeparserStage() << '\n';
+    for (const auto &f : phv) {
+        ss << f << '\n';
+        for (const auto &sl : f.get_alloc()) ss << "  " << sl << '\n';
+    }
+    for (const auto &[src, dst] : phv.getAliasMap()) ss << src->id << " -> " << dst->id << '\n';
+    for (const auto &[tbl, later] : phv.getMetadataDeps()) {
+        ss << tbl << " before";
+        for (auto t : later) ss << ' ' << t;
+        ss << '\n';
+    }
+    for (const auto &[gress, constraints] : phv.getARAConstraints()) {
+        for (const auto &[tbl, cnstrs] : constraints) {
+            ss << gress << ' ' << tbl->name << " after";
+            for (const auto &id : cnstrs.first) ss << ' ' << id;
+            ss << " before";
+            for (const auto &id : cnstrs.second) ss << ' ' << id;
+            ss << '\n';
+        }
+    }
+    ss << PhvInfo::reportMinStages();
+    for (const auto &[tbl, stages] : PhvInfo::table_to_physical_stages) {
+        ss << tbl;
+        for (int st : stages) ss << ' ' << st;
+        ss << '\n';
+    }
+    if (options) ss << options->disable_long_branch << options->alt_phv_alloc << '\n';
+    if (summary) {
+        ss << summary->getActualStateStr() << '\n';
+        for (const auto &kv : dg.stage_info) {
+            ss << kv.first->name;
+            for (int st : summary->stages(kv.first, true)) ss << ' ' << st;
+            ss << '\n';
+        }
+    }
+    rv.hash = P4::Util::hash(ss.str());
+    return rv;
+}
+
 void FindDependencyGraph::end_apply(const IR::Node *root) {
-    finalize_dependence_graph();
+    if (!reuse_graph) {
+        finalize_dependence_graph();
+        dg.built_from = build_inputs(root);
+    }
 
     LOG2(dg);
     if (BackendOptions().create_graphs && dotFile != "") {
@@ -294,6 +294,25 @@ struct DependencyGraph {
     cstring passContext;
     bool placed = false;
 
+    /// What the graph was last built from.  Besides the IR, the graph depends on the PHV
+    /// allocation, the PHV analyses and the stages of the previous table placement round.  When
+    /// none of these changed, FindDependencyGraph keeps the graph instead of building it again.
+    struct BuildInputs {
+        const IR::Node *root = nullptr;
+        const BFN_Options *options = nullptr;
+        const TableSummary *summary = nullptr;
+        SymBitMatrix field_mutex;
+        SymBitMatrix metadata_mutex;
+        uint64_t hash = 0;  // everything else, see FindDependencyGraph::build_inputs
+
+        bool operator==(const BuildInputs &o) const {
+            return root == o.root && options == o.options && summary == o.summary &&
+                   hash == o.hash && field_mutex == o.field_mutex &&
+                   metadata_mutex == o.metadata_mutex;
+        }
+    };
+    BuildInputs built_from;
+
     DependencyGraph(void) { finalized = false; }
 
     void clear() {
@@ -327,6 +346,7 @@ struct DependencyGraph {
         containers_read_xbar_.clear();
         containers_read_alu_.clear();
         table_dep_.clear();
+        built_from = BuildInputs();
     }
 
     /// Fill up the stage_info map value regarding dep_stages_control_anti or
@@ -1050,9 +1070,17 @@ class FindDependencyGraph : public Logging::PassManager {
     const TableSummary *summary;
 
     void end_apply(const IR::Node *root) override;
+    const IR::Node *apply_visitor(const IR::Node *root, const char *name = 0) override;
     void add_logical_deps_from_control_deps();
 
+    const PhvInfo &phv;
+    /// Set by init_apply when the graph in @a dg was built from the same inputs and is kept
+    bool reuse_graph = false;
+    DependencyGraph::BuildInputs build_inputs(const IR::Node *root) const;
+
  public:
+    /// @returns true if the last run kept the existing graph instead of building it again
+    bool reused_graph() const { return reuse_graph; }
     std::vector<ordered_set<DependencyGraph::Graph::vertex_descriptor>> calc_topological_stage(
         unsigned deps_flag = 0, DependencyGraph *dg_p = nullptr);
     FindDependencyGraph(const PhvInfo &, DependencyGraph &out, const BFN_Options *o = nullptr,
@@ -18,6 +18,8 @@
 
 #include "backends/tofino/bf-p4c/mau/table_mutex.h"
 
+#include <vector>
+
 #include "backends/tofino/bf-p4c/lib/error_type.h"
 
 bool IgnoreTableDeps::ignore_deps(const IR::MAU::Table *t1, const IR::MAU::Table *t2) const {
@@ -149,21 +151,27 @@ void TablesMutuallyExclusive::postorder(const IR::MAU::TableSeq *seq) {
      * [t2]  [t3]
      *
      * Here, we ensure that t4 is marked as not mutually exclusive with all of t1's table_succ
-     * entries.*/
-    for (size_t i = 0; i < seq->tables.size(); i++) {
+     * entries.
+     *
+     * later[i] is the union of the table_succ entries of the tables after table i in the
+     * sequence, up to and including the first exit table, so that each successor of a table
+     * needs a single row update. */
+    size_t size = seq->tables.size();
+    std::vector<bitvec> later(size + 1);
+    for (size_t j = size; j-- > 0;) {
+        auto j_tbl = seq->tables.at(j);
+        later[j] = table_succ[j_tbl];
+        if (!j_tbl->is_exit_table()) later[j] |= later[j + 1];
+    }
+    for (size_t i = 0; i < size; i++) {
         auto i_tbl = seq->tables.at(i);
-        if (i_tbl->is_exit_table()) continue;
-        for (size_t j = i + 1; j < seq->tables.size(); j++) {
-            auto j_tbl = seq->tables.at(j);
-            for (auto i_id : table_succ[i_tbl]) {
-                // Ensure that if the one of the successor of i_tbl is an exit table, then
-                // some of the table_succ of i_tbl will be mutually exclusive with j_tbl and its
-                // sucessors
-                if (exit_succ.count(i_tbl) && exit_succ[i_tbl].getbit(i_id)) continue;
-                non_mutex[i_id] |= table_succ[j_tbl];
-            }
-            if (j_tbl->is_exit_table()) break;
-        }
+        if (i_tbl->is_exit_table() || later[i + 1].empty()) continue;
+        bitvec rows = table_succ[i_tbl];
+        // Ensure that if the one of the successor of i_tbl is an exit table, then
+        // some of the table_succ of i_tbl will be mutually exclusive with the later tables
+        // and their sucessors
+        if (exit_succ.count(i_tbl)) rows -= exit_succ[i_tbl];
+        for (auto i_id : rows) non_mutex[i_id] |= later[i + 1];
     }
 }
 
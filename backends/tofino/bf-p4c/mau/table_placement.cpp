@@ -41,6 +41,7 @@
 #include "backends/tofino/bf-p4c/common/ir_utils.h"
 #include "backends/tofino/bf-p4c/ir/table_tree.h"
 #include "backends/tofino/bf-p4c/lib/error_type.h"
+#include "backends/tofino/bf-p4c/lib/parallel_for.h"
 #include "backends/tofino/bf-p4c/lib/pointer_wrapper.h"
 #include "backends/tofino/bf-p4c/logging/manifest.h"
 #include "backends/tofino/bf-p4c/mau/action_data_bus.h"
@@ -3388,6 +3389,15 @@ bool DecidePlacement::is_better(const Placed *a, const Placed *b,
     if (a->complete_shared > b->complete_shared) return true;
     if (a->complete_shared < b->complete_shared) return false;
 
+    ///> Order of the previous compile, with --warm-start
+    choice = TablePlacement::WARM_START;
+    if (warm_start) {
+        auto a_prev_stage = warm_start->stage(a->table);
+        auto b_prev_stage = warm_start->stage(b->table);
+        if (a_prev_stage && b_prev_stage && *a_prev_stage != *b_prev_stage)
+            return *a_prev_stage < *b_prev_stage;
+    }
+
     ///> Downward Propagation - @sa dynamic_dep_matrix
     choice = TablePlacement::DOWNWARD_PROP_DSC;
     if (down_score.first > down_score.second) return !provided_stage;
@@ -4017,6 +4027,190 @@ void DecidePlacement::TryPlacedPool::shutdown() {
 }
 #endif
 
+/* This class implements the speculative placement enabled by "--table-placement-lookahead K".
+ * At any given time, the placement chooses the table to place among all of the placeable ones
+ * with the is_better heuristics, which only look at the candidate tables themselves. With a
+ * lookahead of K, the K best candidates in is_better order are each speculatively completed
+ * into a full stage, by placing the other placeable tables greedily after them, and the
+ * candidate whose stage ends up holding the most tables is selected instead of the first one.
+ * Candidates are only second-guessed when they lost to the best one on a heuristic, i.e. the
+ * stage, stage pragma, priority, shared table and warm start rules still decide.
+ *
+ * A speculation only builds its own chain of Placed objects on top of the actual placement.
+ * Each of them carries its own TableResourceAlloc so speculations do not share any resource
+ * state, nothing is committed and the speculative Placed are simply dropped afterward. In a
+ * MULTITHREAD build the speculations are evaluated by worker threads, the same way
+ * TryPlacedPool evaluates the candidates. The scores are merged by candidate rank, ties going to
+ * the better ranked candidate, so the selected table does not depend on the number of threads
+ * nor on the order in which the speculations complete.
+ */
+class DecidePlacement::SpeculativePlacement {
+    DecidePlacement &self;
+    int width;
+
+    // The placement requests of the actual decision point, in the order they were made. They
+    // are replayed in this order to complete the stage of each candidate.
+    struct request_t {
+        const IR::MAU::Table *t;
+        TablePlacement::GatewayMergeChoices gmc;
+    };
+    std::vector<request_t> requests;
+
+    int tables_in_stage(const Placed *candidate) const;
+
+#ifdef MULTITHREAD
+    std::vector<pthread_t> workers;
+    std::atomic<bool> terminated{false};
+    std::condition_variable_any queue_CV;
+    std::mutex queue_mutex;
+    std::queue<std::pair<int, const Placed *>> work_queue;
+    std::condition_variable_any res_CV;
+    std::mutex res_mutex;
+    std::vector<int> scores;
+    int exe_req = 0;
+
+    void workerWait();
+    const std::function<void()> worker = [this] { workerWait(); };
+#endif
+
+ public:
+    SpeculativePlacement(DecidePlacement &self, int width) : self(self), width(width) {
+#ifdef MULTITHREAD
+        if (!enabled()) return;
+        for (int i = 0; i < std::min(self.jobs, width); i++)
+            workers.push_back(BFN::start_gc_thread(worker));
+#endif
+    }
+#ifdef MULTITHREAD
+    ~SpeculativePlacement() {
+        terminated = true;
+        queue_CV.notify_all();
+        for (pthread_t &tid : workers) {
+            int err = pthread_join(tid, NULL);
+            BUG_CHECK(!err, "Pthread Join fail with error: %d", err);
+        }
+    }
+#endif
+
+    bool enabled() const { return width > 1; }
+    void clear() { requests.clear(); }
+    void addReq(const IR::MAU::Table *t, const TablePlacement::GatewayMergeChoices &gmc) {
+        if (enabled()) requests.push_back({t, gmc});
+    }
+    const Placed *select(const Placed *best, const safe_vector<const Placed *> &trial);
+};
+
+// Number of tables completely placed in the stage of @p candidate once the requests of the
+// decision point are greedily placed after it.
+int DecidePlacement::SpeculativePlacement::tables_in_stage(const Placed *candidate) const {
+    auto placed_since_candidate = [candidate](const Placed *spec, const IR::MAU::Table *t) {
+        for (auto *p = spec; p != candidate->prev; p = p->prev)
+            if (p->table == t || p->gw == t) return true;
+        return false;
+    };
+
+    const Placed *spec = candidate;
+    for (auto &req : requests) {
+        if (spec->is_placed(req.t) || placed_since_candidate(spec, req.t)) continue;
+        TablePlacement::GatewayMergeChoices gmc;
+        for (auto &mc : req.gmc)
+            if (!spec->is_placed(mc.first) && !placed_since_candidate(spec, mc.first))
+                gmc.insert(mc);
+        if (!req.gmc.empty() && gmc.empty()) continue;
+        StageUseEstimate current = get_current_stage_use(spec);
+        for (auto *pl : self.self.try_place_table(req.t, spec, current, gmc)) {
+            if (pl->stage != candidate->stage) continue;
+            spec = pl;
+            break;
+        }
+    }
+
+    int rv = 0;
+    for (auto *p = spec; p != candidate->prev; p = p->prev)
+        if (!p->need_more) rv++;
+    return rv;
+}
+
+#ifdef MULTITHREAD
+void DecidePlacement::SpeculativePlacement::workerWait() {
+    while (!terminated.load()) {
+        std::pair<int, const Placed *> req;
+        {
+            std::unique_lock<std::mutex> guard(queue_mutex);
+            queue_CV.wait(guard, [&] { return !work_queue.empty() || terminated.load(); });
+            if (terminated.load()) break;
+            req = work_queue.front();
+            work_queue.pop();
+        }
+        int score = tables_in_stage(req.second);
+        {
+            std::lock_guard<std::mutex> guard(res_mutex);
+            scores[req.first] = score;
+            exe_req++;
+            res_CV.notify_one();
+        }
+    }
+}
+#endif
+
+// Return the candidate of @p trial to place next, @p best being the one chosen by is_better.
+const DecidePlacement::Placed *DecidePlacement::SpeculativePlacement::select(
+    const Placed *best, const safe_vector<const Placed *> &trial) {
+    if (!enabled()) return best;
+
+    // Rank the candidates that only lost to best on a heuristic.  is_better updates the dynamic
+    // dependency metrics, so the ranking stays on this thread.
+    TablePlacement::choice_t choice;
+    safe_vector<const Placed *> others;
+    for (auto *t : trial) {
+        if (t == best || t->stage != best->stage) continue;
+        if (is_better(t, best, choice)) continue;
+        if (choice < TablePlacement::DOWNWARD_PROP_DSC) continue;
+        others.push_back(t);
+    }
+    safe_vector<const Placed *> ranked = {best};
+    while (!others.empty() && static_cast<int>(ranked.size()) < width) {
+        auto next = others.begin();
+        for (auto it = std::next(next); it != others.end(); ++it)
+            if (is_better(*it, *next, choice)) next = it;
+        ranked.push_back(*next);
+        others.erase(next);
+    }
+    if (ranked.size() == 1) return best;
+
+#ifdef MULTITHREAD
+    {
+        std::lock_guard<std::mutex> guard(res_mutex);
+        scores.assign(ranked.size(), 0);
+        exe_req = 0;
+    }
+    {
+        std::lock_guard<std::mutex> guard(queue_mutex);
+        for (size_t i = 0; i < ranked.size(); i++)
+            work_queue.push({static_cast<int>(i), ranked[i]});
+        queue_CV.notify_all();
+    }
+    {
+        std::unique_lock<std::mutex> guard(res_mutex);
+        res_CV.wait(guard, [&] { return exe_req == static_cast<int>(ranked.size()); });
+    }
+#else
+    std::vector<int> scores;
+    for (auto *cand : ranked) scores.push_back(tables_in_stage(cand));
+#endif
+
+    size_t selected = 0;
+    for (size_t i = 0; i < ranked.size(); i++) {
+        LOG3("    Speculative stage " << best->stage << " starting with " << ranked[i]->name
+                                      << " fits " << scores[i] << " tables");
+        if (scores[i] > scores[selected]) selected = i;
+    }
+    if (selected != 0)
+        LOG3("    Updating best to " << ranked[selected]->name << " from " << best->name
+                                     << " for a fuller speculative stage");
+    return ranked[selected];
+}
+
 /* This class encapsulate most of the high level backtracking services. Backtracking is used
  * mainly for:
  * 1 - Find an alternative solution to workaround a dependency problem
@@ -4345,6 +4539,7 @@ const DecidePlacement::Placed *DecidePlacement::default_table_placement(const IR
 #ifdef MULTITHREAD
     TryPlacedPool placed_pool(*this, jobs);
 #endif
+    SpeculativePlacement speculation(*this, self.options.table_placement_lookahead);
     while (true) {
         // Empty work means that all the tables are actually placed. Save it as a complete
         // placement for future comparison.
@@ -4366,6 +4561,7 @@ const DecidePlacement::Placed *DecidePlacement::default_table_placement(const IR
 #ifdef MULTITHREAD
         placed_pool.cleanup();
 #endif
+        speculation.clear();
         for (auto it = work.begin(); it != work.end();) {
             // DANGER -- we iterate over the work queue while possibly removing and
             // appending groups.  So care is required to not invalidate the iterator
@@ -4495,6 +4691,7 @@ const DecidePlacement::Placed *DecidePlacement::default_table_placement(const IR
 
                 // Now skip attempting to place this table if this flag was set at all
                 if (should_skip) continue;
+                speculation.addReq(t, gmc);
 #ifdef MULTITHREAD
                 placed_pool.addReq(t, placed, current, gmc, grp);
                 done = false;
@@ -4563,6 +4760,7 @@ const DecidePlacement::Placed *DecidePlacement::default_table_placement(const IR
                 self.reject_placement(t, choice, best);
             }
         }
+        best = speculation.select(best, trial);
 
         if (bt_mgmt.update_bt_point(best, trial)) continue;
 
@@ -4670,6 +4868,7 @@ bool DecidePlacement::preorder(const IR::BFN::Pipe *pipe) {
 
     const Placed *placed = nullptr;
     self.success = true;
+    warm_start = WarmStart::get(pipe->canon_id());
     if (self.summary.is_table_replay()) {
         std::tie(self.success, placed) = alt_table_placement(pipe);
     } else {
@@ -4870,6 +5069,7 @@ std::ostream &operator<<(std::ostream &out, TablePlacement::choice_t choice) {
         "more stages needed",
         "completes more shared tables",
         "user-provided priority",
+        "earlier stage in the warm start placement",
         "longer downward prop control-included dependence tail chain",
         "longer local control-included dependence tail chain",
         "longer control-excluded dependence tail chain",
@@ -29,6 +29,7 @@
 #include <map>
 
 #include "backends/tofino/bf-p4c/backend.h"
+#include "backends/tofino/bf-p4c/common/warm_start.h"
 #include "backends/tofino/bf-p4c/mau/dynamic_dep_metrics.h"
 #include "backends/tofino/bf-p4c/mau/mau_visitor.h"
 #include "backends/tofino/bf-p4c/mau/resource.h"
@@ -131,6 +132,7 @@ class TablePlacement : public PassManager {
         NEED_MORE,
         SHARED_TABLES,
         PRIORITY,
+        WARM_START,
         DOWNWARD_PROP_DSC,
         LOCAL_DSC,
         LOCAL_DS,
@@ -228,6 +230,7 @@ class DecidePlacement : public MauInspector {
 #ifdef MULTITHREAD
     class TryPlacedPool;
 #endif
+    class SpeculativePlacement;
     class BacktrackManagement;
     explicit DecidePlacement(TablePlacement &s);
 
@@ -241,6 +244,7 @@ class DecidePlacement : public MauInspector {
     int backtrack_count = 0;  // number of times backtracked in this pipe
     int MaxBacktracksPerPipe = 32;
     bool resource_mode = false;
+    const WarmStart *warm_start = nullptr;  // placement of the previous compile, if any
     std::map<cstring, std::set<int>> bt_attempts;
     void savePlacement(const Placed *, const ordered_set<const GroupPlace *> &, bool);
     void recomputePartlyPlaced(const Placed *, ordered_set<const IR::MAU::Table *> &);
@@ -112,6 +112,7 @@
 #include "backends/tofino/bf-p4c/mau/table_flow_graph.h"
 #include "backends/tofino/bf-p4c/midend/type_checker.h"
 #include "backends/tofino/bf-p4c/parde/parser_header_sequences.h"
+#include "backends/tofino/bf-p4c/preflight.h"
 #include "frontends/common/constantFolding.h"
 #include "frontends/p4-14/header_type.h"
 #include "frontends/p4-14/typecheck.h"
@@ -611,6 +612,13 @@ int main(int ac, char **av) {
                 }
             }
 
+            if (options.preflight) {
+                LOG3("Estimating resources for pipe : " << pipe->canon_name());
+                BFN::Preflight preflight(options);
+                pipe->apply(preflight);
+                continue;
+            }
+
             LOG3("Executing backend for pipe : " << pipe->canon_name());
             EventLogger::get().pipeChange(pipe->canon_id());
             execute_backend(pipe, options);
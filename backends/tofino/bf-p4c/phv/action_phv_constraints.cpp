@@ -28,6 +28,7 @@
 #include "backends/tofino/bf-p4c/common/scc_toposort.h"
 #include "backends/tofino/bf-p4c/ir/bitrange.h"
 #include "backends/tofino/bf-p4c/phv/cluster_phv_operations.h"
+#include "backends/tofino/bf-p4c/phv/field_table.h"
 #include "backends/tofino/bf-p4c/phv/phv.h"
 #include "backends/tofino/bf-p4c/phv/phv_fields.h"
 #include "backends/tofino/bf-p4c/phv/solver/action_constraint_solver.h"
@@ -698,20 +699,24 @@ void ActionPhvConstraints::dest_first_sort(
 }
 
 void ActionPhvConstraints::determine_same_byte_fields() {
-    ordered_map<const PHV::Field *, le_bitrange> header_bytes;
-    for (const auto &f : phv) {
-        if (f.metadata || f.pov) continue;
-        le_bitrange hdr_byte_range = f.byteAlignedRangeInBits();
-        LOG7("\t  Range for " << f.name << " : " << hdr_byte_range);
-        for (auto kv : header_bytes) {
-            if (kv.first->header() != f.header()) continue;
-            if (kv.second.overlaps(hdr_byte_range)) {
-                LOG6("\t" << kv.first->name << " and " << f.name << " share a byte");
-                same_byte_fields[kv.first].insert(&f);
-                same_byte_fields[&f].insert(kv.first);
+    // Only fields of the same header can share a byte, so each field is only compared with
+    // the fields of its own header that come before it.
+    PHV::FieldTable fields(phv);
+    for (int id = 0; id < fields.size(); ++id) {
+        const auto *f = fields.field(id);
+        if (!f || fields.is(id, PHV::FieldTable::METADATA | PHV::FieldTable::POV)) continue;
+        le_bitrange hdr_byte_range = fields.byteAlignedRangeInBits(id);
+        LOG7("\t  Range for " << f->name << " : " << hdr_byte_range);
+        for (int other : fields.header_fields(fields.header(id))) {
+            if (other >= id) break;
+            if (fields.is(other, PHV::FieldTable::METADATA | PHV::FieldTable::POV)) continue;
+            if (fields.byteAlignedRangeInBits(other).overlaps(hdr_byte_range)) {
+                const auto *g = fields.field(other);
+                LOG6("\t" << g->name << " and " << f->name << " share a byte");
+                same_byte_fields[g].insert(f);
+                same_byte_fields[f].insert(g);
             }
         }
-        header_bytes[&f] = hdr_byte_range;
     }
 }
 
@@ -18,6 +18,11 @@
 
 #include "backends/tofino/bf-p4c/phv/allocate_phv.h"
 
+#ifdef MULTITHREAD
+#include <exception>
+#include <mutex>
+#endif
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 
@@ -31,6 +36,7 @@
 #include "backends/tofino/bf-p4c/device.h"
 #include "backends/tofino/bf-p4c/ir/bitrange.h"
 #include "backends/tofino/bf-p4c/ir/gress.h"
+#include "backends/tofino/bf-p4c/lib/parallel_for.h"
 #include "backends/tofino/bf-p4c/logging/event_logger.h"
 #include "backends/tofino/bf-p4c/parde/clot/clot_info.h"
 #include "backends/tofino/bf-p4c/parde/parser_query.h"
@@ -57,6 +63,13 @@
 const std::vector<PHV::Size> StateExtractUsage::extractor_sizes = {PHV::Size::b8, PHV::Size::b16,
                                                                    PHV::Size::b32};
 
+#ifdef MULTITHREAD
+/// Serializes the few places where allocation strategies running concurrently in
+/// AllocatePHV::brute_force_alloc write to state they share: the zero containers recorded in
+/// PhvInfo and the redirection of the log to the allocation history file.
+static std::mutex portfolio_shared_state;
+#endif
+
 // AllocScore metrics.
 namespace {
 
@@ -645,7 +658,7 @@ PHV::Slicing::IteratorInterface *PHV::AllocUtils::make_slicing_ctx(
         *parser_packing_validator,
         boost::bind(&AllocUtils::has_pack_conflict, this, boost::placeholders::_1,
                     boost::placeholders::_2),
-        boost::bind(&AllocUtils::is_referenced, this, boost::placeholders::_1));
+        boost::bind(&AllocUtils::is_referenced, this, boost::placeholders::_1), &slicing_cache);
 }
 
 bool PHV::AllocUtils::can_physical_liverange_be_overlaid(const PHV::AllocSlice &a,
@@ -2879,10 +2892,25 @@ std::optional<PHV::Transaction> CoreAllocation::tryAllocSliceList(
         return std::nullopt;
     }
 
+    // With --warm-start, try the container of the previous compile first. It is kept without
+    // looking further if the slices land on the same bits as in the previous compile.
+    std::vector<PHV::Container> containers(group.begin(), group.end());
+    std::optional<PHV::Container> warm_container;
+    if (utils_i.warm_start && !slices.empty()) {
+        const auto &first = slices.front();
+        warm_container = utils_i.warm_start->container(first.field(), first.range().lo);
+        auto it = warm_container ? std::find(containers.begin(), containers.end(), *warm_container)
+                                 : containers.end();
+        if (it != containers.end())
+            std::rotate(containers.begin(), it, it + 1);
+        else
+            warm_container = std::nullopt;
+    }
+
     // Look for a container to allocate all slices in.
     AllocScore best_score = AllocScore::make_lowest();
     std::optional<PHV::Transaction> best_candidate = std::nullopt;
-    for (const PHV::Container &c : group) {
+    for (const PHV::Container &c : containers) {
         LOG_FEATURE("alloc_progress", 5, "Trying to allocate to " << c);
         if (auto equivalent_c = cet.find_equivalent_tried_container(c)) {
             LOG_FEATURE("alloc_progress", 5,
@@ -3172,12 +3200,20 @@ std::optional<PHV::Transaction> CoreAllocation::tryAllocSliceList(
         LOG_FEATURE("alloc_progress", 5,
                     TAB1 "SLICE LIST score for container " << c << ": " << score);
 
+        bool warm_start_hit = c == warm_container &&
+                              std::all_of(candidate_slices.begin(), candidate_slices.end(),
+                                          [&](const PHV::AllocSlice &slice) {
+                                              return utils_i.warm_start->matches(slice);
+                                          });
+
         // update the best
-        if ((!best_candidate || score_ctx.is_better(score, best_score))) {
-            LOG_FEATURE("alloc_progress", 5, TAB2 "Best score for container " << c);
+        if (warm_start_hit || !best_candidate || score_ctx.is_better(score, best_score)) {
+            LOG_FEATURE("alloc_progress", 5,
+                        TAB2 "Best score for container "
+                            << c << (warm_start_hit ? " (warm start)" : ""));
             best_score = score;
             best_candidate = std::move(perContainerAlloc);
-            if (score_ctx.stop_at_first()) {
+            if (warm_start_hit || score_ctx.stop_at_first()) {
                 break;
             }
         }
@@ -4081,6 +4117,111 @@ static void log_device_stats() {
     LOG_DEBUG3("Egress  only: " << numEgress);
 }
 
+namespace {
+
+/// A config of the brute force allocation together with its outcome, run as part of a
+/// portfolio by AllocatePHV::brute_force_alloc. The result stays empty if the config was never
+/// run because an earlier config already concluded the search.
+struct PortfolioEntry {
+    cstring name;
+    BruteForceAllocationStrategy *strategy;
+    std::optional<AllocResult> result;
+    std::atomic<bool> cancel{false};
+#ifdef MULTITHREAD
+    std::exception_ptr exception;
+#endif
+
+    PortfolioEntry(cstring name, BruteForceAllocationStrategy *strategy)
+        : name(name), strategy(strategy) {
+        strategy->set_cancel_flag(&cancel);
+    }
+};
+
+/// A config that succeeds or proves the constraints unsatisfiable makes the configs after it
+/// irrelevant.
+bool concludes_search(const AllocResult &result) {
+    return result.status == AllocResultCode::SUCCESS ||
+           result.status == AllocResultCode::FAIL_UNSAT_SLICING;
+}
+
+#ifdef MULTITHREAD
+struct PortfolioRun {
+    std::vector<PortfolioEntry *> &entries;
+    const PHV::Allocation &alloc;
+    const std::list<PHV::SuperCluster *> &cluster_groups;
+    const std::list<PHV::ContainerGroup *> &container_groups;
+    /// The next entry to be picked up by a worker; entries are handed out in config order.
+    std::atomic<size_t> next{0};
+};
+
+void portfolio_worker(PortfolioRun *run) {
+    auto &entries = run->entries;
+    for (size_t index = run->next++; index < entries.size(); index = run->next++) {
+        auto *entry = entries[index];
+        if (entry->cancel) continue;
+        try {
+            entry->result.emplace(entry->strategy->tryAllocation(run->alloc, run->cluster_groups,
+                                                                 run->container_groups));
+            // Configs later in the list can no longer be picked, stop them.
+            if (concludes_search(*entry->result))
+                for (size_t i = index + 1; i < entries.size(); i++) entries[i]->cancel = true;
+        } catch (...) {
+            entry->exception = std::current_exception();
+            for (size_t i = index + 1; i < entries.size(); i++) entries[i]->cancel = true;
+        }
+    }
+}
+#endif
+
+/** Run the strategies of @p entries on @p alloc. Without MULTITHREAD, or with @p jobs set to
+ * 1, they are run one after another until one concludes the search. Otherwise they are handed
+ * out in order to @p jobs threads (one per entry if @p jobs is 0) and the later ones are
+ * cancelled as soon as an earlier one concludes the search, so the entries that matter to the
+ * caller, i.e. up to the first one that concludes, hold the same results as in a sequential
+ * run.
+ *
+ * The strategies only read the IR, the parent allocation and the superclusters, and
+ * allocate into their own transactions. The state they share is either pre-computed here or
+ * guarded by portfolio_shared_state. As with table placement, the garbage collector lock
+ * serializes a good part of the work, the gain comes from programs where each config spends
+ * most of its time scoring slicings.
+ */
+void run_portfolio(std::vector<PortfolioEntry *> &entries, const PHV::AllocUtils &utils,
+                   const PHV::Allocation &alloc,
+                   const std::list<PHV::SuperCluster *> &cluster_groups,
+                   const std::list<PHV::ContainerGroup *> &container_groups, int jobs) {
+#ifdef MULTITHREAD
+    size_t threads = jobs > 0 ? std::min<size_t>(jobs, entries.size()) : entries.size();
+    if (threads > 1) {
+        // Fill the lazily computed cache of the parent allocation before it is shared.
+        alloc.getParserStateToContainers(utils.phv, utils.field_to_parser_states);
+
+        PortfolioRun run{entries, alloc, cluster_groups, container_groups};
+        std::function<void()> worker = [&run] { portfolio_worker(&run); };
+        std::vector<pthread_t> workers;
+        for (size_t i = 0; i < threads; i++) workers.push_back(BFN::start_gc_thread(worker));
+        for (auto tid : workers) pthread_join(tid, NULL);
+
+        // Report errors in config order, as a sequential run would have.
+        for (auto *entry : entries) {
+            if (entry->exception) std::rethrow_exception(entry->exception);
+            if (entry->result && concludes_search(*entry->result)) break;
+        }
+        return;
+    }
+#else
+    (void)utils;
+    (void)jobs;
+#endif
+    for (auto *entry : entries) {
+        entry->result.emplace(entry->strategy->tryAllocation(alloc, cluster_groups,
+                                                             container_groups));
+        if (concludes_search(*entry->result)) break;
+    }
+}
+
+}  // namespace
+
 AllocResult AllocatePHV::brute_force_alloc(
     PHV::ConcreteAllocation &alloc, PHV::ConcreteAllocation &empty_alloc,
     std::vector<const PHV::SuperCluster::SliceList *> &unallocatable_lists,
@@ -4121,30 +4262,55 @@ AllocResult AllocatePHV::brute_force_alloc(
         configs.push_back(no_ara_config);
     }
 
-    AllocResult result(AllocResultCode::UNKNOWN, alloc.makeTransaction(), {});
+    std::vector<const BruteForceStrategyConfig *> supported_configs;
     for (const auto &config : configs) {
         if (config.unsupported_devices &&
             config.unsupported_devices->count(Device::currentDevice())) {
             continue;
         }
-        PhvInfo::darkSpillARA = PhvInfo::darkSpillARA && config.enable_ara_in_overlays;
+        supported_configs.push_back(&config);
+    }
 
-        BruteForceAllocationStrategy *strategy = new BruteForceAllocationStrategy(
-            config.name, utils_i, core_alloc_i, empty_alloc, config, pipe_id, phv_i);
-        result = strategy->tryAllocation(alloc, cluster_groups, container_groups);
-        if (result.status == AllocResultCode::SUCCESS) {
-            break;
-        } else if (result.status == AllocResultCode::FAIL_UNSAT_SLICING) {
-            LOG_FEATURE("alloc_progress", 5, "Failed: Constraints not satisfied, stopping");
-            break;
-        } else {
-            LOG_FEATURE("alloc_progress", 5,
-                        "Failed: PHV allocation with " << config.name << " config");
-            if (strategy->get_unallocatable_list()) {
-                unallocatable_lists.push_back(*(strategy->get_unallocatable_list()));
-                LOG_FEATURE(
-                    "alloc_progress", 5,
-                    TAB1 "Possibly unallocatable slice list: " << unallocatable_lists.back());
+    AllocResult result(AllocResultCode::UNKNOWN, alloc.makeTransaction(), {});
+    bool concluded = false;
+    size_t next = 0;
+    while (!concluded && next < supported_configs.size()) {
+        // PhvInfo::darkSpillARA is global, so only the configs that see the same value of it
+        // can be run as one portfolio.
+        PhvInfo::darkSpillARA =
+            PhvInfo::darkSpillARA && supported_configs[next]->enable_ara_in_overlays;
+        std::vector<PortfolioEntry *> portfolio;
+        do {
+            const auto &config = *supported_configs[next++];
+            auto *strategy = new BruteForceAllocationStrategy(
+                config.name, utils_i, core_alloc_i, empty_alloc, config, pipe_id, phv_i);
+            portfolio.push_back(new PortfolioEntry(config.name, strategy));
+        } while (next < supported_configs.size() &&
+                 (PhvInfo::darkSpillARA && supported_configs[next]->enable_ara_in_overlays) ==
+                     PhvInfo::darkSpillARA);
+
+        run_portfolio(portfolio, utils_i, alloc, cluster_groups, container_groups,
+                      BackendOptions().phv_alloc_jobs);
+
+        for (auto *entry : portfolio) {
+            auto *strategy = entry->strategy;
+            result = std::move(*entry->result);
+            if (result.status == AllocResultCode::SUCCESS) {
+                concluded = true;
+                break;
+            } else if (result.status == AllocResultCode::FAIL_UNSAT_SLICING) {
+                LOG_FEATURE("alloc_progress", 5, "Failed: Constraints not satisfied, stopping");
+                concluded = true;
+                break;
+            } else {
+                LOG_FEATURE("alloc_progress", 5,
+                            "Failed: PHV allocation with " << entry->name << " config");
+                if (strategy->get_unallocatable_list()) {
+                    unallocatable_lists.push_back(*(strategy->get_unallocatable_list()));
+                    LOG_FEATURE(
+                        "alloc_progress", 5,
+                        TAB1 "Possibly unallocatable slice list: " << unallocatable_lists.back());
+                }
             }
         }
     }
@@ -4208,6 +4374,13 @@ const IR::Node *AllocatePHV::apply_visitor(const IR::Node *root_, const char *)
 
     int pipeId = root->canon_id();
 
+    // Inputs of the slicing iterator may have changed since the last round, only keep the
+    // slicing hints that stay valid.
+    utils_i.slicing_cache.new_epoch();
+    auto slicing_cache_file = BackendOptions().phv_slicing_cache;
+    if (slicing_cache_file) utils_i.slicing_cache.load(slicing_cache_file);
+    utils_i.warm_start = WarmStart::get(pipeId);
+
     // Make sure that fields are not marked as mutex with itself.
     for (const auto &field : phv_i) {
         BUG_CHECK(!utils_i.mutex()(field.id, field.id), "Field %1% can be overlaid with itself.",
@@ -4238,6 +4411,7 @@ const IR::Node *AllocatePHV::apply_visitor(const IR::Node *root_, const char *)
     result = brute_force_alloc(*alloc, empty_alloc, unallocatable_lists, cluster_groups,
                                container_groups, pipeId);
     alloc->commit(result.transaction);
+    if (slicing_cache_file) utils_i.slicing_cache.save(slicing_cache_file);
 
     bool allocationDone = (result.status == AllocResultCode::SUCCESS);
     if (allocationDone) {
@@ -4683,7 +4857,12 @@ std::optional<PHV::Transaction> CoreAllocation::try_deparser_zero_alloc(
                     PHV::AllocSlice(utils_i.phv.field(slice.field()->id), zero[slice.gress()],
                                     field_slice, container_slice);
                 candidate_slices.push_back(alloc_slice);
-                phv.addZeroContainer(slice.gress(), zero[slice.gress()]);
+                {
+#ifdef MULTITHREAD
+                    std::lock_guard<std::mutex> guard(portfolio_shared_state);
+#endif
+                    phv.addZeroContainer(slice.gress(), zero[slice.gress()]);
+                }
                 slice_list_offset += alloc_slice_width;
             }
             for (auto &alloc_slice : candidate_slices)
@@ -4912,7 +5091,7 @@ AllocResult BruteForceAllocationStrategy::tryAllocationFailuresFirst(
     auto allocated_clusters = allocLoop(rst, cluster_groups, container_groups, score_ctx);
 
     // Pounder Round
-    if (cluster_groups.size() > 0) {
+    if (cluster_groups.size() > 0 && !cancelled()) {
         LOG_DEBUG5(cluster_groups.size()
                    << " superclusters are unallocated before Pounder Round, they are:");
         for (auto *sc : cluster_groups) {
@@ -4943,7 +5122,7 @@ AllocResult BruteForceAllocationStrategy::tryAllocation(
     cstring log_prefix = "allocation("_cs + name + "): "_cs;
     bool succ = false;
     int max_try = config_i.max_failure_retry + 1;
-    for (int i = 0; i < max_try; i++) {
+    for (int i = 0; i < max_try && !cancelled(); i++) {
         LOG_DEBUG1(log_prefix << "Try allocation for the " << i + 1 << "th time");
         if (failed.size() > 0) {
             LOG_DEBUG1(TAB1 "Try again with failures prioritized");
@@ -4988,6 +5167,7 @@ void BruteForceAllocationStrategy::sortClusters(std::list<PHV::SuperCluster *> &
     std::map<const PHV::SuperCluster *, int> n_extracted_uninitialized;
     std::map<const PHV::SuperCluster *, size_t> n_container_size_pragma;
     std::set<const PHV::SuperCluster *> has_container_type_pragma;
+    std::map<const PHV::SuperCluster *, size_t> n_pack_conflicts;
 
     // calc whether the cluster has pov bits.
     for (auto *cluster : cluster_groups) {
@@ -5016,8 +5196,13 @@ void BruteForceAllocationStrategy::sortClusters(std::list<PHV::SuperCluster *> &
         n_container_size_pragma[cluster] = fields.size();
     }
 
-    // calc num_pack_conflicts
-    for (auto *super_cluster : cluster_groups) super_cluster->calc_pack_conflicts();
+    // calc n_pack_conflicts.
+    for (auto *cluster : cluster_groups) {
+        n_pack_conflicts[cluster] = 0;
+        cluster->forall_fieldslices([&](const PHV::FieldSlice &fs) {
+            n_pack_conflicts[cluster] += fs.field()->num_pack_conflicts();
+        });
+    }
 
     // calc n_extracted_uninitialized
     for (auto *cluster : cluster_groups) {
@@ -5200,8 +5385,8 @@ void BruteForceAllocationStrategy::sortClusters(std::list<PHV::SuperCluster *> &
             if (n_extracted_uninitialized[l] != n_extracted_uninitialized[r]) {
                 return n_extracted_uninitialized[l] > n_extracted_uninitialized[r];
             }
-            if (l->num_pack_conflicts() != r->num_pack_conflicts()) {
-                return l->num_pack_conflicts() > r->num_pack_conflicts();
+            if (n_pack_conflicts[l] != n_pack_conflicts[r]) {
+                return n_pack_conflicts[l] > n_pack_conflicts[r];
             }
             if (l->aggregate_size() != r->aggregate_size()) {
                 return l->aggregate_size() > r->aggregate_size();
@@ -5232,7 +5417,7 @@ void BruteForceAllocationStrategy::sortClusters(std::list<PHV::SuperCluster *> &
             logs << "is_pounderable: " << pounder_clusters.count(v) << ", ";
             logs << "required_length: " << n_required_length[v] << ", ";
             logs << "n_valid_starts: " << n_valid_starts[v] << ", ";
-            logs << "n_pack_conflicts: " << v->num_pack_conflicts() << ", ";
+            logs << "n_pack_conflicts: " << n_pack_conflicts[v] << ", ";
             logs << "n_extracted_uninitialized: " << n_extracted_uninitialized[v] << ", ";
             logs << "]\n";
             logs << v;
@@ -5688,6 +5873,10 @@ std::list<PHV::SuperCluster *> BruteForceAllocationStrategy::allocLoop(
     BruteForceOptimizationStrategy opt_strategy(*this, container_groups, score_ctx);
     PHV::Transaction try_alloc = rst.makeTransaction();
     for (PHV::SuperCluster *cluster_group : cluster_groups) {
+        if (cancelled()) {
+            LOG_FEATURE("alloc_progress", 4, "Cancelled: config " << config_i.name);
+            break;
+        }
         n++;
         alloc_history << n << ": " << "TRYING to allocate " << cluster_group;
         LOG_FEATURE("alloc_progress", 4, "TRYING to allocate " << cluster_group);
@@ -5710,10 +5899,15 @@ std::list<PHV::SuperCluster *> BruteForceAllocationStrategy::allocLoop(
     // while iterating, but `it = clusters_i.erase(it)` skips elements.
     for (auto cluster_group : allocated) cluster_groups.remove(cluster_group);
 
-    auto logfile = createFileLog(pipe_id_i, "phv_allocation_history_"_cs, 1);
-    LOG1("Allocation history of config " << config_i.name);
-    LOG1(alloc_history.str());
-    Logging::FileLog::close(logfile);
+    {
+#ifdef MULTITHREAD
+        std::lock_guard<std::mutex> guard(portfolio_shared_state);
+#endif
+        auto logfile = createFileLog(pipe_id_i, "phv_allocation_history_"_cs, 1);
+        LOG1("Allocation history of config " << config_i.name);
+        LOG1(alloc_history.str());
+        Logging::FileLog::close(logfile);
+    }
 
     if (cluster_groups.empty()) {
         // PHV Allocation succeed, no need to do any more steps
@@ -19,10 +19,12 @@
 #ifndef BACKENDS_TOFINO_BF_P4C_PHV_ALLOCATE_PHV_H_
 #define BACKENDS_TOFINO_BF_P4C_PHV_ALLOCATE_PHV_H_
 
+#include <atomic>
 #include <optional>
 #include <sstream>
 
 #include "backends/tofino/bf-p4c/common/field_defuse.h"
+#include "backends/tofino/bf-p4c/common/warm_start.h"
 #include "backends/tofino/bf-p4c/ir/bitrange.h"
 #include "backends/tofino/bf-p4c/ir/gress.h"
 #include "backends/tofino/bf-p4c/parde/clot/clot_info.h"
@@ -40,6 +42,7 @@
 #include "backends/tofino/bf-p4c/phv/phv_fields.h"
 #include "backends/tofino/bf-p4c/phv/phv_parde_mau_use.h"
 #include "backends/tofino/bf-p4c/phv/pragma/phv_pragmas.h"
+#include "backends/tofino/bf-p4c/phv/slicing/phv_slicing_cache.h"
 #include "backends/tofino/bf-p4c/phv/slicing/types.h"
 #include "backends/tofino/bf-p4c/phv/table_phv_constraints.h"
 #include "backends/tofino/bf-p4c/phv/utils/slice_alloc.h"
@@ -92,6 +95,13 @@ class AllocUtils {
     // Collect field packing that table/ixbar would benefit from.
     const TableFieldPackOptimization &tablePackOpt;
 
+    // Outcomes of slicing searches, reused across allocation attempts and rounds of table
+    // placement. Mutable because searching is a const operation of AllocUtils.
+    mutable Slicing::SlicingCache slicing_cache;
+
+    // Allocation of the previous compile (--warm-start), nullptr if there is none.
+    mutable const WarmStart *warm_start = nullptr;
+
     AllocUtils(const PhvInfo &phv, const ClotInfo &clot, const Clustering &clustering,
                const PhvUse &uses, const FieldDefUse &defuse, const ActionPhvConstraints &actions,
                const LiveRangeShrinking &meta_init, const DarkOverlay &dark_init,
@@ -699,6 +709,8 @@ class BruteForceAllocationStrategy : public AllocationStrategy {
     std::optional<const PHV::SuperCluster::SliceList *> unallocatable_list_i;
     int pipe_id_i;   /// used for logging purposes
     PhvInfo &phv_i;  // mutable because of deparsed zero allocation.
+    /// Set when a strategy racing this one has already decided the allocation.
+    const std::atomic<bool> *cancel_i = nullptr;
 
  public:
     BruteForceAllocationStrategy(const cstring name, const PHV::AllocUtils &utils,
@@ -715,6 +727,11 @@ class BruteForceAllocationStrategy : public AllocationStrategy {
 
     int getPipeId() const { return pipe_id_i; }
 
+    /// Make the allocation loops give up early once @p flag is set. The partial result of a
+    /// cancelled strategy is reported as a failure and must be discarded by the caller.
+    void set_cancel_flag(const std::atomic<bool> *flag) { cancel_i = flag; }
+    bool cancelled() const { return cancel_i && cancel_i->load(std::memory_order_relaxed); }
+
  protected:
     AllocResult tryAllocationFailuresFirst(
         const PHV::Allocation &alloc, const std::list<PHV::SuperCluster *> &cluster_groups_input,
@@ -835,7 +852,9 @@ class AllocatePHV : public Visitor {
      */
     static bool diagnoseSuperCluster(const PHV::SuperCluster *sc, const PHV::AllocUtils &utils);
 
-    /// use brute force strategy to allocate.
+    /// use brute force strategy to allocate. Configs that share the same dark spilling
+    /// setting are run concurrently when the compiler is built with MULTITHREAD, and the
+    /// first one in config order that concludes the search wins, as in a sequential run.
     AllocResult brute_force_alloc(
         PHV::ConcreteAllocation &alloc, PHV::ConcreteAllocation &empty_alloc,
         std::vector<const PHV::SuperCluster::SliceList *> &unallocatable_lists,
@@ -18,6 +18,10 @@
 
 #include "backends/tofino/bf-p4c/phv/analysis/build_mutex.h"
 
+#include <vector>
+
+#include "backends/tofino/bf-p4c/lib/parallel_for.h"
+
 Visitor::profile_t BuildMutex::init_apply(const IR::Node *root) {
     auto rv = Inspector::init_apply(root);
     mutually_inclusive.clear();
@@ -66,39 +70,48 @@ void BuildMutex::flow_copy(::ControlFlowVisitor &other_) {
 }
 
 void BuildMutex::end_apply() {
-    LOG4("mutually exclusive fields:");
-    for (auto it1 = fields_encountered.begin(); it1 != fields_encountered.end(); ++it1) {
-        const PHV::Field *f1 = phv.field(*it1);
-        CHECK_NULL(f1);
-        if (neverOverlay[*it1]) {
-            if (f1->overlayable) {
-                warning("Ignoring pa_no_overlay for padding field %1%", f1->name);
+    // Fields marked neverOverlay are mutually inclusive with every other field, unless they
+    // are padding.
+    bitvec candidates;
+    for (int id : fields_encountered) {
+        const PHV::Field *f = phv.field(id);
+        CHECK_NULL(f);
+        if (neverOverlay[id]) {
+            if (f->overlayable) {
+                warning("Ignoring pa_no_overlay for padding field %1%", f->name);
             } else {
-                LOG5("Excluding field from overlay: " << phv.field(*it1));
+                LOG5("Excluding field from overlay: " << f);
                 continue;
             }
         }
-        for (auto it2 = it1; it2 != fields_encountered.end(); ++it2) {
-            if (*it1 == *it2) continue;
-
-            // Consider fields marked neverOverlay to always be mutually inclusive.
-            const PHV::Field *f2 = phv.field(*it2);
-            CHECK_NULL(f2);
-            if (neverOverlay[*it2]) {
-                if (f2->overlayable) {
-                    warning("Ignoring pa_no_overlay for padding field %1%", f2->name);
-                } else {
-                    LOG5("Excluding field from overlay: " << phv.field(*it2));
-                    continue;
-                }
-            }
-
-            if (!pragma.can_overlay(f1, f2)) continue;
+        candidates[id] = true;
+    }
 
-            if (mutually_inclusive(*it1, *it2)) continue;
+    // Row i holds the candidates with a lower id than ids[i] that can be overlaid with it.
+    // The rows only read the analysis results, so they are computed concurrently and written
+    // to the matrix afterwards, in id order.
+    std::vector<int> ids;
+    for (int id : candidates) ids.push_back(id);
+    std::vector<bitvec> rows(ids.size());
+    const SymBitMatrix &inclusive = mutually_inclusive;
+    BFN::parallel_for(ids.size(), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            const PHV::Field *f1 = phv.field(ids[i]);
+            bitvec row = candidates.getslice(0, ids[i]);
+            row -= bitvec(inclusive[ids[i]]);
+            bitvec no_overlay;
+            for (int id2 : row)
+                if (!pragma.can_overlay(f1, phv.field(id2))) no_overlay[id2] = true;
+            rows[i] = row - no_overlay;
+        }
+    });
 
-            mutually_exclusive(*it1, *it2) = true;
-            LOG4("(" << f1->name << ", " << f2->name << ")");
+    LOG4("mutually exclusive fields:");
+    for (size_t i = 0; i < ids.size(); ++i) {
+        mutually_exclusive[ids[i]] |= rows[i];
+        if (LOGGING(4)) {
+            for (int id2 : rows[i])
+                LOG4("(" << phv.field(id2)->name << ", " << phv.field(ids[i])->name << ")");
         }
     }
 }
@@ -19,6 +19,7 @@
 #include "backends/tofino/bf-p4c/phv/analysis/header_mutex.h"
 
 #include <optional>
+#include <vector>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/dominator_tree.hpp>
@@ -26,6 +27,7 @@
 #include <boost/graph/reverse_graph.hpp>
 
 #include "backends/tofino/bf-p4c/common/table_printer.h"
+#include "backends/tofino/bf-p4c/lib/parallel_for.h"
 #include "backends/tofino/bf-p4c/logging/event_logger.h"
 
 cstring get_header_state_as_cstring(HeaderState header_state) {
@@ -161,15 +163,17 @@ void AddParserHeadersToHeaderMutexMatrix::flow_copy(::ControlFlowVisitor &other_
 
 void AddParserHeadersToHeaderMutexMatrix::end_apply() {
     LOG4("mutually exclusive headers:");
-    for (auto it1 = headers_encountered.begin(); it1 != headers_encountered.end(); ++it1) {
-        for (auto it2 = it1; it2 != headers_encountered.end(); ++it2) {
-            if (*it1 == *it2) continue;
-            if (mutually_inclusive_headers(*it1, *it2)) continue;
-
-            header_info.mutually_exclusive_headers(*it1, *it2) = true;
-            auto header1 = header_info.get_header_name(*it1);
-            auto header2 = header_info.get_header_name(*it2);
-            LOG4(TAB1 << "(" << header1 << ", " << header2 << ")");
+    for (int h2 : headers_encountered) {
+        // Encountered headers with a lower index than h2 that are never live together with it.
+        bitvec row = headers_encountered.getslice(0, h2);
+        row -= bitvec(mutually_inclusive_headers[h2]);
+        header_info.mutually_exclusive_headers[h2] |= row;
+        if (LOGGING(4)) {
+            for (int h1 : row) {
+                auto header1 = header_info.get_header_name(h1);
+                auto header2 = header_info.get_header_name(h2);
+                LOG4(TAB1 << "(" << header1 << ", " << header2 << ")");
+            }
         }
     }
     header_info.print_mutually_exclusive_headers();
@@ -294,35 +298,39 @@ Visitor::profile_t AddMauHeadersToHeaderMutexMatrix::init_apply(const IR::Node *
     return rv;
 }
 
-/**
- * @brief Check if two headers have any mutually exclusive PHV fields.
- */
-bool RemoveHeaderMutexesIfAllFieldsNotMutex::have_mutually_exclusive_fields(cstring header1,
-                                                                            cstring header2) {
-    ordered_set<const PHV::Field *> header1_fields;
-    ordered_set<const PHV::Field *> header2_fields;
-    phv.get_hdr_fields(header1, header1_fields);
-    phv.get_hdr_fields(header2, header2_fields);
-    for (const auto &field1 : header1_fields) {
-        for (const auto &field2 : header2_fields) {
-            if (phv.isFieldMutex(field1, field2)) return true;
-        }
-    }
-
-    return false;
-}
-
 /**
  * @brief If two headers have no mutually exclusive fields, remove the header level mutex from the
  * header mutual exclusivity matrix.
+ *
+ * Two headers have mutually exclusive fields if the union of the field mutex rows of the fields of
+ * one header intersects the fields of the other.  The unions are computed once per header, in
+ * parallel, so that every header pair costs a single bitvec intersection.
  */
 void RemoveHeaderMutexesIfAllFieldsNotMutex::remove_header_mutexes_if_all_fields_not_mutex() {
-    for (auto it1 = header_info.all_headers.begin(); it1 != header_info.all_headers.end(); ++it1) {
-        for (auto it2 = std::next(it1); it2 != header_info.all_headers.end(); ++it2) {
-            auto i = header_info.get_header_index(*it1);
-            auto j = header_info.get_header_index(*it2);
+    const std::vector<cstring> headers(header_info.all_headers.begin(),
+                                       header_info.all_headers.end());
+    std::vector<bitvec> header_fields(headers.size());
+    for (size_t h = 0; h < headers.size(); ++h) {
+        ordered_set<const PHV::Field *> fields;
+        phv.get_hdr_fields(headers[h], fields);
+        for (const auto *field : fields) header_fields[h][field->id] = true;
+    }
+
+    const SymBitMatrix &field_mutex = phv.field_mutex();
+    std::vector<bitvec> mutex_with(headers.size());
+    BFN::parallel_for(
+        headers.size(),
+        [&](size_t lo, size_t hi) {
+            for (size_t h = lo; h < hi; ++h)
+                for (int id : header_fields[h]) mutex_with[h] |= bitvec(field_mutex[id]);
+        },
+        8);
+
+    // Indexes in the header mutex matrix follow the order of all_headers.
+    for (size_t i = 0; i < headers.size(); ++i) {
+        for (size_t j = i + 1; j < headers.size(); ++j) {
             if (!header_info.mutually_exclusive_headers(i, j)) continue;
-            if (have_mutually_exclusive_fields(*it1, *it2)) continue;
+            if (mutex_with[i].intersects(header_fields[j])) continue;
             header_info.mutually_exclusive_headers(i, j) = false;
         }
     }
@@ -189,7 +189,6 @@ class RemoveHeaderMutexesIfAllFieldsNotMutex : public Inspector {
     PhvInfo &phv;
     HeaderInfo &header_info;
 
-    bool have_mutually_exclusive_fields(cstring header1, cstring header2);
     void remove_header_mutexes_if_all_fields_not_mutex();
     profile_t init_apply(const IR::Node *root) override;
 
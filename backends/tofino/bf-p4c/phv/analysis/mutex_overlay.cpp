@@ -20,7 +20,9 @@
 
 #include <sstream>
 #include <typeinfo>
+#include <vector>
 
+#include "backends/tofino/bf-p4c/lib/parallel_for.h"
 #include "ir/ir.h"
 #include "lib/log.h"
 
@@ -30,41 +32,67 @@ Visitor::profile_t BuildParserOverlay::init_apply(const IR::Node *root) {
     return rv;
 }
 
-// Given the sets of parser states, k, v, in which two fields can be extracted
-// respectively, return true if any state in k is in a loop with any state in v.
-bool ExcludeParserLoopReachableFields::is_loop_reachable(
-    const ordered_set<const IR::BFN::ParserState *> &k,
-    const ordered_set<const IR::BFN::ParserState *> &v) {
-    for (auto i : k) {
-        for (auto j : v) {
-            if (i != j) {
-                auto p = fieldToStates.state_to_parser.at(i);
-                auto q = fieldToStates.state_to_parser.at(j);
-                if (p == q) {
-                    if (parserInfo.graph(p).is_loop_reachable(i, j) ||
-                        parserInfo.graph(p).is_loop_reachable(j, i)) {
-                        return true;
-                    }
-                }
-            }
-        }
-    }
-
-    return false;
+// Given two parser states, return true if they are different states of the same parser and
+// either of them is in a loop with the other.
+bool ExcludeParserLoopReachableFields::is_loop_reachable(const IR::BFN::ParserState *i,
+                                                         const IR::BFN::ParserState *j) {
+    if (i == j) return false;
+    auto p = fieldToStates.state_to_parser.at(i);
+    auto q = fieldToStates.state_to_parser.at(j);
+    if (p != q) return false;
+    return parserInfo.graph(p).is_loop_reachable(i, j) ||
+           parserInfo.graph(p).is_loop_reachable(j, i);
 }
 
+// Two fields are loop reachable if any of the states one is extracted in is loop reachable with
+// any of the states of the other.  The state pairs are checked first, once each and serially as
+// the parser graph caches its answers, which leaves a bitvec intersection per field pair.  Those
+// are computed a row per field in parallel, and the mutexes removed afterwards in field order.
 const IR::Node *ExcludeParserLoopReachableFields::apply_visitor(const IR::Node *root,
                                                                 const char *) {
+    ordered_map<const IR::BFN::ParserState *, int> state_index;
+    std::vector<const IR::BFN::ParserState *> states;
+    std::vector<const PHV::Field *> fields;
+    std::vector<bitvec> field_states;
     for (auto &kv : fieldToStates.field_to_parser_states) {
-        for (auto &xk : fieldToStates.field_to_parser_states) {
-            if (kv.first == xk.first || kv.first->gress != xk.first->gress) continue;
+        bitvec in_states;
+        for (auto *state : kv.second) {
+            auto [it, added] = state_index.emplace(state, int(states.size()));
+            if (added) states.push_back(state);
+            in_states[it->second] = true;
+        }
+        fields.push_back(kv.first);
+        field_states.push_back(in_states);
+    }
 
-            if (is_loop_reachable(kv.second, xk.second)) {
-                phv.removeFieldMutex(kv.first, xk.first);
-                LOG3("Mark " << kv.first->name << " and " << xk.first->name
-                             << " as non mutually exclusive (parser loop reachable)");
+    std::vector<bitvec> loop_states(states.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        for (size_t j = i + 1; j < states.size(); ++j) {
+            if (!is_loop_reachable(states[i], states[j])) continue;
+            loop_states[i][j] = true;
+            loop_states[j][i] = true;
+        }
+    }
+
+    std::vector<bitvec> loop_reachable(fields.size());
+    BFN::parallel_for(fields.size(), [&](size_t lo, size_t hi) {
+        for (size_t f1 = lo; f1 < hi; ++f1) {
+            bitvec reachable;
+            for (int s : field_states[f1]) reachable |= loop_states[s];
+            if (reachable.empty()) continue;
+            for (size_t f2 = 0; f2 < fields.size(); ++f2) {
+                if (f1 == f2 || fields[f1]->gress != fields[f2]->gress) continue;
+                if (reachable.intersects(field_states[f2])) loop_reachable[f1][f2] = true;
             }
         }
+    });
+
+    for (size_t f1 = 0; f1 < fields.size(); ++f1) {
+        for (int f2 : loop_reachable[f1]) {
+            phv.removeFieldMutex(fields[f1], fields[f2]);
+            LOG3("Mark " << fields[f1]->name << " and " << fields[f2]->name
+                         << " as non mutually exclusive (parser loop reachable)");
+        }
     }
 
     return root;
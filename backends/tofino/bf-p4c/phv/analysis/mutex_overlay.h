@@ -65,8 +65,7 @@ class ExcludeParserLoopReachableFields : public Visitor {
  private:
     const IR::Node *apply_visitor(const IR::Node *root, const char *) override;
 
-    bool is_loop_reachable(const ordered_set<const IR::BFN::ParserState *> &k,
-                           const ordered_set<const IR::BFN::ParserState *> &v);
+    bool is_loop_reachable(const IR::BFN::ParserState *i, const IR::BFN::ParserState *j);
 
  public:
     ExcludeParserLoopReachableFields(PhvInfo &phv, const MapFieldToParserStates &fs,
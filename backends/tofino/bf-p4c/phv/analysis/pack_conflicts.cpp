@@ -29,17 +29,14 @@ Visitor::profile_t PackConflicts::init_apply(const IR::Node *root) {
     fieldslice_id_counter = 0;
     fieldslice_no_pack_i.clear();
     field_fine_slices.clear();
-    // Initialize the fieldNoPack matrix to allow all fields to be packed together
+    // Initialize the fieldNoPack matrix to allow all fields to be packed together, except for
+    // the fields that are no pack according to deparser constraints.  Both matrices are indexed
+    // by field id, so only the rows of the deparser constraints need to be walked.
+    phv.field_no_pack() = phv.deparser_no_pack_mutex();
     for (auto &f1 : phv) {
-        for (auto &f2 : phv) {
-            // If the fields are no pack according to deparser constraints, then set that here.
-            if (phv.isDeparserNoPack(&f1, &f2)) {
-                addPackConflict(PHV::FieldSlice(&f1), PHV::FieldSlice(&f2));
-                continue;
-            }
-            // For all other fields, default is false.
-            removePackConflict(PHV::FieldSlice(&f1), PHV::FieldSlice(&f2));
-        }
+        bitvec no_pack = phv.deparser_no_pack_mutex()[f1.id];
+        for (int id2 : no_pack)
+            addPackConflict(PHV::FieldSlice(&f1), PHV::FieldSlice(phv.field(id2)));
         // Same field must always be packable with itself.
         removePackConflict(PHV::FieldSlice(&f1), PHV::FieldSlice(&f1));
     }
@@ -358,12 +355,9 @@ void PackConflicts::printNoPackConflicts() const {
 
 void PackConflicts::updateNumPackConstraints() {
     for (auto &f1 : phv) {
-        size_t numPack = 0;
-        for (auto &f2 : phv) {
-            if (f1.id == f2.id) continue;
-            if (phv.isFieldNoPack(&f1, &f2)) numPack++;
-        }
-        f1.set_num_pack_conflicts(numPack);
+        bitvec no_pack = phv.field_no_pack()[f1.id];
+        no_pack.clrbit(f1.id);
+        f1.set_num_pack_conflicts(no_pack.popcount());
     }
 }
 
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/phv/field_table.h"
+
+#include <algorithm>
+#include <map>
+
+#include "backends/tofino/bf-p4c/phv/phv_fields.h"
+#include "lib/algorithm.h"
+#include "lib/exceptions.h"
+
+namespace PHV {
+
+FieldTable::FieldTable(const PhvInfo &phv) {
+    int n = 0;
+    for (const auto &f : phv) n = std::max(n, f.id + 1);
+    fields.assign(n, nullptr);
+    widths.assign(n, 0);
+    offsets.assign(n, 0);
+    flags.assign(n, 0);
+    headers.assign(n, -1);
+
+    std::map<cstring, int> header_index;
+    for (const auto &f : phv) {
+        BUG_CHECK(fields[f.id] == nullptr, "Two PHV fields with id %1%", f.id);
+        fields[f.id] = &f;
+        widths[f.id] = f.size;
+        offsets[f.id] = f.offset;
+        flags[f.id] = (f.metadata ? METADATA : 0) | (f.pov ? POV : 0);
+
+        auto [it, added] = header_index.emplace(f.header(), int(fields_by_header.size()));
+        if (added) fields_by_header.emplace_back();
+        headers[f.id] = it->second;
+    }
+
+    // Fields are visited in id order here, which keeps every header_fields() list sorted.
+    for (int id = 0; id < n; ++id)
+        if (fields[id]) fields_by_header[headers[id]].push_back(id);
+}
+
+le_bitrange FieldTable::byteAlignedRangeInBits(int id) const {
+    int start = 8 * (offsets.at(id) / 8);
+    int len = (8 * ROUNDUP(offsets.at(id) + widths.at(id), 8)) - start;
+    return StartLen(start, len);
+}
+
+}  // namespace PHV
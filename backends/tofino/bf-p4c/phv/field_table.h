@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BACKENDS_TOFINO_BF_P4C_PHV_FIELD_TABLE_H_
+#define BACKENDS_TOFINO_BF_P4C_PHV_FIELD_TABLE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "backends/tofino/bf-p4c/ir/bitrange.h"
+#include "backends/tofino/bf-p4c/phv/phv.h"
+
+class PhvInfo;
+
+namespace PHV {
+
+class Field;
+
+/// FieldTable is a dense copy of the attributes of every PHV::Field that analyses going over
+/// all fields (or all pairs of fields) read most often, with one array per attribute.  Fields
+/// are indexed by PHV::Field::id, and the fields of each header are listed together, so a pass
+/// comparing the fields of a header does not need to touch the PHV::Field objects at all.
+///
+/// The table is a snapshot: it is built from PhvInfo by the pass that uses it and is not
+/// updated when fields change afterwards.
+class FieldTable {
+ public:
+    enum Flag : uint8_t {
+        METADATA = 1 << 0,
+        POV = 1 << 1,
+    };
+
+    explicit FieldTable(const PhvInfo &phv);
+
+    /// One more than the largest field id, ids of removed fields are skipped by every accessor.
+    int size() const { return int(fields.size()); }
+    const PHV::Field *field(int id) const { return fields.at(id); }
+
+    int width(int id) const { return widths.at(id); }
+    int offset(int id) const { return offsets.at(id); }
+    /// @returns true if field @p id has any of the @p f flags set
+    bool is(int id, unsigned f) const { return flags.at(id) & f; }
+    /// @returns the byte aligned range of the field in its header, see
+    /// PHV::Field::byteAlignedRangeInBits
+    le_bitrange byteAlignedRangeInBits(int id) const;
+
+    /// Fields of the same header, or of the same metadata struct, share a header index.
+    int header(int id) const { return headers.at(id); }
+    /// @returns the ids of the fields of header index @p h, in id order
+    const std::vector<int> &header_fields(int h) const { return fields_by_header.at(h); }
+    int num_headers() const { return int(fields_by_header.size()); }
+
+ private:
+    std::vector<const PHV::Field *> fields;
+    std::vector<int> widths;
+    std::vector<int> offsets;
+    std::vector<uint8_t> flags;
+    std::vector<int> headers;
+    std::vector<std::vector<int>> fields_by_header;
+};
+
+}  // namespace PHV
+
+#endif /* BACKENDS_TOFINO_BF_P4C_PHV_FIELD_TABLE_H_ */
@@ -0,0 +1,166 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/phv/slicing/phv_slicing_cache.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "backends/tofino/bf-p4c/phv/phv_fields.h"
+#include "lib/error.h"
+#include "lib/hash.h"
+#include "lib/log.h"
+#include "lib/ordered_set.h"
+
+namespace PHV {
+namespace Slicing {
+
+namespace {
+
+/// First line of a cache file, bump the version when the key or the format changes.
+const char *cache_file_header = "bf-p4c-phv-slicing-cache 1";
+const char *presplit_tag = "long_fieldslice_presplit";
+
+}  // namespace
+
+SlicingCache::Key SlicingCache::make_key(const SuperCluster *sc, const IteratorConfig &cfg,
+                                         const PHVContainerSizeLayout &pa) {
+    std::stringstream ss;
+    ss << cfg.minimal_packing_mode << cfg.loose_action_packing_check_mode
+       << cfg.smart_backtracking_mode << cfg.smart_slicing << cfg.homogeneous_slicing
+       << cfg.disable_packing_check << ' ' << cfg.max_search_steps << ' '
+       << cfg.max_search_steps_per_solution << ' ' << sc->needsStridedAlloc() << '\n';
+
+    // Super cluster uids change from one allocation attempt to the next, describe the
+    // super cluster by the field slices it is made of instead.
+    ordered_set<const PHV::Field *> fields;
+    for (const auto *sl : sc->slice_lists()) {
+        ss << '[';
+        for (const auto &fs : *sl) {
+            ss << ' ' << fs.field()->id << fs.range();
+            fields.insert(fs.field());
+        }
+        ss << " ]\n";
+    }
+    for (const auto *rot : sc->clusters()) {
+        ss << '{';
+        for (const auto *ali : rot->clusters()) {
+            ss << " (";
+            for (const auto &fs : ali->slices()) {
+                ss << ' ' << fs.field()->id << fs.range();
+                fields.insert(fs.field());
+            }
+            ss << " )";
+        }
+        ss << " }\n";
+    }
+    // The printed field carries its name, size and every slicing related constraint.
+    for (const auto *f : fields) {
+        ss << *f;
+        if (pa.count(f))
+            for (int size : pa.at(f)) ss << ' ' << size;
+        ss << '\n';
+    }
+    return P4::Util::hash(ss.str());
+}
+
+std::optional<SlicingCache::Outcome> SlicingCache::lookup(Key key) const {
+#ifdef MULTITHREAD
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    auto it = outcomes.find(key);
+    if (it == outcomes.end()) return std::nullopt;
+    return it->second;
+}
+
+void SlicingCache::record(Key key, Outcome outcome) {
+#ifdef MULTITHREAD
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    outcomes[key] = outcome;
+}
+
+void SlicingCache::forget(Key key) {
+#ifdef MULTITHREAD
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    outcomes.erase(key);
+}
+
+void SlicingCache::new_epoch() {
+#ifdef MULTITHREAD
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    for (auto it = outcomes.begin(); it != outcomes.end();) {
+        if (it->second == Outcome::NO_SLICING)
+            it = outcomes.erase(it);
+        else
+            ++it;
+    }
+}
+
+void SlicingCache::load(cstring path) {
+    if (loaded) return;
+    loaded = true;
+    std::ifstream in(path.c_str());
+    if (!in) {
+        LOG1("No PHV slicing cache found at " << path);
+        return;
+    }
+    std::string line;
+    if (!std::getline(in, line) || line != cache_file_header) {
+        warning("Ignoring %1%, it is not a PHV slicing cache of this compiler version", path);
+        return;
+    }
+#ifdef MULTITHREAD
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    int n_loaded = 0;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        Key key;
+        std::string tag;
+        if (!(fields >> std::hex >> key >> tag) || tag != presplit_tag) {
+            LOG1("Skipping malformed PHV slicing cache entry: " << line);
+            continue;
+        }
+        outcomes.emplace(key, Outcome::LONG_FIELDSLICE_PRESPLIT);
+        n_loaded++;
+    }
+    LOG1("Loaded " << n_loaded << " PHV slicing hints from " << path);
+}
+
+void SlicingCache::save(cstring path) const {
+    std::ofstream out(path.c_str());
+    if (!out) {
+        warning("Cannot write the PHV slicing cache to %1%", path);
+        return;
+    }
+#ifdef MULTITHREAD
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    out << cache_file_header << std::endl;
+    for (const auto &[key, outcome] : outcomes) {
+        if (outcome != Outcome::LONG_FIELDSLICE_PRESPLIT) continue;
+        out << std::hex << key << ' ' << presplit_tag << std::endl;
+    }
+}
+
+}  // namespace Slicing
+}  // namespace PHV
@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BACKENDS_TOFINO_BF_P4C_PHV_SLICING_PHV_SLICING_CACHE_H_
+#define BACKENDS_TOFINO_BF_P4C_PHV_SLICING_PHV_SLICING_CACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#ifdef MULTITHREAD
+#include <mutex>
+#endif
+
+#include "backends/tofino/bf-p4c/phv/slicing/types.h"
+#include "backends/tofino/bf-p4c/phv/utils/utils.h"
+#include "lib/cstring.h"
+
+namespace PHV {
+namespace Slicing {
+
+/// SlicingCache remembers what the slicing iterator learned about a super cluster, so that
+/// the search is not repeated from scratch for the same super cluster on the next allocation
+/// attempt, the next round trip through table placement or, through a file, the next compile.
+/// Super clusters are identified by a hash of their slice lists, rotational clusters, field
+/// constraints, pa_container_size layout and iterator config. Two outcomes are remembered:
+/// (1) NO_SLICING: the iterator did not produce any slicing. This depends on every input of
+///     the iterator, pack conflicts from table placement included, so it is dropped by
+///     new_epoch(), which PHV allocation calls whenever it starts over.
+/// (2) LONG_FIELDSLICE_PRESPLIT: the search ran out of steps before the first solution and
+///     only found one after long fieldslices were pre-split. This hint only changes the order
+///     in which slicings are searched, never which ones are valid, so it survives epochs and
+///     is the only outcome saved to file.
+class SlicingCache {
+ public:
+    enum class Outcome { NO_SLICING, LONG_FIELDSLICE_PRESPLIT };
+    using Key = uint64_t;
+
+    static Key make_key(const SuperCluster *sc, const IteratorConfig &cfg,
+                        const PHVContainerSizeLayout &pa);
+
+    std::optional<Outcome> lookup(Key key) const;
+    void record(Key key, Outcome outcome);
+    void forget(Key key);
+
+    /// Drop the outcomes that are only valid for the current inputs of the iterator.
+    void new_epoch();
+
+    /// Merge the hints saved in @p path, the first time it is called. A missing file is not an
+    /// error.
+    void load(cstring path);
+    void save(cstring path) const;
+
+ private:
+    std::map<Key, Outcome> outcomes;
+    bool loaded = false;
+#ifdef MULTITHREAD
+    mutable std::mutex lock;
+#endif
+};
+
+}  // namespace Slicing
+}  // namespace PHV
+
+#endif /* BACKENDS_TOFINO_BF_P4C_PHV_SLICING_PHV_SLICING_CACHE_H_ */
@@ -1207,6 +1207,25 @@ void DfsItrContext::iterate(const IterateCb &cb) {
         return;
     }
 
+    std::optional<SlicingCache::Key> cache_key;
+    if (cache_i) {
+        cache_key = SlicingCache::make_key(sc_i, config_i, pa_i);
+        if (cache_i->lookup(*cache_key) == SlicingCache::Outcome::NO_SLICING) {
+            LOG3("slicing cache: no valid slicing was found for this super cluster before");
+            return;
+        }
+    }
+    // Remember super clusters that cannot be sliced, whichever way the search below ends.
+    // The two simple cases above are cheap and do not need the cache.
+    DeferHelper record_no_slicing([&]() {
+        if (cache_key && n_solutions_i == 0)
+            cache_i->record(*cache_key, SlicingCache::Outcome::NO_SLICING);
+    });
+    // Searching in a different order is only safe when the search is not stateful across
+    // solutions, i.e. when a search that found nothing leaves the context untouched.
+    const bool can_reorder_search =
+        cache_key && !config_i.smart_backtracking_mode && !config_i.homogeneous_slicing;
+
     // slice_list validation
     for (const auto &sl : sc_i->slice_lists()) {
         if (SuperCluster::slice_list_has_exact_containers(*sl)) {
@@ -1283,6 +1302,23 @@ void DfsItrContext::iterate(const IterateCb &cb) {
     // }
     // to_be_split_i = *after_pre_split;
 
+    // A previous search on this super cluster only found solutions after pre-splitting long
+    // fieldslices, so start with that. If it finds nothing this time, search as usual.
+    if (can_reorder_search &&
+        cache_i->lookup(*cache_key) == SlicingCache::Outcome::LONG_FIELDSLICE_PRESPLIT) {
+        LOG3("slicing cache: pre-split long fieldslices before searching");
+        if (auto long_split = presplit_long_fieldslices()) {
+            auto before_long_split = to_be_split_i;
+            to_be_split_i = *long_split;
+            dfs(cb, to_be_split_i);
+            if (n_solutions_i > 0) return;
+            cache_i->forget(*cache_key);
+            to_be_split_i = before_long_split;
+            n_steps_i = 0;
+            n_steps_since_last_solution = 0;
+        }
+    }
+
     // start searching.
     auto res = dfs(cb, to_be_split_i);
     LOG1("DFS Result: " << res << ", n_steps_since_last_solution: " << n_steps_since_last_solution
@@ -1301,31 +1337,40 @@ void DfsItrContext::iterate(const IterateCb &cb) {
         LOG1(
             "failed to find one valid solution within step limit. "
             "Retry with pre-splitting large fieldslice");
-        bool is_any_long_field_split = false;
-        after_pre_split = presplit_by(
-            to_be_split_i,
-            [&](SuperCluster *sc) {
-                auto splitted = split_by_long_fieldslices(sc);
-                is_any_long_field_split = splitted && splitted->size() > 1;
-                return splitted;
-            },
-            "split_by_long_fieldslices"_cs);
-        if (!after_pre_split) {
-            LOG1("split by split_by_long_fieldslices fields failed, iteration stopped.");
-            return;
-        }
-        if (!is_any_long_field_split) {
-            LOG1(
-                "no optimization applied while we cannot find a solution in limited steps, "
-                "iteration stopped.");
-            return;
-        }
+        after_pre_split = presplit_long_fieldslices();
+        if (!after_pre_split) return;
         to_be_split_i = *after_pre_split;
 
         // restart searching.
+        const bool found_before_long_split = n_solutions_i > 0;
         n_steps_since_last_solution = 0;
         dfs(cb, to_be_split_i);
+        if (can_reorder_search && !found_before_long_split && n_solutions_i > 0)
+            cache_i->record(*cache_key, SlicingCache::Outcome::LONG_FIELDSLICE_PRESPLIT);
+    }
+}
+
+std::optional<ordered_set<SuperCluster *>> DfsItrContext::presplit_long_fieldslices() {
+    bool is_any_long_field_split = false;
+    auto after_pre_split = presplit_by(
+        to_be_split_i,
+        [&](SuperCluster *sc) {
+            auto splitted = split_by_long_fieldslices(sc);
+            is_any_long_field_split = splitted && splitted->size() > 1;
+            return splitted;
+        },
+        "split_by_long_fieldslices"_cs);
+    if (!after_pre_split) {
+        LOG1("split by split_by_long_fieldslices fields failed, iteration stopped.");
+        return std::nullopt;
+    }
+    if (!is_any_long_field_split) {
+        LOG1(
+            "no optimization applied while we cannot find a solution in limited steps, "
+            "iteration stopped.");
+        return std::nullopt;
     }
+    return after_pre_split;
 }
 
 bool DfsItrContext::need_further_split(const SuperCluster::SliceList *sl) const {
@@ -2082,6 +2127,7 @@ bool DfsItrContext::dfs(const IterateCb &yield, const ordered_set<SuperCluster *
         }
         LOG4("found a solution after " << n_steps_i << " steps");
         n_steps_since_last_solution = 0;
+        n_solutions_i++;
         return yield(std::list<SuperCluster *>(done_i.begin(), done_i.end()));
     }
 
@@ -23,6 +23,7 @@
 
 #include "backends/tofino/bf-p4c/lib/assoc.h"
 #include "backends/tofino/bf-p4c/parde/check_parser_multi_write.h"
+#include "backends/tofino/bf-p4c/phv/slicing/phv_slicing_cache.h"
 #include "backends/tofino/bf-p4c/phv/slicing/phv_slicing_iterator.h"
 #include "backends/tofino/bf-p4c/phv/slicing/phv_slicing_split.h"
 #include "backends/tofino/bf-p4c/phv/slicing/types.h"
@@ -101,6 +102,8 @@ class DfsItrContext : public IteratorInterface {
     const IsReferencedChecker is_used_i;
     IteratorConfig config_i;
     CheckWriteModeConsistency check_write_mode_consistency_i;
+    // outcomes of previous searches, shared by all iterators of an allocation. Can be nullptr.
+    SlicingCache *cache_i;
 
     // if a pa_container_size asks a field to be allocated to containers larger than it's
     // size, it's recorded here and will be used during pruning. Note that for one field,
@@ -139,6 +142,9 @@ class DfsItrContext : public IteratorInterface {
     // last solution was found at n_steps_since_last_solution before.
     int n_steps_since_last_solution = 0;
 
+    // the number of solutions passed to the iterate callback.
+    int n_solutions_i = 0;
+
     // Set of rejected SplitChoice options from previous slice-lists
     std::set<SplitChoice> reject_sizes;
 
@@ -168,7 +174,8 @@ class DfsItrContext : public IteratorInterface {
                   const PHVContainerSizeLayout &pa,
                   const ActionPackingValidatorInterface &action_packing_validator,
                   const ParserPackingValidatorInterface &parser_packing_validator,
-                  const PackConflictChecker &pack_conflict, const IsReferencedChecker is_used)
+                  const PackConflictChecker &pack_conflict, const IsReferencedChecker is_used,
+                  SlicingCache *cache = nullptr)
         : phv_i(phv),
           sc_i(sc),
           pa_i(pa),
@@ -177,7 +184,8 @@ class DfsItrContext : public IteratorInterface {
           has_pack_conflict_i(pack_conflict),
           is_used_i(is_used),
           config_i(false, false, true, true, false, (1 << 25), (1 << 19)),
-          check_write_mode_consistency_i(phv, field_to_states, parser_info) {}
+          check_write_mode_consistency_i(phv, field_to_states, parser_info),
+          cache_i(cache) {}
 
     /// iterate will pass valid slicing results to cb. Stop when cb returns false.
     void iterate(const IterateCb &cb) override;
@@ -220,6 +228,10 @@ class DfsItrContext : public IteratorInterface {
     /// 64 bits, using 32-bit container if possible.
     std::optional<std::list<SuperCluster *>> split_by_long_fieldslices(SuperCluster *sc) const;
 
+    /// presplit_long_fieldslices applies split_by_long_fieldslices on to_be_split_i. Returns
+    /// std::nullopt if the split failed or did not split any fieldslice.
+    std::optional<ordered_set<SuperCluster *>> presplit_long_fieldslices();
+
     /// split_by_parser_write_mode will split based on incompatible parser write modes
     std::optional<std::list<SuperCluster *>> split_by_parser_write_mode(SuperCluster *sc);
 
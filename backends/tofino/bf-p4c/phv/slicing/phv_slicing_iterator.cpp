@@ -30,9 +30,9 @@ ItrContext::ItrContext(const PhvInfo &phv, const MapFieldToParserStates &fs,
                        const ActionPackingValidatorInterface &action_packing_validator,
                        const ParserPackingValidatorInterface &parser_packing_validator,
                        const PackConflictChecker pack_conflict,
-                       const IsReferencedChecker is_referenced)
+                       const IsReferencedChecker is_referenced, SlicingCache *cache)
     : pImpl(new DfsItrContext(phv, fs, pi, sc, pa, action_packing_validator,
-                              parser_packing_validator, pack_conflict, is_referenced)) {}
+                              parser_packing_validator, pack_conflict, is_referenced, cache)) {}
 
 }  // namespace Slicing
 }  // namespace PHV
@@ -23,6 +23,7 @@
 #include "backends/tofino/bf-p4c/phv/action_packing_validator_interface.h"
 #include "backends/tofino/bf-p4c/phv/parser_packing_validator_interface.h"
 #include "backends/tofino/bf-p4c/phv/phv_fields.h"
+#include "backends/tofino/bf-p4c/phv/slicing/phv_slicing_cache.h"
 #include "backends/tofino/bf-p4c/phv/slicing/types.h"
 #include "backends/tofino/bf-p4c/phv/utils/utils.h"
 
@@ -36,6 +37,8 @@ namespace Slicing {
 /// The input @p sc is better to be:
 /// (1) split by pa_solitary already.
 /// (2) split by deparsed_bottom_bits already.
+/// When @p cache is given, the outcome of the search is remembered there and reused by later
+/// iterators on the same super cluster, see SlicingCache.
 class ItrContext : public IteratorInterface {
  private:
     IteratorInterface *pImpl;
@@ -45,7 +48,8 @@ class ItrContext : public IteratorInterface {
                const SuperCluster *sc, const PHVContainerSizeLayout &pa,
                const ActionPackingValidatorInterface &action_packing_validator,
                const ParserPackingValidatorInterface &parser_packing_validator,
-               const PackConflictChecker pack_conflict, const IsReferencedChecker is_referenced);
+               const PackConflictChecker pack_conflict, const IsReferencedChecker is_referenced,
+               SlicingCache *cache = nullptr);
 
     /// iterate will pass valid slicing results to cb. Stop when cb returns false.
     void iterate(const IterateCb &cb) override { pImpl->iterate(cb); }
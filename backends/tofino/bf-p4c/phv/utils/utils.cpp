@@ -1563,13 +1563,6 @@ PHV::SuperCluster::SuperCluster(ordered_set<const PHV::RotationalCluster *> clus
     }
 }
 
-void PHV::SuperCluster::calc_pack_conflicts() {
-    // calculate number of no pack conditions for each super cluster
-    forall_fieldslices([&](const PHV::FieldSlice &fs) {
-        num_pack_conflicts_i += fs.field()->num_pack_conflicts();
-    });
-}
-
 bool PHV::SuperCluster::operator==(const PHV::SuperCluster &other) const {
     if (clusters_i.size() != other.clusters_i.size() ||
         slice_lists_i.size() != other.slice_lists_i.size()) {
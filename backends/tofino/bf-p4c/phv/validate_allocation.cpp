@@ -48,14 +48,11 @@ namespace PHV {
 
 Visitor::profile_t ValidateAllocation::init_apply(const IR::Node *root) {
     mutually_exclusive_field_ids.clear();
-    // Combine the parser overlay and metadata overlay into a single matrix.
-    for (auto &f1 : phv) {
-        for (auto &f2 : phv) {
-            if (f1.id == f2.id) continue;
-            if (phv.isFieldMutex(&f1, &f2) || phv.isMetadataMutex(&f1, &f2))
-                mutually_exclusive_field_ids(f1.id, f2.id) = true;
-        }
-    }
+    // Combine the parser overlay and metadata overlay into a single matrix.  Both are indexed
+    // by field id, so they can be merged a word at a time.
+    mutually_exclusive_field_ids |= phv.field_mutex();
+    mutually_exclusive_field_ids |= phv.metadata_mutex();
+    for (auto &f : phv) mutually_exclusive_field_ids(f.id, f.id) = false;
     return Inspector::init_apply(root);
 }
 
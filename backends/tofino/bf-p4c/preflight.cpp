@@ -0,0 +1,352 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/preflight.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "backends/tofino/bf-p4c/arch/collect_hardware_constrained_fields.h"
+#include "backends/tofino/bf-p4c/common/check_for_unimplemented_features.h"
+#include "backends/tofino/bf-p4c/common/header_stack.h"
+#include "backends/tofino/bf-p4c/common/multiple_apply.h"
+#include "backends/tofino/bf-p4c/device.h"
+#include "backends/tofino/bf-p4c/mau/adjust_byte_count.h"
+#include "backends/tofino/bf-p4c/mau/empty_controls.h"
+#include "backends/tofino/bf-p4c/mau/gateway.h"
+#include "backends/tofino/bf-p4c/mau/instruction_selection.h"
+#include "backends/tofino/bf-p4c/mau/mau_visitor.h"
+#include "backends/tofino/bf-p4c/mau/memories.h"
+#include "backends/tofino/bf-p4c/mau/push_pop.h"
+#include "backends/tofino/bf-p4c/mau/reduction_or.h"
+#include "backends/tofino/bf-p4c/mau/resource_estimate.h"
+#include "backends/tofino/bf-p4c/mau/selector_update.h"
+#include "backends/tofino/bf-p4c/mau/stateful_alu.h"
+#include "backends/tofino/bf-p4c/mau/table_format.h"
+#include "backends/tofino/bf-p4c/parde/add_metadata_pov.h"
+#include "backends/tofino/bf-p4c/parde/reset_invalidated_checksum_headers.h"
+#include "backends/tofino/bf-p4c/parde/stack_push_shims.h"
+#include "backends/tofino/bf-p4c/phv/analysis/mutex_overlay.h"
+#include "backends/tofino/bf-p4c/phv/create_thread_local_instances.h"
+#include "ir/pass_manager.h"
+#include "lib/bitops.h"
+#include "lib/map.h"
+
+namespace BFN {
+
+namespace {
+
+int ceil_div(int a, int b) { return (a + b - 1) / b; }
+
+/// SRAMs holding @p entries entries, @p per_word to a RAM line, each RAM line @p width RAMs wide
+int srams(int entries, int per_word, int width = 1) {
+    return ceil_div(entries, per_word * Memories::SRAM_DEPTH) * width;
+}
+
+/// The number of entries table placement starts from
+int table_entries(const IR::MAU::Table *tbl) {
+    if (auto k = tbl->match_table->getConstantProperty("size"_cs)) return k->asInt();
+    if (auto k = tbl->match_table->getConstantProperty("min_size"_cs)) return k->asInt();
+    return 512;
+}
+
+}  // namespace
+
+/// Adds up the demand of every table for the per stage MAU resources
+class Preflight::TableDemand : public MauInspector {
+    Preflight &self;
+    std::set<cstring> counted;  // indirect attached memories shared by several tables
+
+    int &demand(resource_t r) { return self.resources[r].demand; }
+
+    profile_t init_apply(const IR::Node *root) override {
+        counted.clear();
+        return MauInspector::init_apply(root);
+    }
+    bool preorder(const IR::MAU::Table *tbl) override;
+    void match_demand(const IR::MAU::Table *tbl, int entries);
+    void action_data_demand(const IR::MAU::Table *tbl, int entries);
+    void attached_demand(const IR::MAU::Table *tbl, int entries);
+
+ public:
+    explicit TableDemand(Preflight &self) : self(self) {}
+};
+
+bool Preflight::TableDemand::preorder(const IR::MAU::Table *tbl) {
+    // Gateways alone can usually be combined with a match table, so are not counted
+    if (!tbl->match_table) return true;
+    int entries = table_entries(tbl);
+    demand(LOGICAL_TABLES) += 1;
+    match_demand(tbl, entries);
+    action_data_demand(tbl, entries);
+    attached_demand(tbl, entries);
+    return true;
+}
+
+/** Exact match tables are one hash way per table, with entries packed into RAM lines as
+ * densely as the table formats allow.  Ternary tables use TCAMs for all their match bits,
+ * except ATCAM tables which keep the ternary bits, two bits per bit, in SRAMs.  Range
+ * expansion is ignored. */
+void Preflight::TableDemand::match_demand(const IR::MAU::Table *tbl, int entries) {
+    int exact_bits = 0, ternary_bits = 0;
+    bool atcam = false;
+    for (auto *key : tbl->match_key) {
+        if (key->for_atcam_partition_index()) atcam = true;
+        if (!key->for_match()) continue;
+        int width = key->expr->type->width_bits();
+        if (key->match_type.name == "exact" || key->for_atcam_partition_index())
+            exact_bits += width;
+        else
+            ternary_bits += width;
+    }
+    if (exact_bits + ternary_bits == 0) return;
+
+    auto &ixbar = Device::ixbarSpec();
+    if (ternary_bits > 0 && !atcam) {
+        int bits = exact_bits + ternary_bits;
+        demand(TCAMS) += ceil_div(entries, Memories::TCAM_DEPTH) *
+                         ceil_div(bits, Device::mauSpec().tcam_width());
+        demand(TERNARY_XBAR_GROUPS) += ceil_div(ceil_div(bits, 8), ixbar.ternaryBytesPerGroup());
+        LOG2("  " << tbl->name << ": " << entries << " ternary entries of " << bits << " bits");
+        return;
+    }
+
+    int bits = exact_bits + 2 * ternary_bits + TableFormat::VERSION_BITS;
+    if (tbl->actions.size() > 1) bits += ceil_log2(tbl->actions.size());
+    int rams;
+    if (bits <= TableFormat::SINGLE_RAM_BITS)
+        rams = srams(entries, std::min(TableFormat::MAX_GROUPS_PER_RAM,
+                                       TableFormat::SINGLE_RAM_BITS / bits));
+    else
+        rams = srams(entries, 1, ceil_div(bits, TableFormat::SINGLE_RAM_BITS));
+    demand(SRAMS) += rams;
+    demand(EXACT_XBAR_BYTES) += ceil_div(exact_bits + ternary_bits, 8);
+    if (!atcam) demand(HASH_BITS) += ixbar.ramLineSelectBits() + std::max(ceil_log2(rams), 0);
+    LOG2("  " << tbl->name << ": " << entries << " exact entries of " << bits << " bits in "
+              << rams << " SRAMs");
+}
+
+/** Action data of up to 32 bits is assumed to fit as immediate data in the match overhead.
+ * Wider action data goes to an action data table, with one entry per match entry or per
+ * action profile entry. */
+void Preflight::TableDemand::action_data_demand(const IR::MAU::Table *tbl, int entries) {
+    int bits = 0;
+    for (auto &act : Values(tbl->actions)) {
+        int act_bits = 0;
+        for (auto *arg : act->args) act_bits += arg->type->width_bits();
+        bits = std::max(bits, act_bits);
+    }
+    if (bits <= 32) return;
+    for (auto *ba : tbl->attached) {
+        if (auto *ad = ba->attached->to<IR::MAU::ActionData>()) {
+            if (ad->direct) break;
+            if (!counted.insert(ad->name).second) return;
+            entries = ad->size;
+        }
+    }
+    int bytes_log2 = ceil_log2(ceil_div(bits, 8));
+    if (bytes_log2 <= 4)
+        demand(SRAMS) += srams(entries, 16 >> bytes_log2);
+    else
+        demand(SRAMS) += srams(entries, 1, ceil_div(bits, TableFormat::SINGLE_RAM_BITS));
+}
+
+void Preflight::TableDemand::attached_demand(const IR::MAU::Table *tbl, int entries) {
+    for (auto *ba : tbl->attached) {
+        auto *am = ba->attached;
+        if (am->is<IR::MAU::ActionData>()) continue;
+        if (!am->direct && !counted.insert(am->name).second) continue;
+        int size = am->direct ? entries : am->size;
+        if (auto *ctr = am->to<IR::MAU::Counter>()) {
+            demand(SRAMS) += srams(size, CounterPerWord(ctr));
+        } else if (am->is<IR::MAU::Meter>()) {
+            demand(SRAMS) += srams(size, 1);
+        } else if (auto *salu = am->to<IR::MAU::StatefulAlu>()) {
+            bool pow2 = salu->width > 0 && (salu->width & (salu->width - 1)) == 0;
+            demand(SRAMS) += srams(size, pow2 ? RegisterPerWord(salu) : 1);
+        } else if (auto *sel = am->to<IR::MAU::Selector>()) {
+            demand(SRAMS) += srams(size * SelectorRAMLinesPerEntry(sel), 1);
+        }
+    }
+}
+
+int Preflight::Resource::stages() const {
+    if (!per_stage) return 0;
+    return capacity > 0 ? ceil_div(demand, capacity) : 0;
+}
+
+double Preflight::Resource::load() const {
+    if (per_stage) return double(stages()) / Device::numStages();
+    return capacity > 0 ? double(demand) / capacity : 0.0;
+}
+
+Preflight::Preflight(const BFN_Options &options) : defuse(phv), uses(phv), pragmas(phv) {
+    // The start of the backend, up to the first dependency graph
+    addPasses({
+        new AdjustByteCountSetup,
+        new CreateThreadLocalInstances,
+        new CollectHardwareConstrainedFields,
+        new CheckForUnimplementedFeatures(),
+        new RemoveEmptyControls,
+        new MultipleApply(options),
+        new AddSelectorSalu,
+        new FixupStatefulAlu,
+        new CanonGatewayExpr,
+        new CollectHeaderStackInfo,
+        new CollectPhvInfo(phv),
+        &defuse,
+        Device::hasMetadataPOV() ? new AddMetadataPOV(phv) : nullptr,
+        Device::currentDevice() == Device::TOFINO ? new ResetInvalidatedChecksumHeaders(phv)
+                                                  : nullptr,
+        new CollectPhvInfo(phv),
+        &defuse,
+        new CollectHeaderStackInfo,
+        new RemovePushInitialization,
+        new StackPushShims,
+        new CollectPhvInfo(phv),
+        new HeaderPushPop,
+        new CollectPhvInfo(phv),
+        new GatherReductionOrReqs(deps.red_info),
+        new InstructionSelection(options, phv, deps.red_info),
+        new FindDependencyGraph(phv, deps, &options),
+        new CollectPhvInfo(phv),
+        &defuse,
+        new TableDemand(*this),
+        &uses,
+        &pragmas,
+        new MutexOverlay(phv, pragmas, uses),
+        new VisitFunctor([this] {
+            estimate_dependency_chain();
+            estimate_phv();
+            check();
+        }),
+    });
+}
+
+Visitor::profile_t Preflight::init_apply(const IR::Node *root) {
+    auto rv = PassManager::init_apply(root);
+    if (auto *pipe = root->to<IR::BFN::Pipe>()) pipe_name = pipe->canon_name();
+    for (auto &r : resources) r = Resource();
+    auto &ixbar = Device::ixbarSpec();
+    resources[LOGICAL_TABLES] = {"logical tables", 0, Device::numLogTablesPerStage()};
+    resources[SRAMS] = {"SRAMs", 0, StageUse::MAX_SRAMS};
+    resources[TCAMS] = {"TCAMs", 0, StageUse::MAX_TCAMS};
+    resources[EXACT_XBAR_BYTES] = {"exact xbar bytes", 0, StageUse::MAX_IXBAR_BYTES};
+    resources[TERNARY_XBAR_GROUPS] = {"ternary xbar groups", 0, StageUse::MAX_TERNARY_GROUPS};
+    resources[HASH_BITS] = {"hash bits", 0, ixbar.hashGroups() * ixbar.maxHashBits()};
+    resources[DEPENDENCY_CHAIN] = {"dependency chain", 0, 1};
+    resources[PHV_BITS] = {"PHV bits", 0, 0, false};
+    return rv;
+}
+
+/// The longest chain of dependent tables needs a stage for each table in it
+void Preflight::estimate_dependency_chain() {
+    resources[DEPENDENCY_CHAIN].demand = deps.critical_path_length();
+}
+
+/// Fields that are not mutually exclusive with each other must all be in PHV at once, so the
+/// size of any such set is a lower bound on the PHV demand.  The set is built greedily, from
+/// the largest field down, as finding the largest one is a max weight clique problem.
+void Preflight::estimate_phv() {
+    auto &phvSpec = Device::phvSpec();
+    auto &res = resources[PHV_BITS];
+    for (auto id : phvSpec.physicalContainers()) {
+        auto c = phvSpec.idToContainer(id);
+        if (!c.is(PHV::Kind::dark)) res.capacity += c.size();
+    }
+    std::vector<const PHV::Field *> fields;
+    for (auto &field : phv) {
+        if (field.is_ignore_alloc()) continue;
+        if (field.metadata && !field.bridged && !field.pov) continue;
+        if (defuse.getAllDefsAndUses(field.id).empty()) continue;
+        fields.push_back(&field);
+    }
+    std::stable_sort(fields.begin(), fields.end(),
+                     [](const PHV::Field *a, const PHV::Field *b) { return a->size > b->size; });
+    std::vector<const PHV::Field *> live;
+    for (auto *field : fields) {
+        if (std::any_of(live.begin(), live.end(), [&](const PHV::Field *other) {
+                return phv.isFieldMutex(field, other);
+            }))
+            continue;
+        live.push_back(field);
+        res.demand += field->size;
+    }
+}
+
+bool Preflight::fits() const {
+    for (auto &r : resources)
+        if (r.per_stage && r.load() > 1.0) return false;
+    return true;
+}
+
+int Preflight::min_stages() const {
+    int rv = 0;
+    for (auto &r : resources) rv = std::max(rv, r.stages());
+    return rv;
+}
+
+Preflight::resource_t Preflight::bottleneck() const {
+    int rv = 0;
+    for (int r = 1; r < NUM_RESOURCES; ++r)
+        if (resources[r].load() > resources[rv].load()) rv = r;
+    return resource_t(rv);
+}
+
+void Preflight::report(std::ostream &out) const {
+    out << "Pre-flight resource estimate for " << pipe_name << " on " << Device::name() << ":"
+        << std::endl;
+    out << "  " << std::left << std::setw(22) << "resource" << std::right << std::setw(10)
+        << "demand" << std::setw(12) << "available" << std::setw(8) << "stages" << std::endl;
+    for (auto &r : resources) {
+        out << "  " << std::left << std::setw(22) << r.name << std::right << std::setw(10)
+            << r.demand;
+        if (r.per_stage)
+            out << std::setw(10) << r.capacity << "/s" << std::setw(8) << r.stages();
+        else
+            out << std::setw(12) << r.capacity << std::setw(8) << "-";
+        out << std::endl;
+    }
+    auto &b = resources[bottleneck()];
+    out << "  needs at least " << min_stages() << " of " << Device::numStages()
+        << " stages; bottleneck: " << b.name << " (" << int(b.load() * 100 + 0.5)
+        << "% of the device)" << std::endl;
+    out << "  " << pipe_name << (fits() ? " may fit" : " does not fit") << std::endl;
+    if (resources[PHV_BITS].load() > 1.0)
+        out << "  PHV demand exceeds the device unless more fields can be overlaid" << std::endl;
+}
+
+void Preflight::check() {
+    report(std::cout);
+    auto &phv_bits = resources[PHV_BITS];
+    if (phv_bits.load() > 1.0)
+        ::warning("%1%: needs at least %2% %3% that are not mutually exclusive but only %4% are "
+                  "available; PHV allocation may still overlay some of them",
+                  pipe_name, phv_bits.demand, phv_bits.name, phv_bits.capacity);
+    if (fits()) return;
+    const Resource *worst = nullptr;
+    for (auto &r : resources)
+        if (r.per_stage && (!worst || r.load() > worst->load())) worst = &r;
+    ::error("%1%: needs at least %2% stages for its %3% but only %4% are available", pipe_name,
+            worst->stages(), worst->name, Device::numStages());
+}
+
+}  // namespace BFN
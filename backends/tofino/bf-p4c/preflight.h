@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BACKENDS_TOFINO_BF_P4C_PREFLIGHT_H_
+#define BACKENDS_TOFINO_BF_P4C_PREFLIGHT_H_
+
+#include <iosfwd>
+
+#include "backends/tofino/bf-p4c/bf-p4c-options.h"
+#include "backends/tofino/bf-p4c/common/field_defuse.h"
+#include "backends/tofino/bf-p4c/mau/table_dependency_graph.h"
+#include "backends/tofino/bf-p4c/phv/phv_fields.h"
+#include "backends/tofino/bf-p4c/phv/phv_parde_mau_use.h"
+#include "backends/tofino/bf-p4c/phv/pragma/phv_pragmas.h"
+#include "ir/ir.h"
+
+namespace BFN {
+
+/**
+ * The --preflight check: a quick estimate of whether a pipe can fit on the device, run in
+ * place of the backend.  Only the backend passes needed for the dependency graph are run; the
+ * demand of the tables for each MAU resource is then added up from the match keys, actions,
+ * sizes and attached memories of the tables, without laying out, allocating or placing
+ * anything, and compared with what the stages of the device provide.
+ *
+ * The estimates ignore range expansion, ghost bits, immediate data, ternary indirection,
+ * spare banks and the packing of several tables into one hash group or search bus, so they
+ * are mostly optimistic: a pipe reported as not fitting will not fit, one reported as fitting
+ * may still fail to place.  PHV demand counts the referenced header, bridged and POV fields
+ * that must be live at the same time: fields the mutex analysis finds mutually exclusive (e.g.
+ * headers extracted on different parser paths) are counted as overlaid, other metadata is
+ * left out as it can often be overlaid too.  As live range overlays are ignored the PHV demand
+ * is only reported as a warning.
+ */
+class Preflight : public PassManager {
+ public:
+    enum resource_t {
+        LOGICAL_TABLES,
+        SRAMS,
+        TCAMS,
+        EXACT_XBAR_BYTES,
+        TERNARY_XBAR_GROUPS,
+        HASH_BITS,
+        DEPENDENCY_CHAIN,
+        PHV_BITS,
+        NUM_RESOURCES
+    };
+
+    struct Resource {
+        const char *name = nullptr;
+        int demand = 0;
+        int capacity = 0;  // per stage, or in the whole pipe for PHV
+        bool per_stage = true;
+        /// Stages needed to provide the demand; 0 for resources that are not per stage
+        int stages() const;
+        /// Fraction of what the device provides that is needed
+        double load() const;
+    };
+
+ private:
+    class TableDemand;
+
+    cstring pipe_name;
+    PhvInfo phv;
+    FieldDefUse defuse;
+    PhvUse uses;
+    PHV::Pragmas pragmas;
+    DependencyGraph deps;
+    Resource resources[NUM_RESOURCES];
+
+    profile_t init_apply(const IR::Node *root) override;
+    void estimate_phv();
+    void estimate_dependency_chain();
+    void check();
+
+ public:
+    explicit Preflight(const BFN_Options &options);
+
+    const Resource &resource(resource_t r) const { return resources[r]; }
+    /// The minimum number of stages the pipe needs
+    int min_stages() const;
+    /// The resource that comes closest to, or goes furthest past, what the device provides
+    resource_t bottleneck() const;
+    /// Whether the MAU resources fit in the stages of the device; PHV is not included
+    bool fits() const;
+    void report(std::ostream &out) const;
+};
+
+}  // namespace BFN
+
+#endif /* BACKENDS_TOFINO_BF_P4C_PREFLIGHT_H_ */
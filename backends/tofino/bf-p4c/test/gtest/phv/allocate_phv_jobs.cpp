@@ -0,0 +1,184 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Verify that the brute force PHV allocation picks the same allocation whether its configs
+ * run one after another or concurrently (--phv-alloc-jobs).
+ */
+
+#include "backends/tofino/bf-p4c/test/gtest/bf_gtest_helpers.h"
+#include "backends/tofino/bf-p4c/test/gtest/tofino_gtest_utils.h"
+#include "gtest/gtest.h"
+
+namespace P4::Test {
+
+namespace AllocatePhvJobs {
+
+std::string prog() {
+    return R"(
+header ethernet_h {
+    bit<48> dst_addr;
+    bit<48> src_addr;
+    bit<16> ether_type;
+}
+
+header ipv4_h {
+    bit<4>  version;
+    bit<4>  ihl;
+    bit<8>  diffserv;
+    bit<16> total_len;
+    bit<16> identification;
+    bit<3>  flags;
+    bit<13> frag_offset;
+    bit<8>  ttl;
+    bit<8>  protocol;
+    bit<16> hdr_checksum;
+    bit<32> src_addr;
+    bit<32> dst_addr;
+}
+
+struct headers_t {
+    ethernet_h ethernet;
+    ipv4_h     ipv4;
+}
+
+struct metadata_t {
+    bit<16> nexthop;
+    bit<12> vrf;
+    bit<3>  color;
+    bit<1>  routed;
+    bit<32> hash;
+}
+
+parser IngressParser(packet_in pkt, out headers_t hdr, out metadata_t ig_md,
+                     out ingress_intrinsic_metadata_t ig_intr_md) {
+    state start {
+        pkt.extract(ig_intr_md);
+        pkt.advance(PORT_METADATA_SIZE);
+        pkt.extract(hdr.ethernet);
+        transition select(hdr.ethernet.ether_type) {
+            0x0800 : parse_ipv4;
+            default : accept;
+        }
+    }
+
+    state parse_ipv4 {
+        pkt.extract(hdr.ipv4);
+        transition accept;
+    }
+}
+
+control Ingress(inout headers_t hdr, inout metadata_t ig_md,
+                in ingress_intrinsic_metadata_t ig_intr_md,
+                in ingress_intrinsic_metadata_from_parser_t ig_prsr_md,
+                inout ingress_intrinsic_metadata_for_deparser_t ig_dprsr_md,
+                inout ingress_intrinsic_metadata_for_tm_t ig_tm_md) {
+    action set_vrf(bit<12> vrf) { ig_md.vrf = vrf; }
+    action set_nexthop(bit<16> nexthop, bit<3> color) {
+        ig_md.nexthop = nexthop;
+        ig_md.color = color;
+        ig_md.routed = 1;
+    }
+    action rewrite(bit<48> smac, bit<48> dmac, PortId_t port) {
+        hdr.ethernet.src_addr = smac;
+        hdr.ethernet.dst_addr = dmac;
+        hdr.ipv4.ttl = hdr.ipv4.ttl - 1;
+        ig_tm_md.ucast_egress_port = port;
+    }
+
+    table port_vrf {
+        key = { ig_intr_md.ingress_port : exact; }
+        actions = { set_vrf; }
+    }
+    table route {
+        key = { ig_md.vrf : exact; hdr.ipv4.dst_addr : exact; }
+        actions = { set_nexthop; }
+    }
+    table nexthop {
+        key = { ig_md.nexthop : exact; ig_md.color : exact; }
+        actions = { rewrite; }
+    }
+
+    apply {
+        port_vrf.apply();
+        if (hdr.ipv4.isValid()) {
+            ig_md.hash = hdr.ipv4.src_addr ^ hdr.ipv4.dst_addr;
+            route.apply();
+        }
+        if (ig_md.routed == 1) nexthop.apply();
+        hdr.ipv4.identification = ig_md.hash[15:0];
+    }
+}
+
+control IngressDeparser(packet_out pkt, inout headers_t hdr, in metadata_t ig_md,
+                        in ingress_intrinsic_metadata_for_deparser_t ig_dprsr_md) {
+    apply { pkt.emit(hdr); }
+}
+
+parser EgressParser(packet_in pkt, out headers_t hdr, out metadata_t eg_md,
+                    out egress_intrinsic_metadata_t eg_intr_md) {
+    state start {
+        pkt.extract(eg_intr_md);
+        transition accept;
+    }
+}
+
+control Egress(inout headers_t hdr, inout metadata_t eg_md,
+               in egress_intrinsic_metadata_t eg_intr_md,
+               in egress_intrinsic_metadata_from_parser_t eg_intr_md_from_prsr,
+               inout egress_intrinsic_metadata_for_deparser_t eg_intr_md_for_dprsr,
+               inout egress_intrinsic_metadata_for_output_port_t eg_intr_md_for_oport) {
+    apply { }
+}
+
+control EgressDeparser(packet_out pkt, inout headers_t hdr, in metadata_t eg_md,
+                       in egress_intrinsic_metadata_for_deparser_t eg_intr_md_for_dprsr) {
+    apply { }
+}
+
+Pipeline(IngressParser(), Ingress(), IngressDeparser(),
+         EgressParser(), Egress(), EgressDeparser()) pipe;
+
+Switch(pipe) main;
+    )";
+}
+
+/// @returns the PHV section of the assembly for the program compiled with @p jobs
+std::string phv_asm(int jobs) {
+    auto blk = TestCode(TestCode::Hdr::Tofino1arch, prog(), {});
+    BackendOptions().alt_phv_alloc = false;
+    BackendOptions().phv_alloc_jobs = jobs;
+
+    EXPECT_TRUE(blk.CreateBackend());
+    EXPECT_TRUE(blk.apply_pass(TestCode::Pass::FullBackend));
+    return blk.extract_code(TestCode::CodeBlock::PhvAsm);
+}
+
+}  // namespace AllocatePhvJobs
+
+TEST(AllocatePhvJobs, SameAllocationOnOneAndManyThreads) {
+    auto sequential = AllocatePhvJobs::phv_asm(1);
+    ASSERT_FALSE(sequential.empty());
+    // Run the concurrent allocation a few times, a race would show as an occasional mismatch.
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(AllocatePhvJobs::phv_asm(0), sequential);
+        EXPECT_EQ(AllocatePhvJobs::phv_asm(2), sequential);
+    }
+}
+
+}  // namespace P4::Test
@@ -0,0 +1,53 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/phv/field_table.h"
+
+#include "backends/tofino/bf-p4c/phv/phv_fields.h"
+#include "backends/tofino/bf-p4c/test/gtest/tofino_gtest_utils.h"
+#include "gtest/gtest.h"
+
+namespace P4::Test {
+
+class TofinoFieldTable : public TofinoBackendTest {};
+
+TEST_F(TofinoFieldTable, attributes_and_headers) {
+    PhvInfo phv;
+    auto *a = phv.add("ingress::hdr.a"_cs, INGRESS, 4, 12, false, false);
+    auto *b = phv.add("ingress::hdr.b"_cs, INGRESS, 12, 0, false, false);
+    auto *m = phv.add("ingress::meta.m"_cs, INGRESS, 8, 0, true, false);
+    auto *v = phv.add("egress::hdr.$valid"_cs, EGRESS, 1, 0, false, true);
+
+    PHV::FieldTable fields(phv);
+    ASSERT_EQ(fields.size(), 4);
+    EXPECT_EQ(fields.field(a->id), a);
+    EXPECT_EQ(fields.width(b->id), 12);
+    EXPECT_EQ(fields.offset(a->id), 12);
+    EXPECT_TRUE(fields.is(m->id, PHV::FieldTable::METADATA));
+    EXPECT_FALSE(fields.is(m->id, PHV::FieldTable::POV));
+    EXPECT_TRUE(fields.is(v->id, PHV::FieldTable::METADATA | PHV::FieldTable::POV));
+    EXPECT_FALSE(fields.is(a->id, PHV::FieldTable::METADATA | PHV::FieldTable::POV));
+    EXPECT_EQ(fields.byteAlignedRangeInBits(a->id), le_bitrange(StartLen(8, 8)));
+
+    EXPECT_EQ(fields.header(a->id), fields.header(b->id));
+    EXPECT_NE(fields.header(a->id), fields.header(m->id));
+    EXPECT_EQ(fields.num_headers(), 3);
+    EXPECT_EQ(fields.header_fields(fields.header(a->id)), std::vector<int>({a->id, b->id}));
+}
+
+}  // namespace P4::Test
@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "backends/tofino/bf-p4c/phv/slicing/phv_slicing_cache.h"
+#include "gtest/gtest.h"
+
+namespace P4::Test {
+
+using Outcome = PHV::Slicing::SlicingCache::Outcome;
+
+TEST(PhvSlicingCache, new_epoch_keeps_hints_only) {
+    PHV::Slicing::SlicingCache cache;
+    cache.record(1, Outcome::NO_SLICING);
+    cache.record(2, Outcome::LONG_FIELDSLICE_PRESPLIT);
+    EXPECT_EQ(cache.lookup(1), Outcome::NO_SLICING);
+    EXPECT_EQ(cache.lookup(2), Outcome::LONG_FIELDSLICE_PRESPLIT);
+    EXPECT_EQ(cache.lookup(3), std::nullopt);
+
+    cache.new_epoch();
+    EXPECT_EQ(cache.lookup(1), std::nullopt);
+    EXPECT_EQ(cache.lookup(2), Outcome::LONG_FIELDSLICE_PRESPLIT);
+
+    cache.forget(2);
+    EXPECT_EQ(cache.lookup(2), std::nullopt);
+}
+
+TEST(PhvSlicingCache, save_and_load) {
+    std::string path = ::testing::TempDir() + "phv_slicing_cache_test.txt";
+    {
+        PHV::Slicing::SlicingCache cache;
+        cache.record(0xdeadbeefcafeULL, Outcome::LONG_FIELDSLICE_PRESPLIT);
+        cache.record(42, Outcome::NO_SLICING);
+        cache.save(cstring(path));
+    }
+    PHV::Slicing::SlicingCache cache;
+    cache.load(cstring(path));
+    EXPECT_EQ(cache.lookup(0xdeadbeefcafeULL), Outcome::LONG_FIELDSLICE_PRESPLIT);
+    // Only the hints are valid beyond the current compile.
+    EXPECT_EQ(cache.lookup(42), std::nullopt);
+    std::remove(path.c_str());
+}
+
+}  // namespace P4::Test
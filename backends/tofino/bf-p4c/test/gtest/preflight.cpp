@@ -0,0 +1,239 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/preflight.h"
+
+#include <optional>
+#include <string>
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include "backends/tofino/bf-p4c/test/gtest/tofino_gtest_utils.h"
+#include "gtest/gtest.h"
+#include "ir/ir.h"
+#include "test/gtest/helpers.h"
+
+namespace P4::Test {
+
+class PreflightTest : public TofinoBackendTest {};
+
+namespace {
+
+std::optional<TofinoPipeTestCase> createPreflightTest(const std::string &exactSize) {
+    auto source = P4_SOURCE(P4Headers::V1MODEL, R"(
+        header data_t {
+            bit<16> h1;
+            bit<16> h2;
+            bit<8>  b1;
+            bit<8>  b2;
+        }
+
+        struct metadata { }
+
+        struct headers { data_t data; }
+
+        parser parse(packet_in packet, out headers hdr, inout metadata meta,
+                 inout standard_metadata_t sm) {
+            state start {
+                packet.extract(hdr.data);
+                transition accept;
+            }
+        }
+
+        control verifyChecksum(inout headers hdr, inout metadata meta) { apply { } }
+        control ingress(inout headers hdr, inout metadata meta,
+                        inout standard_metadata_t sm) {
+            action noop() {}
+            action set_b1(bit<8> b1) { hdr.data.b1 = b1; }
+            action set_b2(bit<8> b2) { hdr.data.b2 = b2; }
+
+            table exact_tbl {
+                key = { hdr.data.h1 : exact; }
+                actions = { set_b1; noop; }
+                size = %EXACT_SIZE%;
+            }
+
+            table ternary_tbl {
+                key = { hdr.data.h2 : ternary; }
+                actions = { set_b2; noop; }
+                size = 1024;
+            }
+
+            apply {
+                exact_tbl.apply();
+                ternary_tbl.apply();
+            }
+        }
+
+        control egress(inout headers hdr, inout metadata meta,
+                       inout standard_metadata_t sm) {
+            apply { } }
+
+        control computeChecksum(inout headers hdr, inout metadata meta) {
+            apply { } }
+
+        control deparse(packet_out packet, in headers hdr) {
+            apply {
+                packet.emit(hdr.data);
+            }
+        }
+
+        V1Switch(parse(), verifyChecksum(), ingress(), egress(),
+                 computeChecksum(), deparse()) main;
+    )");
+
+    boost::replace_first(source, "%EXACT_SIZE%", exactSize);
+
+    auto &options = BackendOptions();
+    options.langVersion = CompilerOptions::FrontendVersion::P4_16;
+    options.target = "tofino"_cs;
+    options.arch = "v1model"_cs;
+    options.disable_parse_min_depth_limit = true;
+
+    return TofinoPipeTestCase::create(source);
+}
+
+/// Two headers of @p fields 64-bit fields each, extracted on different parser paths
+std::optional<TofinoPipeTestCase> createMutexHeadersTest(int fields) {
+    auto source = P4_SOURCE(P4Headers::V1MODEL, R"(
+        header ethernet_t {
+            bit<48> dst;
+            bit<48> src;
+            bit<16> ether_type;
+        }
+        header a_t { %FIELDS% }
+        header b_t { %FIELDS% }
+
+        struct metadata { }
+
+        struct headers {
+            ethernet_t ethernet;
+            a_t a;
+            b_t b;
+        }
+
+        parser parse(packet_in packet, out headers hdr, inout metadata meta,
+                 inout standard_metadata_t sm) {
+            state start {
+                packet.extract(hdr.ethernet);
+                transition select(hdr.ethernet.ether_type) {
+                    0x1111: parse_a;
+                    0x2222: parse_b;
+                    default: accept;
+                }
+            }
+            state parse_a {
+                packet.extract(hdr.a);
+                transition accept;
+            }
+            state parse_b {
+                packet.extract(hdr.b);
+                transition accept;
+            }
+        }
+
+        control verifyChecksum(inout headers hdr, inout metadata meta) { apply { } }
+        control ingress(inout headers hdr, inout metadata meta,
+                        inout standard_metadata_t sm) {
+            apply { sm.egress_spec = 1; }
+        }
+
+        control egress(inout headers hdr, inout metadata meta,
+                       inout standard_metadata_t sm) {
+            apply { } }
+
+        control computeChecksum(inout headers hdr, inout metadata meta) {
+            apply { } }
+
+        control deparse(packet_out packet, in headers hdr) {
+            apply {
+                packet.emit(hdr.ethernet);
+                packet.emit(hdr.a);
+                packet.emit(hdr.b);
+            }
+        }
+
+        V1Switch(parse(), verifyChecksum(), ingress(), egress(),
+                 computeChecksum(), deparse()) main;
+    )");
+
+    std::string decls;
+    for (int i = 0; i < fields; ++i) decls += "bit<64> f" + std::to_string(i) + "; ";
+    boost::replace_all(source, "%FIELDS%", decls);
+
+    auto &options = BackendOptions();
+    options.langVersion = CompilerOptions::FrontendVersion::P4_16;
+    options.target = "tofino"_cs;
+    options.arch = "v1model"_cs;
+    options.disable_parse_min_depth_limit = true;
+
+    return TofinoPipeTestCase::create(source);
+}
+
+}  // namespace
+
+TEST_F(PreflightTest, Fits) {
+    auto test = createPreflightTest("65536");
+    ASSERT_TRUE(test);
+
+    BFN::Preflight preflight(BackendOptions());
+    test->pipe->apply(preflight);
+
+    // 21 bit entries (16 match, 4 version and 1 action bits), 5 to a RAM line
+    EXPECT_EQ(preflight.resource(BFN::Preflight::SRAMS).demand, 13);
+    EXPECT_EQ(preflight.resource(BFN::Preflight::TCAMS).demand, 2);
+    EXPECT_EQ(preflight.resource(BFN::Preflight::LOGICAL_TABLES).demand, 2);
+    EXPECT_EQ(preflight.resource(BFN::Preflight::DEPENDENCY_CHAIN).demand, 1);
+    EXPECT_EQ(preflight.min_stages(), 1);
+    EXPECT_TRUE(preflight.fits());
+    EXPECT_EQ(::errorCount(), 0u);
+}
+
+TEST_F(PreflightTest, TooManySrams) {
+    auto test = createPreflightTest("5000000");
+    ASSERT_TRUE(test);
+
+    BFN::Preflight preflight(BackendOptions());
+    test->pipe->apply(preflight);
+
+    EXPECT_EQ(preflight.resource(BFN::Preflight::SRAMS).demand, 977);
+    EXPECT_EQ(preflight.min_stages(), 13);
+    EXPECT_EQ(preflight.bottleneck(), BFN::Preflight::SRAMS);
+    EXPECT_FALSE(preflight.fits());
+    EXPECT_GT(::errorCount(), 0u);
+}
+
+TEST_F(PreflightTest, MutuallyExclusiveHeaders) {
+    // 2 x 3200 bits of headers, more than the 6144 bits of PHV a Tofino has, but only one of
+    // the two is ever extracted
+    auto test = createMutexHeadersTest(50);
+    ASSERT_TRUE(test);
+
+    BFN::Preflight preflight(BackendOptions());
+    test->pipe->apply(preflight);
+
+    auto &phv = preflight.resource(BFN::Preflight::PHV_BITS);
+    EXPECT_LT(phv.capacity, 2 * 3200);
+    EXPECT_GE(phv.demand, 3200 + 112);
+    EXPECT_LT(phv.demand, 2 * 3200);
+    EXPECT_LE(phv.load(), 1.0);
+    EXPECT_TRUE(preflight.fits());
+    EXPECT_EQ(::errorCount(), 0u);
+}
+
+}  // namespace P4::Test
@@ -928,6 +928,61 @@ TEST_F(TableDependencyGraphTest, GraphMinStage) {
     check_dependency_graph_summary(test, dg, expected);
 }
 
+/**
+ * Running FindDependencyGraph again on the same IR keeps the graph as long as nothing it is built
+ * from has changed, and builds it again as soon as the PHV analyses change.
+ */
+TEST_F(TableDependencyGraphTest, GraphKeptWhenInputsUnchanged) {
+    auto test = createTableDependencyGraphTestCase(P4_SOURCE(P4Headers::NONE, R"(
+    action setb1(bit<32> val) { headers.h2.b1 = val; }
+    action noop() { }
+
+    table A {
+        key = { headers.h2.f1: exact; }
+        actions = { setb1; }
+        size = 512;
+    }
+
+    table B {
+        key = { headers.h2.b1: exact; }
+        actions = { noop; }
+        size = 512;
+    }
+
+    apply {
+        A.apply();
+        B.apply();
+    }
+)"));
+    ASSERT_TRUE(test);
+    PhvInfo phv;
+    FieldDefUse defuse(phv);
+    DependencyGraph dg;
+
+    test->pipe = runMockPasses(test->pipe, phv, defuse);
+
+    auto *find_dg = new FindDependencyGraph(phv, dg);
+    test->pipe->apply(*find_dg);
+    EXPECT_FALSE(find_dg->reused_graph());
+    const IR::MAU::Table *a = dg.name_to_table.at("igrs.A"_cs);
+    const IR::MAU::Table *b = dg.name_to_table.at("igrs.B"_cs);
+    EXPECT_EQ(dg.stage_info[a].min_stage, 0);
+    EXPECT_EQ(dg.stage_info[b].min_stage, 1);
+
+    test->pipe->apply(*find_dg);
+    EXPECT_TRUE(find_dg->reused_graph());
+    EXPECT_TRUE(dg.finalized);
+    EXPECT_EQ(dg.stage_info[a].min_stage, 0);
+    EXPECT_EQ(dg.stage_info[b].min_stage, 1);
+    EXPECT_TRUE(dg.happens_logi_before(a, b));
+
+    phv.addFieldMutex(phv.field("ingress::headers.h2.f1"_cs),
+                      phv.field("ingress::headers.h2.b1"_cs));
+    test->pipe->apply(*find_dg);
+    EXPECT_FALSE(find_dg->reused_graph());
+    EXPECT_EQ(dg.stage_info[dg.name_to_table.at("igrs.B"_cs)].min_stage, 1);
+}
+
 /**
  * The dependency graph is the following:
  *
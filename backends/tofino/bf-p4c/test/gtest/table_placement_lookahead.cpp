@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bf_gtest_helpers.h"
+#include "gtest/gtest.h"
+
+namespace P4::Test {
+
+namespace TablePlacementLookaheadTest {
+
+inline auto defs = R"(
+    match_kind {exact}
+    header H { bit<16> f1; bit<16> f2; bit<16> f3; bit<16> f4; bit<16> f5; bit<16> f6; }
+    struct headers_t { H h; }
+    struct local_metadata_t {} )";
+
+// A dependency chain t1 -> t2 -> t3 next to independent tables large enough to compete with
+// the chain for the memories of a stage, so the order of the placement decisions matters.
+inline auto control = R"(
+    action set_f2(bit<16> v) { hdr.h.f2 = v; }
+    action set_f3(bit<16> v) { hdr.h.f3 = v; }
+    action set_f4(bit<16> v) { hdr.h.f4 = v; }
+    action set_f5(bit<16> v) { hdr.h.f5 = v; }
+    action set_f6(bit<16> v) { hdr.h.f6 = v; }
+    table t1 { key = { hdr.h.f1 : exact; } actions = { set_f2; } size = 16*1024; }
+    table t2 { key = { hdr.h.f2 : exact; } actions = { set_f3; } size = 16*1024; }
+    table t3 { key = { hdr.h.f3 : exact; } actions = { set_f4; } size = 16*1024; }
+    table big1 { key = { hdr.h.f1 : exact; } actions = { set_f5; } size = 48*1024; }
+    table big2 { key = { hdr.h.f1 : exact; } actions = { set_f6; } size = 48*1024; }
+    apply {
+        t1.apply();
+        t2.apply();
+        t3.apply();
+        big1.apply();
+        big2.apply();
+    }
+)";
+
+using Placement = std::map<int, std::vector<std::string>>;
+
+/// Compiles the control with the given lookahead and returns the tables placed in each
+/// ingress stage, in assembly order, without their unique name suffixes.
+Placement place(const std::string &lookahead) {
+    // The options are global, so the lookahead is always set explicitly.
+    auto blk = TestCode(TestCode::Hdr::TofinoMin, TestCode::tofino_shell(),
+                        {defs, TestCode::empty_state(), control, TestCode::empty_appy()},
+                        TestCode::tofino_shell_control_marker(),
+                        {"--no-dead-code-elimination", "--table-placement-lookahead", lookahead});
+    EXPECT_TRUE(blk.CreateBackend());
+    EXPECT_TRUE(blk.apply_pass(TestCode::Pass::FullBackend));
+
+    static const std::regex stage_re(R"(^\s*stage (\d+) ingress:)");
+    static const std::regex table_re(
+        R"(^\s*(?:exact_match|ternary_match|hash_action) (\w+?)(?:_\d+)?[$.:])");
+    Placement placement;
+    int stage = -1;
+    std::istringstream asm_code(blk.extract_code(TestCode::CodeBlock::MauAsm));
+    std::string line;
+    std::smatch m;
+    while (std::getline(asm_code, line)) {
+        if (std::regex_search(line, m, stage_re))
+            stage = std::stoi(m[1]);
+        else if (stage >= 0 && std::regex_search(line, m, table_re))
+            placement[stage].push_back(m[1]);
+    }
+    return placement;
+}
+
+}  // namespace TablePlacementLookaheadTest
+
+TEST(TablePlacementLookahead, DeterministicAndNotWorse) {
+    using TablePlacementLookaheadTest::place;
+    auto sequential = place("0");
+    auto lookahead = place("2");
+    ASSERT_FALSE(sequential.empty());
+    ASSERT_FALSE(lookahead.empty());
+
+    // The speculations may run on several threads; the result must not depend on them.
+    EXPECT_EQ(lookahead, place("2"));
+
+    // A candidate is only preferred when it fits more tables in the stage, so the
+    // lookahead never needs more stages than the sequential placement.
+    EXPECT_LE(lookahead.rbegin()->first, sequential.rbegin()->first);
+}
+
+}  // namespace P4::Test
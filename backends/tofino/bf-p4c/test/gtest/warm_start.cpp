@@ -0,0 +1,189 @@
+/**
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backends/tofino/bf-p4c/common/warm_start.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "backends/tofino/bf-p4c/bf-p4c-options.h"
+#include "backends/tofino/bf-p4c/device.h"
+#include "backends/tofino/bf-p4c/phv/phv_fields.h"
+#include "backends/tofino/bf-p4c/test/gtest/bf_gtest_helpers.h"
+#include "backends/tofino/bf-p4c/test/gtest/tofino_gtest_utils.h"
+#include "gtest/gtest.h"
+#include "ir/ir.h"
+#include "lib/error.h"
+
+namespace P4::Test {
+
+namespace {
+
+/// A previous output directory with the given phv.json and resources.json logs; an empty log
+/// is not written.
+class LogDir {
+    std::filesystem::path dir;
+
+    void write(const char *name, const std::string &contents) {
+        if (contents.empty()) return;
+        std::ofstream(dir / "logs" / name) << contents;
+    }
+
+ public:
+    LogDir(const std::string &phv, const std::string &resources) {
+        dir = std::filesystem::temp_directory_path() /
+              ("warm_start_" + std::string(testing::UnitTest::GetInstance()
+                                               ->current_test_info()->name()));
+        std::filesystem::create_directories(dir / "logs");
+        write("phv.json", phv);
+        write("resources.json", resources);
+    }
+    ~LogDir() { std::filesystem::remove_all(dir); }
+
+    cstring path() const { return cstring(dir.string()); }
+};
+
+std::string phvLog(const std::string &phv_number) {
+    return R"({ "containers": [ {
+        "phv_number": )" + phv_number + R"(,
+        "gress": "ingress",
+        "slices": [ {
+            "field_slice": { "field_name": "hdr.a", "slice_info": { "lsb": 0, "msb": 15 } },
+            "slice_info": { "lsb": 8, "msb": 23 }
+        } ]
+    } ] })";
+}
+
+const char *resourcesLog = R"({ "resources": { "mau": { "mau_stages": [
+    { "stage_number": 3, "logical_tables": { "ids": [ { "table_name": "cond-1" } ] } },
+    { "stage_number": 1, "logical_tables": { "ids": [ { "table_name": "cond-1" } ] } }
+] } } })";
+
+const char *programDefs = R"(
+    match_kind {exact}
+    header H { bit<16> f1; bit<16> f2; bit<8> f3; bit<8> f4; }
+    struct headers_t { H h; }
+    struct local_metadata_t {} )";
+
+const char *programTables = R"(
+    action set_f2(bit<16> v) { hdr.h.f2 = v; }
+    action set_f3(bit<8> v) { hdr.h.f3 = v; }
+    action set_f4(bit<8> v) { hdr.h.f4 = v; }
+    table t1 { key = { hdr.h.f1 : exact; } actions = { set_f2; } }
+    table t2 { key = { hdr.h.f2 : exact; } actions = { set_f3; } } )";
+
+TestCode compileProgram(const std::string &control, std::initializer_list<std::string> options) {
+    return TestCode(TestCode::Hdr::TofinoMin, TestCode::tofino_shell(),
+                    {programDefs, "state start { packet.extract(hdr.h); transition accept; }",
+                     control, "apply { packet.emit(hdr); }"},
+                    TestCode::tofino_shell_control_marker(), options);
+}
+
+}  // namespace
+
+class WarmStartTest : public TofinoBackendTest {};
+
+TEST_F(WarmStartTest, ValidLogs) {
+    PHV::Container w0("W0");
+    unsigned address = Device::phvSpec().physicalAddress(w0, PhvSpec::MAU);
+    LogDir logs(phvLog(std::to_string(address)), resourcesLog);
+
+    auto warnings = ::warningCount();
+    auto *warm = WarmStart::load(logs.path());
+    ASSERT_NE(warm, nullptr);
+    EXPECT_EQ(::warningCount(), warnings);
+
+    PhvInfo phv;
+    auto *field = phv.add("ingress::hdr.a"_cs, INGRESS, 16, 0, false, false);
+    EXPECT_EQ(warm->container(field, 0), w0);
+    EXPECT_EQ(warm->container(field, 15), w0);
+    EXPECT_FALSE(warm->container(field, 16));
+
+    // A split table is placed in the first stage it is logged in
+    EXPECT_EQ(warm->stage(new IR::MAU::Table("cond-1"_cs, INGRESS)), 1);
+    EXPECT_FALSE(warm->stage(new IR::MAU::Table("cond-2"_cs, INGRESS)));
+}
+
+TEST_F(WarmStartTest, MissingLogs) {
+    LogDir logs("", "");
+
+    auto warnings = ::warningCount();
+    EXPECT_EQ(WarmStart::load(logs.path()), nullptr);
+    EXPECT_GT(::warningCount(), warnings);
+    EXPECT_EQ(::errorCount(), 0u);
+}
+
+TEST_F(WarmStartTest, MalformedPhvLog) {
+    // A string where an integer is expected, next to a valid resources log
+    LogDir logs(phvLog("\"W0\""), resourcesLog);
+
+    auto warnings = ::warningCount();
+    EXPECT_EQ(WarmStart::load(logs.path()), nullptr);
+    EXPECT_GT(::warningCount(), warnings);
+    EXPECT_EQ(::errorCount(), 0u);
+}
+
+TEST_F(WarmStartTest, MalformedResourcesLog) {
+    // A log cut short, and one without the MAU resources
+    for (std::string resources : {std::string(resourcesLog).substr(0, 40),
+                                  std::string(R"({ "resources": { "parser": {} } })")}) {
+        LogDir logs("", resources);
+
+        auto warnings = ::warningCount();
+        EXPECT_EQ(WarmStart::load(logs.path()), nullptr);
+        EXPECT_GT(::warningCount(), warnings);
+    }
+    EXPECT_EQ(::errorCount(), 0u);
+}
+
+TEST_F(WarmStartTest, KeepsUnchangedSlices) {
+    LogDir previous("", "");
+    const char *fields[] = {"hdr.h.f1", "hdr.h.f2", "hdr.h.f3", "hdr.h.f4"};
+
+    std::string before_phv;
+    {
+        auto blk = compileProgram(std::string(programTables) + "apply { t1.apply(); t2.apply(); }",
+                                  {"-o", previous.path().string()});
+        ASSERT_TRUE(blk.CreateBackend());
+        ASSERT_TRUE(blk.apply_pass(TestCode::Pass::FullBackend));
+        blk.set_phv_log_file(BFNContext::get().getOutputDirectory("logs"_cs, 0) + "/phv.json");
+        ASSERT_TRUE(blk.apply_pass(TestCode::Pass::PhvLogging));
+        before_phv = blk.extract_code(TestCode::CodeBlock::PhvAsm);
+    }
+
+    // The edit: one more table, writing a field that was only deparsed before
+    auto blk = compileProgram(std::string(programTables) + R"(
+            table t3 { key = { hdr.h.f3 : exact; } actions = { set_f4; } }
+            apply { t1.apply(); t2.apply(); t3.apply(); } )",
+                              {"--warm-start", previous.path().string()});
+    ASSERT_TRUE(blk.CreateBackend());
+    ASSERT_TRUE(blk.apply_pass(TestCode::Pass::FullBackend));
+    // The logs of the first compile were found, so this was not a cold start
+    EXPECT_NE(WarmStart::get(0), nullptr);
+
+    auto after_phv = blk.extract_code(TestCode::CodeBlock::PhvAsm);
+    for (auto *field : fields) {
+        auto container = blk.get_field_container(field, before_phv);
+        ASSERT_FALSE(container.empty()) << field << " not allocated in\n" << before_phv;
+        EXPECT_EQ(blk.get_field_container(field, after_phv), container)
+            << field << " moved, before:\n" << before_phv << "after:\n" << after_phv;
+    }
+}
+
+}  // namespace P4::Test
@@ -29,6 +29,16 @@ import testutils
 run_ebpf_test = importlib.import_module("run-ebpf-test")
 
 arg_parser = run_ebpf_test.PARSER
+arg_parser.add_argument(
+    "--burst",
+    dest="burst",
+    type=int,
+    default=0,
+    help=(
+        "Compile the program with --emit-burst and feed the packets to it in bursts "
+        "of this size. A size of 1 only checks the single packet entry point."
+    ),
+)
 
 if __name__ == "__main__":
     # Parse options and process argv
@@ -41,6 +51,7 @@ if __name__ == "__main__":
     options.cleanupTmp = args.nocleanup
     options.target = args.target
     options.extern = args.extern
+    options.burst = args.burst
     # Switch test directory based on path to run-ubpf-test.py
     options.runtimedir = str(FILE_DIR.joinpath("runtime"))
     options.testdir = tempfile.mkdtemp(dir=os.path.abspath("./"))
@@ -58,6 +69,8 @@ if __name__ == "__main__":
 
     # All args after '--' are intended for the p4 compiler
     argv = argv[1:]
+    if options.burst:
+        argv.append("--emit-burst")
     # Run the test with the extracted options and modified argv
     result = run_ebpf_test.run_test(options, argv)
     sys.exit(result)
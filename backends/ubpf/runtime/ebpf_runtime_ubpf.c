@@ -20,39 +20,63 @@ limitations under the License.
 
 #define PCAPOUT "_out.pcap"
 
+#ifndef UBPF_BURST
+#define UBPF_BURST 1
+#endif
+
+struct std_meta {
+    uint32_t input_port;
+    uint32_t packet_length;
+    uint32_t output_action;
+    uint32_t output_port;
+};
+
 pcap_list_t *feed_packets(packet_filter ebpf_filter, pcap_list_t *pkt_list, int debug) {
     pcap_list_t *output_pkts = allocate_pkt_list();
     uint32_t list_len = get_pkt_list_length(pkt_list);
-    for (uint32_t i = 0; i < list_len; i++) {
-        /* Parse each packet in the list and check the result */
-        struct dp_packet dp;
-        struct std_meta {
-            uint32_t input_port;
-            uint32_t packet_length;
-            uint32_t output_action;
-            uint32_t output_port;
-        };
-        struct std_meta md;
-        pcap_pkt *input_pkt = get_packet(pkt_list, i);
-        dp.data = (void *) input_pkt->data;
-        dp.size_ = input_pkt->pcap_hdr.len;
-
-        md.input_port = input_pkt->ifindex;
-        md.packet_length = dp.size_;
-        md.output_port = 0;
+    for (uint32_t first = 0; first < list_len; first += UBPF_BURST) {
+        uint32_t count = list_len - first < UBPF_BURST ? list_len - first : UBPF_BURST;
+        struct dp_packet dp[UBPF_BURST];
+        struct std_meta md[UBPF_BURST];
+        uint64_t result[UBPF_BURST];
+        for (uint32_t i = 0; i < count; i++) {
+            pcap_pkt *input_pkt = get_packet(pkt_list, first + i);
+            dp[i].data = (void *) input_pkt->data;
+            dp[i].size_ = input_pkt->pcap_hdr.len;
 
-        int result = ebpf_filter(&dp, (struct standard_metadata *) &md);
-        /* Updating input_pkt's length */
-        input_pkt->pcap_hdr.len = dp.size_;
-        input_pkt->pcap_hdr.caplen = dp.size_;
-        if (result != 0) {
-            /* We copy the entire content to emulate an outgoing packet */
-            pcap_pkt *out_pkt = copy_pkt(input_pkt);
-            out_pkt->ifindex = md.output_port;
-            output_pkts = append_packet(output_pkts, out_pkt);
+            md[i].input_port = input_pkt->ifindex;
+            md[i].packet_length = dp[i].size_;
+            md[i].output_port = 0;
+        }
+#if UBPF_BURST > 1
+        /* Parse the packets as a burst */
+        void *ctx[UBPF_BURST];
+        struct standard_metadata *std_meta[UBPF_BURST];
+        for (uint32_t i = 0; i < count; i++) {
+            ctx[i] = &dp[i];
+            std_meta[i] = (struct standard_metadata *) &md[i];
+        }
+        entry_burst(ctx, std_meta, result, count);
+#else
+        /* Parse each packet in the list */
+        for (uint32_t i = 0; i < count; i++)
+            result[i] = ebpf_filter(&dp[i], (struct standard_metadata *) &md[i]);
+#endif
+        /* Check the results */
+        for (uint32_t i = 0; i < count; i++) {
+            pcap_pkt *input_pkt = get_packet(pkt_list, first + i);
+            /* Updating input_pkt's length */
+            input_pkt->pcap_hdr.len = dp[i].size_;
+            input_pkt->pcap_hdr.caplen = dp[i].size_;
+            if (result[i] != 0) {
+                /* We copy the entire content to emulate an outgoing packet */
+                pcap_pkt *out_pkt = copy_pkt(input_pkt);
+                out_pkt->ifindex = md[i].output_port;
+                output_pkts = append_packet(output_pkts, out_pkt);
+            }
+            if (debug)
+                printf("Result of the eBPF parsing is: %d\n", (int) result[i]);
         }
-        if (debug)
-            printf("Result of the eBPF parsing is: %d\n", result);
     }
     return output_pkts;
 }
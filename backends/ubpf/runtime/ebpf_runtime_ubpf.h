@@ -24,20 +24,29 @@ limitations under the License.
 
 struct standard_metadata;
 
+/* Maximum number of entries of the tables initialized by the test runtime */
+#define UBPF_TEST_MAX_ENTRIES 1024
+
 extern uint64_t entry(void *, struct standard_metadata *);
 typedef uint64_t (*packet_filter)(void *dp, struct standard_metadata *std_meta);
+/* Generated with --emit-burst, used when the runtime is built with -DUBPF_BURST=<size> */
+extern uint64_t entry_burst(void **, struct standard_metadata **, uint64_t *, uint64_t);
 
 void *run_and_record_output(packet_filter entry, const char *pcap_base, pcap_list_t *pkt_list, int debug);
 
 static void inline init_ubpf_table_test(char *name, unsigned int key_size, unsigned int value_size) {
-    struct bpf_table tbl = {
-        .name = name,
-        .type = 0,
-        .key_size = key_size,
-        .value_size = value_size,
-        .bpf_map = NULL
-    };
-    registry_add(&tbl);
+    /* The registry keeps a pointer to the table, which must outlive this call */
+    struct bpf_table *tbl = calloc(1, sizeof(struct bpf_table));
+    if (!tbl) {
+        perror("Fatal: Could not allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    tbl->name = name;
+    tbl->type = 0;
+    tbl->key_size = key_size;
+    tbl->value_size = value_size;
+    tbl->max_entries = UBPF_TEST_MAX_ENTRIES;
+    registry_add(tbl);
 }
 
 
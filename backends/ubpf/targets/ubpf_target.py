@@ -28,6 +28,8 @@ class Target(EBPFTarget):
         # List of bpf programs to attach to the interface
         args += "BPFOBJ=" + self.template + " "
         args += "CFLAGS+=-DCONTROL_PLANE "
+        if getattr(self.options, "burst", 0) > 1:
+            args += f"CFLAGS+=-DUBPF_BURST={self.options.burst} "
         args += "EXTERNOBJ=" + self.options.extern + " "
 
         result = testutils.exec_process(args)
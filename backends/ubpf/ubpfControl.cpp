@@ -221,6 +221,11 @@ void UBPFControlBodyTranslator::processApply(const P4::ApplyMethod *method) {
 
     builder->emitIndent();
     builder->append("value = ");
+    if (control->program->options.emitBurst) {
+        // Within a burst the default action is looked up once, before the first packet.
+        auto inv = control->program->invariantsVar;
+        builder->appendFormat("%v ? %v->%v : ", inv, inv, table->defaultActionMapName);
+    }
     builder->target->emitTableLookup(builder, table->defaultActionMapName,
                                      control->program->zeroKey, valueName);
     builder->endOfStatement(true);
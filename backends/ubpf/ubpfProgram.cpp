@@ -76,11 +76,17 @@ void UBPFProgram::emitC(UbpfCodeBuilder *builder, const std::filesystem::path &h
     builder->emitIndent();
     builder->target->emitChecksumHelpers(builder);
 
-    builder->emitIndent();
-    builder->target->emitMain(builder, "entry"_cs, contextVar, stdMetadataVar);
+    if (options.emitBurst) {
+        emitInvariantsType(builder);
+        emitProcessFunction(builder);
+    } else {
+        builder->emitIndent();
+        builder->target->emitMain(builder, "entry"_cs, contextVar, stdMetadataVar);
+    }
     builder->blockStart();
 
-    emitPktVariable(builder);
+    // The packet data is a parameter of the process function.
+    if (!options.emitBurst) emitPktVariable(builder);
 
     emitPacketLengthVariable(builder);
 
@@ -124,6 +130,113 @@ void UBPFProgram::emitC(UbpfCodeBuilder *builder, const std::filesystem::path &h
     builder->appendFormat("return %v;\n", builder->target->dropReturnCode());
     builder->decreaseIndent();
     builder->blockEnd(true);
+
+    if (options.emitBurst) emitEntryFunctions(builder);
+}
+
+/// The loop-invariant values of a burst: the default action of each table, which the
+/// control plane does not change while a burst is processed.
+void UBPFProgram::emitInvariantsType(EBPF::CodeBuilder *builder) const {
+    builder->emitIndent();
+    builder->appendFormat("struct %v ", invariantsType);
+    builder->blockStart();
+    for (const auto &[name, table] : control->tables) {
+        builder->emitIndent();
+        builder->appendFormat("struct %v *%v;", table->valueTypeName, table->defaultActionMapName);
+        builder->newline();
+    }
+    if (control->tables.empty()) {
+        builder->emitIndent();
+        builder->append("uint8_t unused;");
+        builder->newline();
+    }
+    builder->blockEnd(false);
+    builder->endOfStatement(true);
+    builder->newline();
+}
+
+/// With --emit-burst the pipeline is generated in a function that is inlined both in the
+/// single packet entry point, which does not use invariants, and in the burst loop.
+void UBPFProgram::emitProcessFunction(UbpfCodeBuilder *builder) const {
+    builder->emitIndent();
+    builder->appendLine("static inline __attribute__((always_inline))");
+    builder->emitIndent();
+    builder->appendFormat(
+        "uint64_t %v(void *%v, void *%v, struct standard_metadata *%v, const struct %v *%v)",
+        processFunction, contextVar, packetStartVar, stdMetadataVar, invariantsType,
+        invariantsVar);
+}
+
+void UBPFProgram::emitEntryFunctions(UbpfCodeBuilder *builder) const {
+    builder->newline();
+    builder->emitIndent();
+    builder->target->emitMain(builder, "entry"_cs, contextVar, stdMetadataVar);
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("return %v(%v, ", processFunction, contextVar);
+    builder->target->emitGetPacketData(builder, contextVar);
+    builder->appendFormat(", %v, NULL)", stdMetadataVar);
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+    builder->newline();
+
+    // Processes count packets, stores the verdict of each of them in verdicts and returns
+    // the number of packets to forward. The data of the next packet is prefetched while
+    // the current one goes through the pipeline.
+    builder->emitIndent();
+    builder->appendFormat(
+        "uint64_t %v(void **%v, struct standard_metadata **%v, uint64_t *verdicts, "
+        "uint64_t count)",
+        burstFunction, contextVar, stdMetadataVar);
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("uint32_t %v = 0", zeroKey);
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("struct %v %v = ", invariantsType, invariantsVar);
+    builder->blockStart();
+    for (const auto &[name, table] : control->tables) {
+        builder->emitIndent();
+        builder->appendFormat(".%v = ", table->defaultActionMapName);
+        builder->target->emitTableLookup(builder, table->defaultActionMapName, zeroKey, ""_cs);
+        builder->append(",");
+        builder->newline();
+    }
+    builder->blockEnd(false);
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->append("uint64_t forwarded = 0");
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("void *%v = count ? ", packetStartVar);
+    builder->target->emitGetPacketData(builder, contextVar + "[0]");
+    builder->append(" : NULL");
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->append("for (uint64_t i = 0; i < count; i++) ");
+    builder->blockStart();
+    builder->emitIndent();
+    builder->append("void *next = i + 1 < count ? ");
+    builder->target->emitGetPacketData(builder, contextVar + "[i + 1]");
+    builder->append(" : NULL");
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendLine("if (next) __builtin_prefetch(next);");
+    builder->emitIndent();
+    builder->appendFormat("verdicts[i] = %v(%v[i], %v, %v[i], &%v)", processFunction, contextVar,
+                          packetStartVar, stdMetadataVar, invariantsVar);
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->append("forwarded += verdicts[i]");
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("%v = next", packetStartVar);
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+    builder->emitIndent();
+    builder->append("return forwarded");
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
 }
 
 void UBPFProgram::emitH(EBPF::CodeBuilder *builder, const std::filesystem::path &) {
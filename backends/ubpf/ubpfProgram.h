@@ -44,6 +44,8 @@ class UBPFProgram : public EBPF::EBPFProgram {
     cstring contextVar, outerHdrOffsetVar, outerHdrLengthVar;
     cstring stdMetadataVar;
     cstring packetTruncatedSizeVar;
+    // Used with --emit-burst only.
+    cstring processFunction, burstFunction, invariantsType, invariantsVar;
     cstring arrayIndexType = "uint32_t"_cs;
 
     UBPFProgram(const EbpfOptions &options, const IR::P4Program *program, P4::ReferenceMap *refMap,
@@ -59,6 +61,10 @@ class UBPFProgram : public EBPF::EBPFProgram {
         endLabel = cstring("deparser");
         stdMetadataVar = cstring("std_meta");
         packetTruncatedSizeVar = cstring("packetTruncatedSize");
+        processFunction = cstring("entry_process");
+        burstFunction = cstring("entry_burst");
+        invariantsType = cstring("entry_invariants");
+        invariantsVar = cstring("inv");
     }
 
     bool build() override;
@@ -73,6 +79,9 @@ class UBPFProgram : public EBPF::EBPFProgram {
     void emitMetadataInstance(EBPF::CodeBuilder *builder) const;
     void emitLocalVariables(EBPF::CodeBuilder *builder) override;
     void emitPipeline(EBPF::CodeBuilder *builder) override;
+    void emitInvariantsType(EBPF::CodeBuilder *builder) const;
+    void emitProcessFunction(UbpfCodeBuilder *builder) const;
+    void emitEntryFunctions(UbpfCodeBuilder *builder) const;
 
     bool isLibraryMethod(cstring methodName) override {
         static std::set<cstring> DEFAULT_METHODS = {
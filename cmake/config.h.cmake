@@ -1,6 +1,3 @@
-/* Define to 1 if you have the boost iostreams library */
-#cmakedefine HAVE_LIBBOOST_IOSTREAMS 1
-
 /* Define to 1 if you have the boost graph headers */
 #cmakedefine HAVE_LIBBOOST_GRAPH 1
 
@@ -22,27 +22,52 @@ namespace P4 {
 
 ResolutionContext::ResolutionContext() { anyOrder = P4CContext::get().options().isv1(); }
 
-const std::vector<const IR::IDeclaration *> &ResolutionContext::memoizeDeclarations(
-    const IR::INamespace *ns) const {
-    std::vector<const IR::IDeclaration *> decls;
-    if (const auto *nest = ns->to<IR::INestedNamespace>()) {
-        for (const auto *nn : nest->getNestedNamespaces()) {
-            auto *nnDecls = nn->getDeclarations();
-            decls.insert(decls.end(), nnDecls->begin(), nnDecls->end());
+NamespaceDeclIndex &NamespaceDeclIndex::get() {
+    static NamespaceDeclIndex index;
+    return index;
+}
+
+NamespaceDeclIndex::Entry &NamespaceDeclIndex::entry(const IR::INamespace *ns) {
+    auto &e = entries[ns];
+    int id = ns->getNode()->id;
+    if (e.nodeId != id) {
+        e = Entry();
+        e.nodeId = id;
+        if (const auto *nest = ns->to<IR::INestedNamespace>()) {
+            for (const auto *nn : nest->getNestedNamespaces()) {
+                auto *nnDecls = nn->getDeclarations();
+                e.decls.insert(e.decls.end(), nnDecls->begin(), nnDecls->end());
+            }
         }
+        auto *nsDecls = ns->getDeclarations();
+        e.decls.insert(e.decls.end(), nsDecls->begin(), nsDecls->end());
     }
+    e.lastUsed = generation;
+    return e;
+}
 
-    auto *nsDecls = ns->getDeclarations();
-    decls.insert(decls.end(), nsDecls->begin(), nsDecls->end());
+const std::vector<const IR::IDeclaration *> &NamespaceDeclIndex::declarations(
+    const IR::INamespace *ns) {
+    return entry(ns).decls;
+}
 
-    return (namespaceDecls[ns] = std::move(decls));
+const NamespaceDeclIndex::DeclsByName &NamespaceDeclIndex::declsByName(const IR::INamespace *ns) {
+    auto &e = entry(ns);
+    if (!e.hasByName) {
+        for (const auto *d : e.decls) e.byName[d->getName().name].push_back(d);
+        e.hasByName = true;
+    }
+    return e.byName;
 }
 
-ResolutionContext::NamespaceDeclsByName &ResolutionContext::memoizeDeclsByName(
-    const IR::INamespace *ns) const {
-    auto &namesToDecls = namespaceDeclNames[ns];
-    for (const auto *d : getDeclarations(ns)) namesToDecls[d->getName().name].push_back(d);
-    return namesToDecls;
+void NamespaceDeclIndex::newGeneration(unsigned keep) {
+    ++generation;
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (generation - it->second.lastUsed > keep)
+            entries.erase(it++);
+        else
+            ++it;
+    }
 }
 
 std::vector<const IR::IDeclaration *> ResolutionContext::resolve(const IR::ID &name,
@@ -379,6 +404,7 @@ void ResolveReferences::checkShadowing(const IR::INamespace *ns) const {
 
 Visitor::profile_t ResolveReferences::init_apply(const IR::Node *node) {
     anyOrder = refMap->isV1();
+    NamespaceDeclIndex::get().newGeneration();
     // Check shadowing even if the program map is up-to-date.
     if (!refMap->checkMap(node) || checkShadow) refMap->clear();
     return Inspector::init_apply(node);
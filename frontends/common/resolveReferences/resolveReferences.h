@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/container/node_hash_map.h"
 #include "frontends/common/parser_options.h"
 #include "ir/ir.h"
 #include "ir/pass_manager.h"
@@ -31,27 +32,46 @@ namespace P4 {
 /// Helper class to indicate types of nodes that may be returned during resolution.
 enum class ResolutionType { Any, Type, TypeVariable };
 
-/// Visitor mixin for looking up names in enclosing scopes from the Visitor::Context
-class ResolutionContext : virtual public Visitor, public DeclarationLookup {
- private:
-    // Returns a vector of the decls that exist in the given namespace, and caches the result
-    // for future lookups.
-    const std::vector<const IR::IDeclaration *> &memoizeDeclarations(
-        const IR::INamespace *ns) const;
-
+/// Program-wide index of the declarations directly visible in each namespace, shared by
+/// every ResolutionContext so that passes re-resolving names do not rebuild it each time.
+/// IR nodes are not modified once built, so an entry stays valid while its namespace node is
+/// alive; a namespace that changes is a new node and gets its own entry.  Entries are checked
+/// against the node's unique id, so an address reused by a new node is never served stale
+/// declarations.  Entries not used for a few generations (see newGeneration) are dropped.
+class NamespaceDeclIndex {
+ public:
     using DeclsVector = absl::InlinedVector<const IR::IDeclaration *, 2>;
-    using NamespaceDeclsByName = absl::flat_hash_map<cstring, DeclsVector, Util::Hash>;
+    using DeclsByName = absl::flat_hash_map<cstring, DeclsVector, Util::Hash>;
+
+    static NamespaceDeclIndex &get();
 
-    // Returns a mapping from name -> decl for the given namespace, and caches the result for
-    // future lookups.
-    NamespaceDeclsByName &memoizeDeclsByName(const IR::INamespace *ns) const;
+    /// Returns the decls that exist in the given namespace (including nested namespaces).
+    const std::vector<const IR::IDeclaration *> &declarations(const IR::INamespace *ns);
+    /// Returns a mapping from name -> decls for the given namespace.
+    const DeclsByName &declsByName(const IR::INamespace *ns);
 
-    mutable absl::flat_hash_map<const IR::INamespace *, std::vector<const IR::IDeclaration *>,
-                                Util::Hash>
-        namespaceDecls;
-    mutable absl::flat_hash_map<const IR::INamespace *, NamespaceDeclsByName, Util::Hash>
-        namespaceDeclNames;
+    /// Start a new generation, dropping entries that were not used in the last
+    /// @p keep generations.
+    void newGeneration(unsigned keep = 4);
+    void clear() { entries.clear(); }
 
+ private:
+    struct Entry {
+        int nodeId = -1;
+        unsigned lastUsed = 0;
+        bool hasByName = false;
+        std::vector<const IR::IDeclaration *> decls;
+        DeclsByName byName;
+    };
+    Entry &entry(const IR::INamespace *ns);
+
+    // node_hash_map, as callers hold references into entries while others are added
+    absl::node_hash_map<const IR::INamespace *, Entry, Util::Hash> entries;
+    unsigned generation = 0;
+};
+
+/// Visitor mixin for looking up names in enclosing scopes from the Visitor::Context
+class ResolutionContext : virtual public Visitor, public DeclarationLookup {
  protected:
     // Note that all errors have been merged by the parser into
     // a single error { } namespace.
@@ -96,17 +116,12 @@ class ResolutionContext : virtual public Visitor, public DeclarationLookup {
 
     /// Returns the set of decls that exist in the given namespace.
     auto getDeclarations(const IR::INamespace *ns) const {
-        auto nsIt = namespaceDecls.find(ns);
-        const auto &decls = nsIt != namespaceDecls.end() ? nsIt->second : memoizeDeclarations(ns);
-        return Util::iterator_range(decls);
+        return Util::iterator_range(NamespaceDeclIndex::get().declarations(ns));
     }
 
     /// Returns the set of decls with the given name that exist in the given namespace.
     auto getDeclsByName(const IR::INamespace *ns, cstring name) const {
-        auto nsIt = namespaceDeclNames.find(ns);
-        const auto &namesToDecls =
-            nsIt != namespaceDeclNames.end() ? nsIt->second : memoizeDeclsByName(ns);
-
+        const auto &namesToDecls = NamespaceDeclIndex::get().declsByName(ns);
         auto decls = namesToDecls.find(name);
         if (decls == namesToDecls.end())
             return Util::Enumerator<const IR::IDeclaration *>::emptyEnumerator();
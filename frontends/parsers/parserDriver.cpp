@@ -1,9 +1,15 @@
 #include "parserDriver.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <string_view>
 
 #include <boost/format.hpp>
@@ -17,20 +23,53 @@
 #include "frontends/parsers/v1/v1parser.hpp"
 #include "lib/error.h"
 
-#ifdef HAVE_LIBBOOST_IOSTREAMS
-
-#include <boost/iostreams/device/file_descriptor.hpp>
-#include <boost/iostreams/stream.hpp>
-
 namespace {
 
-/// A RAII helper class that provides an istream wrapper for a stdio FILE*. This
-/// is the efficient implementation for users with boost::iostreams installed.
+/// A read-only streambuf over a contiguous block of memory; reads copy straight out of the
+/// block into the lexer's buffer with no intermediate buffering.
+struct MemoryStreamBuf : public std::streambuf {
+    void reset(const char *begin, size_t size) {
+        char *p = const_cast<char *>(begin);
+        setg(p, p, p + size);
+    }
+};
+
+/// A RAII helper class that provides an istream wrapper for a stdio FILE*.  The whole input
+/// is made available as one contiguous block: a regular file (such as a saved preprocessor
+/// output) is memory-mapped, anything else (such as the preprocessor pipe) is read into a
+/// single buffer with large reads.
 struct AutoStdioInputStream {
-    explicit AutoStdioInputStream(FILE *in)
-        : source(fileno(in), boost::iostreams::never_close_handle),
-          buffer(source),
-          stream(&buffer) {}
+    explicit AutoStdioInputStream(FILE *in) : stream(&buffer) {
+        int fd = fileno(in);
+        struct stat st;
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && offset >= 0 && st.st_size > offset) {
+            void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                mapped = map;
+                mappedSize = st.st_size;
+                madvise(map, mappedSize, MADV_SEQUENTIAL);
+                buffer.reset(static_cast<const char *>(map) + offset, st.st_size - offset);
+                return;
+            }
+        }
+        size_t chunk = 1 << 16;
+        for (;;) {
+            size_t used = contents.size();
+            contents.resize(used + chunk);
+            ssize_t got;
+            do {
+                got = read(fd, &contents[used], chunk);
+            } while (got < 0 && errno == EINTR);
+            contents.resize(used + std::max<ssize_t>(got, 0));
+            if (got <= 0) break;
+            if (chunk < (1 << 24)) chunk *= 2;
+        }
+        buffer.reset(contents.data(), contents.size());
+    }
+    ~AutoStdioInputStream() {
+        if (mapped) munmap(mapped, mappedSize);
+    }
 
     std::istream &get() { return stream; }
 
@@ -38,41 +77,27 @@ struct AutoStdioInputStream {
     AutoStdioInputStream(const AutoStdioInputStream &) = delete;
     AutoStdioInputStream(AutoStdioInputStream &&) = delete;
 
-    boost::iostreams::file_descriptor_source source;
-    boost::iostreams::stream_buffer<boost::iostreams::file_descriptor_source> buffer;
+    void *mapped = nullptr;
+    size_t mappedSize = 0;
+    std::string contents;
+    MemoryStreamBuf buffer;
     std::istream stream;
 };
 
 }  // namespace
 
-#else
-
-namespace {
-
-/// A RAII helper class that provides an istream wrapper for a stdio FILE*. This
-/// is an inefficient fallback implementation.
-struct AutoStdioInputStream {
-    explicit AutoStdioInputStream(FILE *in) {
-        char buffer[512];
-        while (fgets(buffer, sizeof(buffer), in)) stream << buffer;
-    }
-
-    std::istream &get() { return stream; }
-
- private:
-    std::stringstream stream;
-};
-
-}  // namespace
-
-#endif
-
 namespace P4 {
 
 AbstractParserDriver::AbstractParserDriver() : sources(new Util::InputSources) {}
 
 AbstractParserDriver::~AbstractParserDriver() {}
 
+void AbstractParserDriver::reserveSources(std::istream &in) {
+    // when reading from memory (see AutoStdioInputStream) this is the whole input
+    auto avail = in.rdbuf()->in_avail();
+    if (avail > 0) sources->reserve(avail);
+}
+
 void AbstractParserDriver::onReadToken(const char *text) {
     auto posBeforeToken = sources->getCurrentPosition();
     sources->appendText(text);
@@ -142,6 +167,7 @@ bool P4ParserDriver::parse(AbstractP4Lexer &lexer, std::string_view sourceFile,
     LOG1("Parsing P4-16 program " << sourceFile);
 
     P4ParserDriver driver;
+    driver.reserveSources(in);
     P4Lexer lexer(in);
     if (!driver.parse(lexer, sourceFile, sourceLine)) return nullptr;
     return new IR::P4Program(driver.nodes->srcInfo, *driver.nodes);
@@ -157,6 +183,7 @@ bool P4ParserDriver::parse(AbstractP4Lexer &lexer, std::string_view sourceFile,
 P4ParserDriver::parseProgramSources(std::istream &in, std::string_view sourceFile,
                                     unsigned sourceLine /* = 1 */) {
     P4ParserDriver driver;
+    driver.reserveSources(in);
     P4Lexer lexer(in);
     if (!driver.parse(lexer, sourceFile, sourceLine)) {
         return {nullptr, nullptr};
@@ -317,6 +344,7 @@ V1ParserDriver::V1ParserDriver() : global(new IR::V1Program) {}
 
     // Create and configure the parser and lexer.
     V1ParserDriver driver;
+    driver.reserveSources(in);
     V1Lexer lexer(in);
     V1Parser parser(driver, lexer);
 
@@ -43,6 +43,9 @@ class AbstractParserDriver {
  protected:
     AbstractParserDriver();
 
+    /// Reserve space in `sources` for the input that is readily available from @in.
+    void reserveSources(std::istream &in);
+
     ////////////////////////////////////////////////////////////////////////////
     // Callbacks.
     ////////////////////////////////////////////////////////////////////////////
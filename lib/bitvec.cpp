@@ -23,21 +23,18 @@ limitations under the License.
 namespace P4 {
 
 std::ostream &operator<<(std::ostream &os, const bitvec &bv) {
-    if (bv.size == 1) {
-        os << hex(bv.data);
-    } else {
-        bool first = true;
-        for (int i = bv.size - 1; i >= 0; i--) {
-            if (first) {
-                if (!bv.ptr[i]) continue;
-                os << hex(bv.ptr[i]);
-                first = false;
-            } else {
-                os << hex(bv.ptr[i], sizeof(bv.data) * 2, '0');
-            }
+    const uintptr_t *w = bv.words();
+    bool first = true;
+    for (int i = bv.size - 1; i >= 0; i--) {
+        if (first) {
+            if (!w[i]) continue;
+            os << hex(w[i]);
+            first = false;
+        } else {
+            os << hex(w[i], sizeof(uintptr_t) * 2, '0');
         }
-        if (first) os << '0';
     }
+    if (first) os << '0';
     return os;
 }
 
@@ -77,27 +74,23 @@ bool operator>>(const char *s, bitvec &bv) {
 }
 
 bitvec &bitvec::operator>>=(size_t count) {
-    if (size == 1) {
-        if (count >= bits_per_unit)
-            data = 0;
-        else
-            data >>= count;
-        return *this;
-    }
-    int off = count / bits_per_unit;
+    uintptr_t *w = words();
+    size_t off = count / bits_per_unit;
     count %= bits_per_unit;
     for (size_t i = 0; i < size; i++)
         if (i + off < size) {
-            ptr[i] = ptr[i + off] >> count;
-            if (count && i + off + 1 < size) ptr[i] |= ptr[i + off + 1] << (bits_per_unit - count);
+            w[i] = w[i + off] >> count;
+            if (count && i + off + 1 < size) w[i] |= w[i + off + 1] << (bits_per_unit - count);
         } else {
-            ptr[i] = 0;
+            w[i] = 0;
+        }
+    if (!is_inline()) {
+        while (size > inline_units && !ptr[size - 1]) size--;
+        if (size == inline_units) {
+            uintptr_t *tmp = ptr;
+            memcpy(data, tmp, sizeof(data));
+            delete[] tmp;
         }
-    while (size > 1 && !ptr[size - 1]) size--;
-    if (size == 1) {
-        auto tmp = ptr[0];
-        delete[] ptr;
-        data = tmp;
     }
     return *this;
 }
@@ -105,18 +98,15 @@ bitvec &bitvec::operator>>=(size_t count) {
 bitvec &bitvec::operator<<=(size_t count) {
     size_t needsize = (max().index() + count + bits_per_unit) / bits_per_unit;
     if (needsize > size) expand(needsize);
-    if (size == 1) {
-        data <<= count;
-        return *this;
-    }
-    int off = count / bits_per_unit;
+    uintptr_t *w = words();
+    size_t off = count / bits_per_unit;
     count %= bits_per_unit;
-    for (int i = size - 1; i >= 0; i--)
+    for (size_t i = size; i-- > 0;)
         if (i >= off) {
-            ptr[i] = ptr[i - off] << count;
-            if (count && i > off) ptr[i] |= ptr[i - off - 1] >> (bits_per_unit - count);
+            w[i] = w[i - off] << count;
+            if (count && i > off) w[i] |= w[i - off - 1] >> (bits_per_unit - count);
         } else {
-            ptr[i] = 0;
+            w[i] = 0;
         }
     return *this;
 }
@@ -125,27 +115,45 @@ bitvec bitvec::getslice(size_t idx, size_t sz) const {
     if (sz == 0) return bitvec();
     if (idx >= size * bits_per_unit) return bitvec();
     if (idx + sz > size * bits_per_unit) sz = size * bits_per_unit - idx;
-    if (size > 1) {
-        bitvec rv;
-        unsigned shift = idx % bits_per_unit;
-        idx /= bits_per_unit;
-        if (sz > bits_per_unit) {
-            rv.expand((sz - 1) / bits_per_unit + 1);
-            for (size_t i = 0; i < rv.size; i++) {
-                if (shift != 0 && i != 0) rv.ptr[i - 1] |= ptr[idx + i] << (bits_per_unit - shift);
-                rv.ptr[i] = ptr[idx + i] >> shift;
-            }
-            if ((sz %= bits_per_unit))
-                rv.ptr[rv.size - 1] &= ~(~static_cast<uintptr_t>(1) << (sz - 1));
-        } else {
-            rv.data = ptr[idx] >> shift;
-            if (shift != 0 && idx + 1 < size) rv.data |= ptr[idx + 1] << (bits_per_unit - shift);
-            rv.data &= ~(~static_cast<uintptr_t>(1) << (sz - 1));
+    const uintptr_t *w = words();
+    unsigned shift = idx % bits_per_unit;
+    idx /= bits_per_unit;
+    size_t units = (sz - 1) / bits_per_unit + 1;
+    bitvec rv;
+    if (units > rv.size) rv.expand(units);
+    uintptr_t *rw = rv.words();
+    for (size_t i = 0; i < units; i++) {
+        rw[i] = w[idx + i] >> shift;
+        if (shift != 0 && idx + i + 1 < size) rw[i] |= w[idx + i + 1] << (bits_per_unit - shift);
+    }
+    if ((sz %= bits_per_unit)) rw[units - 1] &= ~(~static_cast<uintptr_t>(1) << (sz - 1));
+    return rv;
+}
+
+bool bitvec::orslice(size_t idx, const bitvec &a) {
+    assert(&a != this);
+    const uintptr_t *aw = a.words();
+    size_t units = a.size;
+    while (units > 0 && aw[units - 1] == 0) --units;
+    if (units == 0) return false;
+    unsigned shift = idx % bits_per_unit;
+    idx /= bits_per_unit;
+    size_t need = idx + units;
+    if (shift != 0 && (aw[units - 1] >> (bits_per_unit - shift)) != 0) need++;
+    if (need > size) expand(need);
+    uintptr_t *w = words();
+    uintptr_t changed = 0;
+    for (size_t i = 0; i < units; i++) {
+        uintptr_t lo = aw[i] << shift;
+        changed |= lo & ~w[idx + i];
+        w[idx + i] |= lo;
+        if (shift != 0 && idx + i + 1 < size) {
+            uintptr_t hi = aw[i] >> (bits_per_unit - shift);
+            changed |= hi & ~w[idx + i + 1];
+            w[idx + i + 1] |= hi;
         }
-        return rv;
-    } else {
-        return bitvec((data >> idx) & ~(~static_cast<uintptr_t>(1) << (sz - 1)));
     }
+    return changed != 0;
 }
 
 int bitvec::ffs(unsigned start) const {
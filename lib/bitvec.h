@@ -23,6 +23,7 @@ limitations under the License.
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <iostream>
 #include <type_traits>
 #include <utility>
@@ -118,17 +119,23 @@ int popcount(I x) {
 }  // namespace bv
 
 class bitvec {
+ public:
+    static constexpr size_t bits_per_unit = CHAR_BIT * sizeof(uintptr_t);
+    /* number of words stored inline in the bitvec object before it spills to the heap */
+    static constexpr size_t inline_units = 2;
+
+ private:
+    /* 'size' is never less than inline_units; words are inline iff size == inline_units */
     size_t size;
     union {
-        uintptr_t data;
+        uintptr_t data[inline_units];
         uintptr_t *ptr;
     };
-    uintptr_t word(size_t i) const { return i < size ? size > 1 ? ptr[i] : data : 0; }
-
- public:
-    static constexpr size_t bits_per_unit = CHAR_BIT * sizeof(uintptr_t);
+    bool is_inline() const { return size <= inline_units; }
+    uintptr_t *words() { return is_inline() ? data : ptr; }
+    const uintptr_t *words() const { return is_inline() ? data : ptr; }
+    uintptr_t word(size_t i) const { return i < size ? words()[i] : 0; }
 
- private:
     template <class T>
     class bitref {
         friend class bitvec;
@@ -219,38 +226,33 @@ class bitvec {
     // incomplete type errors
     class copy_bitref;
 
-    bitvec() : size(1), data(0) {}
-    explicit bitvec(uintptr_t v) : size(1), data(v) {}
+    bitvec() : size(inline_units), data{} {}
+    explicit bitvec(uintptr_t v) : size(inline_units), data{v} {}
     template <typename T, typename = typename std::enable_if<std::is_integral<T>::value &&
                                                              (sizeof(T) > sizeof(uintptr_t))>::type>
-    explicit bitvec(T v) : size(1), data(v) {
-        if (v != data) {
-            size = sizeof(v) / sizeof(data);
-            ptr = new IF_HAVE_LIBGC((PointerFreeGC)) uintptr_t[size];
-            for (unsigned i = 0; i < size; ++i) {
-                ptr[i] = v;
-                v >>= bits_per_unit;
-            }
-        }
-    }
-    bitvec(size_t lo, size_t cnt) : size(1), data(0) { setrange(lo, cnt); }
+    explicit bitvec(T v) : size(inline_units), data{} { setraw(v); }
+    bitvec(size_t lo, size_t cnt) : size(inline_units), data{} { setrange(lo, cnt); }
     bitvec(const bitvec &a) : size(a.size) {
-        if (size > 1) {
+        if (is_inline()) {
+            memcpy(data, a.data, sizeof(data));
+        } else {
             ptr = new IF_HAVE_LIBGC((PointerFreeGC)) uintptr_t[size];
             memcpy(ptr, a.ptr, size * sizeof(*ptr));
-        } else {
-            data = a.data;
         }
     }
-    bitvec(bitvec &&a) : size(a.size), data(a.data) { a.size = 1; }
+    bitvec(bitvec &&a) : size(a.size) {
+        memcpy(data, a.data, sizeof(data));
+        a.size = inline_units;
+        memset(a.data, 0, sizeof(a.data));
+    }
     bitvec &operator=(const bitvec &a) {
         if (this == &a) return *this;
-        if (size > 1) delete[] ptr;
-        if ((size = a.size) > 1) {
+        if (!is_inline()) delete[] ptr;
+        if ((size = a.size) > inline_units) {
             ptr = new IF_HAVE_LIBGC((PointerFreeGC)) uintptr_t[size];
             memcpy(ptr, a.ptr, size * sizeof(*ptr));
         } else {
-            data = a.data;
+            memcpy(data, a.data, sizeof(data));
         }
         return *this;
     }
@@ -260,103 +262,83 @@ class bitvec {
         return *this;
     }
     ~bitvec() {
-        if (size > 1) delete[] ptr;
+        if (!is_inline()) delete[] ptr;
     }
 
-    void clear() {
-        if (size > 1)
-            memset(ptr, 0, size * sizeof(*ptr));
-        else
-            data = 0;
-    }  // NOLINT(whitespace/newline)
+    void clear() { memset(words(), 0, size * sizeof(uintptr_t)); }
     bool setbit(size_t idx) {
         if (idx >= size * bits_per_unit) expand(1 + idx / bits_per_unit);
-        if (size > 1)
-            ptr[idx / bits_per_unit] |= (uintptr_t)1 << (idx % bits_per_unit);
-        else
-            data |= (uintptr_t)1 << idx;
+        words()[idx / bits_per_unit] |= (uintptr_t)1 << (idx % bits_per_unit);
         return true;
     }
     void setrange(size_t idx, size_t sz) {
         if (sz == 0) return;
         if (idx + sz > size * bits_per_unit) expand(1 + (idx + sz - 1) / bits_per_unit);
-        if (size == 1) {
-            data |= ~(~(uintptr_t)1 << (sz - 1)) << idx;
-        } else if (idx / bits_per_unit == (idx + sz - 1) / bits_per_unit) {
-            ptr[idx / bits_per_unit] |= ~(~(uintptr_t)1 << (sz - 1)) << (idx % bits_per_unit);
+        uintptr_t *w = words();
+        if (idx / bits_per_unit == (idx + sz - 1) / bits_per_unit) {
+            w[idx / bits_per_unit] |= ~(~(uintptr_t)1 << (sz - 1)) << (idx % bits_per_unit);
         } else {
             size_t i = idx / bits_per_unit;
-            ptr[i] |= ~(uintptr_t)0 << (idx % bits_per_unit);
+            w[i] |= ~(uintptr_t)0 << (idx % bits_per_unit);
             idx += sz;
-            while (++i < idx / bits_per_unit) {
-                ptr[i] = ~(uintptr_t)0;
-            }
-            if (i < size) ptr[i] |= (((uintptr_t)1 << (idx % bits_per_unit)) - 1);
+            size_t last = idx / bits_per_unit;
+            if (++i < last) memset(w + i, 0xff, (last - i) * sizeof(uintptr_t));
+            if (last < size) w[last] |= (((uintptr_t)1 << (idx % bits_per_unit)) - 1);
         }
     }
     void setraw(uintptr_t raw) {
-        if (size == 1) {
-            data = raw;
-        } else {
-            ptr[0] = raw;
-            for (size_t i = 1; i < size; i++) ptr[i] = 0;
-        }
+        uintptr_t *w = words();
+        w[0] = raw;
+        memset(w + 1, 0, (size - 1) * sizeof(uintptr_t));
     }
     template <typename T, typename = typename std::enable_if<std::is_integral<T>::value &&
                                                              (sizeof(T) > sizeof(uintptr_t))>::type>
     void setraw(T raw) {
         if (sizeof(T) / sizeof(uintptr_t) > size) expand(sizeof(T) / sizeof(uintptr_t));
-        for (size_t i = 0; i < size; i++) {
-            ptr[i] = raw;
+        uintptr_t *w = words();
+        size_t i = 0;
+        for (; i < sizeof(T) / sizeof(uintptr_t); i++) {
+            w[i] = raw;
             raw >>= bits_per_unit;
         }
+        for (; i < size; i++) w[i] = 0;
     }
     void setraw(uintptr_t *raw, size_t sz) {
         if (sz > size) expand(sz);
-        if (size == 1) {
-            data = raw[0];
-        } else {
-            for (size_t i = 0; i < sz; i++) ptr[i] = raw[i];
-            for (size_t i = sz; i < size; i++) ptr[i] = 0;
-        }
+        uintptr_t *w = words();
+        memcpy(w, raw, sz * sizeof(uintptr_t));
+        memset(w + sz, 0, (size - sz) * sizeof(uintptr_t));
     }
     template <typename T, typename = typename std::enable_if<std::is_integral<T>::value &&
                                                              (sizeof(T) > sizeof(uintptr_t))>::type>
     void setraw(T *raw, size_t sz) {
         constexpr size_t m = sizeof(T) / sizeof(uintptr_t);
         if (m * sz > size) expand(m * sz);
+        uintptr_t *w = words();
         size_t i = 0;
-        for (; i < sz * m; ++i) ptr[i] = raw[i / m] >> ((i % m) * bits_per_unit);
-        for (; i < size; ++i) ptr[i] = 0;
+        for (; i < sz * m; ++i) w[i] = raw[i / m] >> ((i % m) * bits_per_unit);
+        for (; i < size; ++i) w[i] = 0;
     }
     bool clrbit(size_t idx) {
         if (idx >= size * bits_per_unit) return false;
-        if (size > 1)
-            ptr[idx / bits_per_unit] &= ~((uintptr_t)1 << (idx % bits_per_unit));
-        else
-            data &= ~((uintptr_t)1 << idx);
+        words()[idx / bits_per_unit] &= ~((uintptr_t)1 << (idx % bits_per_unit));
         return false;
     }
     void clrrange(size_t idx, size_t sz) {
         if (sz == 0) return;
-        if (size < sz / bits_per_unit)  // To avoid sz + idx overflow
-            sz = size * bits_per_unit;
         if (idx >= size * bits_per_unit) return;
-        if (size == 1) {
-            if (idx + sz < bits_per_unit)
-                data &= ~(~(~(uintptr_t)1 << (sz - 1)) << idx);
-            else
-                data &= ~(~(uintptr_t)0 << idx);
-        } else if (idx / bits_per_unit == (idx + sz - 1) / bits_per_unit) {
-            ptr[idx / bits_per_unit] &= ~(~(~(uintptr_t)1 << (sz - 1)) << (idx % bits_per_unit));
+        if (sz > size * bits_per_unit - idx)  // To avoid sz + idx overflow
+            sz = size * bits_per_unit - idx;
+        uintptr_t *w = words();
+        if (idx / bits_per_unit == (idx + sz - 1) / bits_per_unit) {
+            w[idx / bits_per_unit] &= ~(~(~(uintptr_t)1 << (sz - 1)) << (idx % bits_per_unit));
         } else {
             size_t i = idx / bits_per_unit;
-            ptr[i] &= ~(~(uintptr_t)0 << (idx % bits_per_unit));
+            w[i] &= ~(~(uintptr_t)0 << (idx % bits_per_unit));
             idx += sz;
-            while (++i < idx / bits_per_unit && i < size) {
-                ptr[i] = 0;
-            }
-            if (i < size) ptr[i] &= ~(((uintptr_t)1 << (idx % bits_per_unit)) - 1);
+            size_t last = idx / bits_per_unit;
+            if (++i < last) memset(w + i, 0, (last - i) * sizeof(uintptr_t));
+            if (last < size) w[last] &= ~(((uintptr_t)1 << (idx % bits_per_unit)) - 1);
         }
     }
     bool getbit(size_t idx) const {
@@ -365,44 +347,40 @@ class bitvec {
     uintmax_t getrange(size_t idx, size_t sz) const {
         assert(sz > 0 && sz <= CHAR_BIT * sizeof(uintmax_t));
         if (idx >= size * bits_per_unit) return 0;
-        if (size > 1) {
-            unsigned shift = idx % bits_per_unit;
-            idx /= bits_per_unit;
-            uintmax_t rv = ptr[idx] >> shift;
-            shift = bits_per_unit - shift;
-            while (shift < sz) {
-                if (++idx >= size) break;
-                rv |= (uintmax_t)ptr[idx] << shift;
-                shift += bits_per_unit;
-            }
-            return rv & ~(~(uintmax_t)1 << (sz - 1));
-        } else {
-            return (data >> idx) & ~(~(uintmax_t)1 << (sz - 1));
+        const uintptr_t *w = words();
+        unsigned shift = idx % bits_per_unit;
+        idx /= bits_per_unit;
+        uintmax_t rv = w[idx] >> shift;
+        shift = bits_per_unit - shift;
+        while (shift < sz) {
+            if (++idx >= size) break;
+            rv |= (uintmax_t)w[idx] << shift;
+            shift += bits_per_unit;
         }
+        return rv & ~(~(uintmax_t)1 << (sz - 1));
     }
     void putrange(size_t idx, size_t sz, uintmax_t v) {
         assert(sz > 0 && sz <= CHAR_BIT * sizeof(uintmax_t));
         uintptr_t mask = ~(uintmax_t)0 >> (CHAR_BIT * sizeof(uintmax_t) - sz);
         v &= mask;
         if (idx + sz > size * bits_per_unit) expand(1 + (idx + sz - 1) / bits_per_unit);
-        if (size == 1) {
-            data &= ~(mask << idx);
-            data |= v << idx;
-        } else {
-            unsigned shift = idx % bits_per_unit;
-            idx /= bits_per_unit;
-            ptr[idx] &= ~(mask << shift);
-            ptr[idx] |= v << shift;
-            shift = bits_per_unit - shift;
-            while (shift < sz) {
-                assert(idx + 1 < size);
-                ptr[++idx] &= ~(mask >> shift);
-                ptr[idx] |= v >> shift;
-                shift += bits_per_unit;
-            }
+        uintptr_t *w = words();
+        unsigned shift = idx % bits_per_unit;
+        idx /= bits_per_unit;
+        w[idx] &= ~(mask << shift);
+        w[idx] |= v << shift;
+        shift = bits_per_unit - shift;
+        while (shift < sz) {
+            assert(idx + 1 < size);
+            w[++idx] &= ~(mask >> shift);
+            w[idx] |= v >> shift;
+            shift += bits_per_unit;
         }
     }
     bitvec getslice(size_t idx, size_t sz) const;
+    /* OR 'a' into this bitvec starting at bit 'idx', a word at a time; same as
+     * *this |= a << idx without building the shifted copy.  Returns true if any bit changed */
+    bool orslice(size_t idx, const bitvec &a);
     nonconst_bitref operator[](int idx) { return nonconst_bitref(*this, idx); }
     bool operator[](int idx) const { return getbit(idx); }
     int ffs(unsigned start = 0) const;
@@ -421,41 +399,31 @@ class bitvec {
     nonconst_bitref begin() & { return min(); }
     nonconst_bitref end() & { return nonconst_bitref(*this, -1); }
     bool empty() const {
-        for (size_t i = 0; i < size; i++)
-            if (word(i) != 0) return false;
-        return true;
+        const uintptr_t *w = words();
+        uintptr_t any = 0;
+        for (size_t i = 0; i < size; i++) any |= w[i];
+        return any == 0;
     }
     explicit operator bool() const { return !empty(); }
+
+    /* The word loops below are written without early exits or data-dependent branches
+     * (accumulating a 'changed' mask instead) so that the compiler can vectorize them over
+     * the contiguous word array, whether the words are inline or on the heap. */
     bool operator&=(const bitvec &a) {
-        bool rv = false;
-        if (size > 1) {
-            if (a.size > 1) {
-                for (size_t i = 0; i < size && i < a.size; i++) {
-                    rv |= ((ptr[i] & a.ptr[i]) != ptr[i]);
-                    ptr[i] &= a.ptr[i];
-                }
-            } else {
-                rv |= ((*ptr & a.data) != *ptr);
-                *ptr &= a.data;
-            }
-            if (size > a.size) {
-                if (!rv) {
-                    for (size_t i = a.size; i < size; i++)
-                        if (ptr[i]) {
-                            rv = true;
-                            break;
-                        }
-                }
-                memset(ptr + a.size, 0, (size - a.size) * sizeof(*ptr));
-            }
-        } else if (a.size > 1) {
-            rv |= ((data & a.ptr[0]) != data);
-            data &= a.ptr[0];
-        } else {
-            rv |= ((data & a.data) != data);
-            data &= a.data;
+        uintptr_t *w = words();
+        const uintptr_t *aw = a.words();
+        size_t common = std::min(size, a.size);
+        uintptr_t changed = 0;
+        for (size_t i = 0; i < common; i++) {
+            uintptr_t t = w[i] & aw[i];
+            changed |= t ^ w[i];
+            w[i] = t;
         }
-        return rv;
+        for (size_t i = common; i < size; i++) {
+            changed |= w[i];
+            w[i] = 0;
+        }
+        return changed != 0;
     }
     bitvec operator&(const bitvec &a) const {
         if (size <= a.size) {
@@ -469,28 +437,19 @@ class bitvec {
         }
     }
     bool operator|=(const bitvec &a) {
-        bool rv = false;
         if (size < a.size) expand(a.size);
-        if (size > 1) {
-            if (a.size > 1) {
-                for (size_t i = 0; i < a.size; i++) {
-                    rv |= ((ptr[i] | a.ptr[i]) != ptr[i]);
-                    ptr[i] |= a.ptr[i];
-                }
-            } else {
-                rv |= ((*ptr | a.data) != *ptr);
-                *ptr |= a.data;
-            }
-        } else {
-            rv |= ((data | a.data) != data);
-            data |= a.data;
+        uintptr_t *w = words();
+        const uintptr_t *aw = a.words();
+        uintptr_t changed = 0;
+        for (size_t i = 0; i < a.size; i++) {
+            changed |= aw[i] & ~w[i];
+            w[i] |= aw[i];
         }
-        return rv;
+        return changed != 0;
     }
     bool operator|=(uintptr_t a) {
-        bool rv = false;
-        auto t = size > 1 ? ptr : &data;
-        rv |= ((*t | a) != *t);
+        uintptr_t *t = words();
+        bool rv = (*t | a) != *t;
         *t |= a;
         return rv;
     }
@@ -518,15 +477,9 @@ class bitvec {
     }
     bitvec &operator^=(const bitvec &a) {
         if (size < a.size) expand(a.size);
-        if (size > 1) {
-            if (a.size > 1) {
-                for (size_t i = 0; i < a.size; i++) ptr[i] ^= a.ptr[i];
-            } else {
-                *ptr ^= a.data;
-            }
-        } else {
-            data ^= a.data;
-        }
+        uintptr_t *w = words();
+        const uintptr_t *aw = a.words();
+        for (size_t i = 0; i < a.size; i++) w[i] ^= aw[i];
         return *this;
     }
     bitvec operator^(const bitvec &a) const {
@@ -535,25 +488,15 @@ class bitvec {
         return rv;
     }
     bool operator-=(const bitvec &a) {
-        bool rv = false;
-        if (size > 1) {
-            if (a.size > 1) {
-                for (size_t i = 0; i < size && i < a.size; i++) {
-                    rv |= ((ptr[i] & ~a.ptr[i]) != ptr[i]);
-                    ptr[i] &= ~a.ptr[i];
-                }
-            } else {
-                rv |= ((*ptr & ~a.data) != *ptr);
-                *ptr &= ~a.data;
-            }
-        } else if (a.size > 1) {
-            rv |= ((data & ~a.ptr[0]) != data);
-            data &= ~a.ptr[0];
-        } else {
-            rv |= ((data & ~a.data) != data);
-            data &= ~a.data;
+        uintptr_t *w = words();
+        const uintptr_t *aw = a.words();
+        size_t common = std::min(size, a.size);
+        uintptr_t changed = 0;
+        for (size_t i = 0; i < common; i++) {
+            changed |= w[i] & aw[i];
+            w[i] &= ~aw[i];
         }
-        return rv;
+        return changed != 0;
     }
     bitvec operator-(const bitvec &a) const {
         bitvec rv(*this);
@@ -578,16 +521,20 @@ class bitvec {
     bool operator>=(const bitvec &a) const { return !(*this < a); }
     bool operator<=(const bitvec &a) const { return !(a < *this); }
     bool intersects(const bitvec &a) const {
-        for (size_t i = 0; i < size && i < a.size; i++)
-            if (word(i) & a.word(i)) return true;
-        return false;
+        const uintptr_t *w = words();
+        const uintptr_t *aw = a.words();
+        uintptr_t any = 0;
+        for (size_t i = 0; i < size && i < a.size; i++) any |= w[i] & aw[i];
+        return any != 0;
     }
     bool contains(const bitvec &a) const {  // is 'a' a subset or equal to 'this'?
-        for (size_t i = 0; i < size && i < a.size; i++)
-            if ((word(i) & a.word(i)) != a.word(i)) return false;
-        for (size_t i = size; i < a.size; i++)
-            if (a.word(i)) return false;
-        return true;
+        const uintptr_t *w = words();
+        const uintptr_t *aw = a.words();
+        uintptr_t missing = 0;
+        size_t i = 0;
+        for (; i < size && i < a.size; i++) missing |= aw[i] & ~w[i];
+        for (; i < a.size; i++) missing |= aw[i];
+        return missing == 0;
     }
     bitvec &operator>>=(size_t count);
     bitvec &operator<<=(size_t count);
@@ -604,8 +551,9 @@ class bitvec {
     void rotate_right(size_t start_bit, size_t rotation_idx, size_t end_bit);
     bitvec rotate_right_copy(size_t start_bit, size_t rotation_idx, size_t end_bit) const;
     int popcount() const {
+        const uintptr_t *w = words();
         int rv = 0;
-        for (size_t i = 0; i < size; i++) rv += bv::popcount(word(i));
+        for (size_t i = 0; i < size; i++) rv += bv::popcount(w[i]);
         return rv;
     }
     bool is_contiguous() const;
@@ -622,18 +570,15 @@ class bitvec {
             m |= m >> 16;
             newsize = (newsize + m) & ~m;
         }
-        if (size > 1) {
-            uintptr_t *old = ptr;
-            ptr = new IF_HAVE_LIBGC((PointerFreeGC)) uintptr_t[newsize];
-            memcpy(ptr, old, size * sizeof(*ptr));
-            memset(ptr + size, 0, (newsize - size) * sizeof(*ptr));
-            delete[] old;
+        uintptr_t *n = new IF_HAVE_LIBGC((PointerFreeGC)) uintptr_t[newsize];
+        if (is_inline()) {
+            memcpy(n, data, sizeof(data));
         } else {
-            uintptr_t d = data;
-            ptr = new IF_HAVE_LIBGC((PointerFreeGC)) uintptr_t[newsize];
-            *ptr = d;
-            memset(ptr + size, 0, (newsize - size) * sizeof(*ptr));
+            memcpy(n, ptr, size * sizeof(*n));
+            delete[] ptr;
         }
+        memset(n + size, 0, (newsize - size) * sizeof(*n));
+        ptr = n;
         size = newsize;
     }
 
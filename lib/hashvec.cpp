@@ -119,7 +119,20 @@ static size_t (*mod_hashsize[])(size_t x) = {
     mod_ffffffff,
 };
 
+uint8_t hash_vector_base::hashtag(size_t hash) {
+    // slot selection uses the low bits of the hash, so mix before taking the top 7 bits
+    return 0x80 | ((static_cast<uint64_t>(hash) * UINT64_C(0x9e3779b97f4a7c15)) >> 57);
+}
+
+void hash_vector_base::setslot(size_t slot, uint32_t idx, uint8_t tag) {
+    info->sethash(this, slot, idx);
+    ctrl[slot] = idx ? tag : 0;
+    if (slot < ctrl_group - 1) ctrl[hashsize + slot] = ctrl[slot];
+}
+
 void hash_vector_base::allochash() {
+    ctrl = new uint8_t[hashsize + ctrl_group - 1];
+    memset(ctrl, 0, hashsize + ctrl_group - 1);
     // FIXME -- all switch cases are doing the same thing (just with different types) so
     // it should be possible to simplify this
     switch (info->hashelsize) {
@@ -153,6 +166,8 @@ void hash_vector_base::freehash() {
             break;
     }
     hash.s1 = nullptr;
+    delete[] ctrl;
+    ctrl = nullptr;
 }
 
 hash_vector_base::hash_vector_base(bool ismap, bool ismulti, size_t capacity) {
@@ -208,6 +223,7 @@ hash_vector_base::hash_vector_base(const hash_vector_base &a)
       erased(a.erased) {
     allochash();
     memcpy(hash.s1, a.hash.s1, hashsize * info->hashelsize);
+    memcpy(ctrl, a.ctrl, hashsize + ctrl_group - 1);
 }
 
 hash_vector_base::hash_vector_base(hash_vector_base &&a)
@@ -219,6 +235,8 @@ hash_vector_base::hash_vector_base(hash_vector_base &&a)
       erased(a.erased) {
     hash.s1 = a.hash.s1;
     a.hash.s1 = nullptr;
+    ctrl = a.ctrl;
+    a.ctrl = nullptr;
 }
 
 hash_vector_base &hash_vector_base::operator=(const hash_vector_base &a) {
@@ -232,6 +250,7 @@ hash_vector_base &hash_vector_base::operator=(const hash_vector_base &a) {
         erased = a.erased;
         allochash();
         memcpy(hash.s1, a.hash.s1, hashsize * info->hashelsize);
+        memcpy(ctrl, a.ctrl, hashsize + ctrl_group - 1);
     }
     return *this;
 }
@@ -247,6 +266,8 @@ hash_vector_base &hash_vector_base::operator=(hash_vector_base &&a) {
         erased = a.erased;
         hash.s1 = a.hash.s1;
         a.hash.s1 = nullptr;
+        ctrl = a.ctrl;
+        a.ctrl = nullptr;
     }
     return *this;
 }
@@ -262,36 +283,64 @@ void hash_vector_base::clear() {
     allochash();
 }
 
-size_t hash_vector_base::find(const void *key, lookup_cache *cache) const {
-    size_t hash = mod_hashsize[log_hashsize](hashfn(key));
-    size_t idx, collisions = 0;
-    while ((idx = info->gethash(this, hash)) && (erased[idx - 1] || !cmpfn(key, idx - 1))) {
-        if (++collisions >= hashsize) {
-            idx = 0;
-            break;
+/* load a group of control bytes such that the byte for the first slot is least significant */
+static inline uint64_t load_group(const uint8_t *p) {
+    uint64_t g;
+    memcpy(&g, p, sizeof(g));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    g = __builtin_bswap64(g);
+#endif
+    return g;
+}
+
+/* Linear probe from 'slot' for 'key' (whose tag is in cache->tag), looking at ctrl_group
+ * slots at a time.  Within a group, bytes matching the tag and bytes that are empty are found
+ * with word-wide bit tricks, so keys are only compared for slots whose tag matches.  Results
+ * (slot and collision count) are identical to a slot-by-slot linear probe. */
+size_t hash_vector_base::probe(const void *key, size_t slot, size_t collisions,
+                               lookup_cache *cache) const {
+    static_assert(ctrl_group == sizeof(uint64_t), "control group must be one 64-bit word");
+    const uint64_t lsbs = UINT64_C(0x0101010101010101), msbs = UINT64_C(0x8080808080808080);
+    const uint64_t pattern = lsbs * cache->tag;
+    while (collisions < hashsize) {
+        uint64_t group = load_group(ctrl + slot);
+        uint64_t x = group ^ pattern;
+        uint64_t match = (x - lsbs) & ~x & msbs;  // may have false positives; never negatives
+        uint64_t empty = ~group & msbs;
+        size_t span = empty ? bv::count_trailing_zeroes(empty) / CHAR_BIT : ctrl_group;
+        for (; match; match &= match - 1) {
+            size_t i = bv::count_trailing_zeroes(match) / CHAR_BIT;
+            if (i >= span || collisions + i >= hashsize) break;
+            size_t s = slot + i;
+            if (s >= hashsize) s -= hashsize;
+            size_t idx = info->gethash(this, s);
+            if (!erased[idx - 1] && cmpfn(key, idx - 1)) {
+                cache->slot = s;
+                cache->collisions = collisions + i;
+                return idx;
+            }
         }
-        if (++hash == hashsize) hash = 0;
+        if (collisions + span >= hashsize) span = hashsize - collisions;
+        collisions += span;
+        if ((slot += span) >= hashsize) slot -= hashsize;
+        if (span < ctrl_group) break;
     }
-    cache->slot = hash;
+    cache->slot = slot;
     cache->collisions = collisions;
-    return idx;
+    return 0;
+}
+
+size_t hash_vector_base::find(const void *key, lookup_cache *cache) const {
+    size_t hash = hashfn(key);
+    cache->tag = hashtag(hash);
+    return probe(key, mod_hashsize[log_hashsize](hash), 0, cache);
 }
 
 size_t hash_vector_base::find_next(const void *key, lookup_cache *cache) const {
     size_t hash = cache->slot;
-    size_t idx, collisions = cache->collisions;
-    if (!(idx = info->gethash(this, hash))) return idx;
+    if (!info->gethash(this, hash)) return 0;
     if (++hash == hashsize) hash = 0;
-    while ((idx = info->gethash(this, hash)) && (erased[idx - 1] || !cmpfn(key, idx - 1))) {
-        if (++collisions >= hashsize) {
-            idx = 0;
-            break;
-        }
-        if (++hash == hashsize) hash = 0;
-    }
-    cache->slot = hash;
-    cache->collisions = collisions;
-    return idx;
+    return probe(key, hash, cache->collisions, cache);
 }
 
 void *hash_vector_base::lookup(const void *key, lookup_cache *cache) {
@@ -312,6 +361,7 @@ void hash_vector_base::redo_hash() {
     size_t i, j;
     lookup_cache cache;
     memset(hash.s1, 0, hashsize * info->hashelsize);
+    memset(ctrl, 0, hashsize + ctrl_group - 1);
     collisions = 0;
     size_t limit = this->limit();
     auto erased = this->erased;
@@ -330,7 +380,7 @@ void hash_vector_base::redo_hash() {
         if (j != i) {
             moveentry(j, i);
         }
-        info->sethash(this, cache.slot, ++j);
+        setslot(cache.slot, ++j, cache.tag);
         collisions += cache.collisions;
     }
     resizedata(j);
@@ -405,7 +455,7 @@ size_t hash_vector_base::hv_insert(const void *key, lookup_cache *cache) {
                 while (find_next(key, cache)) {
                 }
         }
-        info->sethash(this, cache->slot, limit() + 1);
+        setslot(cache->slot, limit() + 1, cache->tag);
         inuse++;
         return -1;
     } else if (erased[idx - 1]) {
@@ -433,7 +483,7 @@ size_t hash_vector_base::remove(const void *key, lookup_cache *cache) {
         if (!erased[idx - 1]) inuse--;
         if (idx == limit()) {
             resizedata(idx - 1);
-            info->sethash(this, cache->slot, 0);
+            setslot(cache->slot, 0, 0);
             collisions -= cache->collisions;
         } else {
             erased[idx - 1] = 1;
@@ -35,6 +35,12 @@ class hash_vector_base {
         uint32_t *s3;
         // FIXME -- add uint64_t for vectors of more than 2**32 elements?
     } hash;
+    /* Control bytes, one per hash slot: 0 for an empty slot, otherwise 0x80 | 7 bits of the
+     * key's hash.  Probing scans a group of these at a time and only compares keys (via the
+     * virtual cmpfn) on a tag match.  The first ctrl_group-1 bytes are mirrored past the end
+     * so a group can be loaded without wrapping. */
+    uint8_t *ctrl;
+    static constexpr size_t ctrl_group = 8;
     static uint32_t gethash_s1(const hash_vector_base *, size_t);
     static uint32_t gethash_s2(const hash_vector_base *, size_t);
     static uint32_t gethash_s3(const hash_vector_base *, size_t);
@@ -43,6 +49,8 @@ class hash_vector_base {
     static void sethash_s3(hash_vector_base *, size_t, uint32_t);
     void allochash();
     void freehash();
+    static uint8_t hashtag(size_t hash);
+    void setslot(size_t slot, uint32_t idx, uint8_t tag);
 
     size_t hashsize;                 /* size of the hash array - always a power-of-2-minus-1 */
     size_t collisions, log_hashsize; /* log(base 2) of hashsize+1 */
@@ -51,6 +59,7 @@ class hash_vector_base {
     struct lookup_cache {
         size_t slot;
         size_t collisions;
+        uint8_t tag;
         uint32_t getidx(const hash_vector_base *);
         const void *getkey(const hash_vector_base *);
         void *getval(hash_vector_base *);
@@ -80,6 +89,7 @@ class hash_vector_base {
     void clear();
     size_t find(const void *key, lookup_cache *cache) const;
     size_t find_next(const void *key, lookup_cache *cache) const;
+    size_t probe(const void *key, size_t slot, size_t collisions, lookup_cache *cache) const;
     void *lookup(const void *key, lookup_cache *cache = nullptr);
     void *lookup_next(const void *key, lookup_cache *cache = nullptr);
     size_t hv_insert(const void *key, lookup_cache *cache = nullptr);
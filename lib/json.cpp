@@ -25,6 +25,11 @@ limitations under the License.
 
 namespace P4::Util {
 
+void IJson::serialize(std::ostream &out) const {
+    JsonWriter writer(out);
+    serialize(writer);
+}
+
 cstring IJson::toString() const {
     std::stringstream str;
     serialize(str);
@@ -39,7 +44,9 @@ JsonValue::JsonValue(long long v) : tag(Kind::Number), value(v) {}
 
 JsonValue::JsonValue(unsigned long long v) : tag(Kind::Number), value(v) {}
 
-void JsonValue::serialize(std::ostream &out) const {
+void JsonValue::serialize(JsonWriter &out) const { out.value(*this); }
+
+void JsonValue::write(std::ostream &out) const {
     switch (tag) {
         case Kind::String:
             out << "\"" << str << "\"";
@@ -100,28 +107,14 @@ bool JsonValue::operator==(const JsonValue &other) const {
     }
 }
 
-void JsonArray::serialize(std::ostream &out) const {
+void JsonArray::serialize(JsonWriter &out) const {
     bool isSmall = true;
     for (auto v : *this) {
-        if (!v->is<JsonValue>()) isSmall = false;
+        if (v != nullptr && !v->is<JsonValue>()) isSmall = false;
     }
-    out << "[";
-    if (!isSmall) out << IndentCtl::indent;
-    bool first = true;
-    for (auto v : *this) {
-        if (!first) {
-            out << ",";
-            if (isSmall) out << " ";
-        }
-        if (!isSmall) out << IndentCtl::endl;
-        if (v == nullptr)
-            out << "null";
-        else
-            v->serialize(out);
-        first = false;
-    }
-    if (!isSmall) out << IndentCtl::unindent << IndentCtl::endl;
-    out << "]";
+    out.beginArray(isSmall);
+    for (auto v : *this) out.value(v);
+    out.endArray();
 }
 
 bool JsonValue::getBool() const {
@@ -150,20 +143,10 @@ JsonArray *JsonArray::append(IJson *value) {
     return this;
 }
 
-void JsonObject::serialize(std::ostream &out) const {
-    out << "{" << IndentCtl::indent;
-    bool first = true;
-    for (auto &it : *this) {
-        if (!first) out << ",";
-        first = false;
-        out << IndentCtl::endl;
-        out << "\"" << it.first << "\"" << " : ";
-        if (it.second == nullptr)
-            out << "null";
-        else
-            it.second->serialize(out);
-    }
-    out << IndentCtl::unindent << IndentCtl::endl << "}";
+void JsonObject::serialize(JsonWriter &out) const {
+    out.beginObject();
+    for (auto &it : *this) out.key(it.first.string_view()).value(it.second);
+    out.endObject();
 }
 
 JsonObject *JsonObject::emplace(cstring label, IJson *value) {
@@ -200,4 +183,90 @@ JsonObject *JsonObject::emplace_non_null(cstring label, IJson *value) {
     return this;
 }
 
+void JsonWriter::newline() {
+    // like IndentCtl::endl, but without flushing the stream on every line
+    out << '\n' << indent_t::getindent(out);
+}
+
+void JsonWriter::startValue() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (stack.empty()) return;
+    auto &level = stack.back();
+    if (level.isObject) throw std::logic_error("JsonWriter: object member without a key");
+    if (!level.first) out << (level.small ? ", " : ",");
+    if (!level.small) newline();
+    level.first = false;
+}
+
+JsonWriter &JsonWriter::beginObject() {
+    startValue();
+    out << "{";
+    ++indent_t::getindent(out);
+    stack.push_back({true, false});
+    return *this;
+}
+
+JsonWriter &JsonWriter::endObject() {
+    if (stack.empty() || !stack.back().isObject || afterKey)
+        throw std::logic_error("JsonWriter: mismatched endObject");
+    stack.pop_back();
+    --indent_t::getindent(out);
+    newline();
+    out << "}";
+    return *this;
+}
+
+JsonWriter &JsonWriter::beginArray(bool small) {
+    startValue();
+    out << "[";
+    if (!small) ++indent_t::getindent(out);
+    stack.push_back({false, small});
+    return *this;
+}
+
+JsonWriter &JsonWriter::endArray() {
+    if (stack.empty() || stack.back().isObject)
+        throw std::logic_error("JsonWriter: mismatched endArray");
+    auto level = stack.back();
+    stack.pop_back();
+    if (!level.small) {
+        --indent_t::getindent(out);
+        // an empty array is always written as a small one
+        if (!level.first) newline();
+    }
+    out << "]";
+    return *this;
+}
+
+JsonWriter &JsonWriter::key(std::string_view label) {
+    if (stack.empty() || !stack.back().isObject || afterKey)
+        throw std::logic_error("JsonWriter: key outside of an object");
+    auto &level = stack.back();
+    if (!level.first) out << ",";
+    level.first = false;
+    newline();
+    out << "\"" << label << "\"" << " : ";
+    afterKey = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(const JsonValue &v) {
+    startValue();
+    v.write(out);
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(const IJson *v) {
+    if (v == nullptr) {
+        startValue();
+        out << "null";
+    } else {
+        v->serialize(*this);
+    }
+    return *this;
+}
+
 }  // namespace P4::Util
@@ -19,6 +19,7 @@ limitations under the License.
 
 #include <iostream>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -38,10 +39,13 @@ class TestJson;
 
 namespace P4::Util {
 
+class JsonWriter;
+
 class IJson : public ICastable {
  public:
     virtual ~IJson() {}
-    virtual void serialize(std::ostream &out) const = 0;
+    void serialize(std::ostream &out) const;
+    virtual void serialize(JsonWriter &out) const = 0;
     cstring toString() const;
     void dump() const;
 
@@ -71,7 +75,10 @@ class JsonValue final : public IJson {
     // std::string is implicitly convertible to cstring
     JsonValue(const char *s) : tag(Kind::String), str(s) {}         // NOLINT
     JsonValue(const std::string &s) : tag(Kind::String), str(s) {}  // NOLINT
-    void serialize(std::ostream &out) const override;
+    using IJson::serialize;
+    void serialize(JsonWriter &out) const override;
+    /// Write just the value's text, with no layout.
+    void write(std::ostream &out) const;
 
     bool operator==(const big_int &v) const;
     // is_integral is true for bool
@@ -117,7 +124,8 @@ class JsonArray final : public IJson, public std::vector<IJson *> {
     friend class Test::TestJson;
 
  public:
-    void serialize(std::ostream &out) const override;
+    using IJson::serialize;
+    void serialize(JsonWriter &out) const override;
     JsonArray *clone() const { return new JsonArray(*this); }
     JsonArray *append(IJson *value);
     JsonArray *append(big_int v) {
@@ -169,7 +177,8 @@ class JsonObject final : public IJson, public string_map<IJson *> {
 
  public:
     JsonObject() = default;
-    void serialize(std::ostream &out) const override;
+    using IJson::serialize;
+    void serialize(JsonWriter &out) const override;
     JsonObject *emplace_non_null(cstring label, IJson *value);
 
     JsonObject *emplace(cstring label, IJson *value);
@@ -192,6 +201,52 @@ class JsonObject final : public IJson, public string_map<IJson *> {
     DECLARE_TYPEINFO(JsonObject, IJson);
 };
 
+/// Streaming JSON emitter.  Writes JSON incrementally to a stream in exactly the layout that
+/// IJson::serialize produces for the equivalent tree, so output can be generated without
+/// first building the whole tree.  Subtrees may be mixed in with value(const IJson *).
+/// Indentation is taken from and kept in the stream's IndentCtl state.
+class JsonWriter {
+ public:
+    explicit JsonWriter(std::ostream &out) : out(out) {}
+    /// True once every object and array begun has been ended.
+    bool complete() const { return stack.empty() && !afterKey; }
+
+    JsonWriter &beginObject();
+    JsonWriter &endObject();
+    /// A @p small array holds only plain values and is written on a single line.
+    JsonWriter &beginArray(bool small = false);
+    JsonWriter &endArray();
+    /// Start a member of the current object; must be followed by its value.
+    JsonWriter &key(std::string_view label);
+
+    JsonWriter &value(const JsonValue &v);
+    JsonWriter &value(const IJson *v);
+    JsonWriter &null() { return value(static_cast<const IJson *>(nullptr)); }
+    template <class T, typename = std::enable_if_t<!std::is_convertible_v<T, const IJson *> &&
+                                                   !std::is_same_v<std::decay_t<T>, JsonValue>>>
+    JsonWriter &value(T &&v) {
+        return value(JsonValue(std::forward<T>(v)));
+    }
+    template <class T>
+    JsonWriter &member(std::string_view label, T &&v) {
+        return key(label).value(std::forward<T>(v));
+    }
+
+ private:
+    struct Level {
+        bool isObject;
+        bool small;
+        bool first = true;
+    };
+    std::ostream &out;
+    std::vector<Level> stack;
+    bool afterKey = false;
+
+    /// Emit the separator and layout needed before the next value.
+    void startValue();
+    void newline();
+};
+
 }  // namespace P4::Util
 
 #endif /* LIB_JSON_H_ */
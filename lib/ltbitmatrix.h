@@ -65,10 +65,7 @@ class LTBitMatrix : private bitvec {
         friend class LTBitMatrix;
         using rowref<LTBitMatrix>::rowref;
         void operator|=(bitvec a) const {
-            for (size_t v : a) {
-                if (v > row) break;
-                self(row, v) = 1;
-            }
+            self.orslice((row * row + row) / 2, a.getslice(0, row + 1));
         }
         nonconst_bitref operator[](unsigned col) const { return self(row, col); }
     };
@@ -70,7 +70,7 @@ std::ostream &operator<<(std::ostream &os, const SourceInfo &info) {
 
 InputSources::InputSources() : sealed(false) {
     mapLine("", 1);  // the first line read will be line 1 of stdin
-    contents.push_back("");
+    lineStarts.push_back(0);
 }
 
 void InputSources::addComment(SourceInfo srcInfo, bool singleLine, cstring body) {
@@ -89,9 +89,14 @@ void InputSources::seal() {
     sealed = true;
 }
 
+void InputSources::reserve(size_t size) {
+    if (sealed) BUG("Appending to sealed InputSources");
+    contents.reserve(contents.size() + size);
+}
+
 unsigned InputSources::lineCount() const {
-    int size = contents.size();
-    if (contents.back().empty()) {
+    int size = lineStarts.size();
+    if (contents.size() == lineStarts.back()) {
         // do not count the last line if it is empty.
         size -= 1;
         if (size < 0) BUG("Negative line count");
@@ -103,18 +108,15 @@ unsigned InputSources::lineCount() const {
 void InputSources::appendToLastLine(std::string_view text) {
     if (sealed) BUG("Appending to sealed InputSources");
     // Text should not contain any newline characters
-    for (size_t i = 0; i < text.size(); i++) {
-        char c = text[i];
-        if (c == '\n') BUG("Text contains newlines");
-    }
-    contents.back() += text;
+    if (text.find('\n') != std::string_view::npos) BUG("Text contains newlines");
+    contents += text;
 }
 
 // Append a newline and start a new line
 void InputSources::appendNewline(std::string_view newline) {
     if (sealed) BUG("Appending to sealed InputSources");
-    contents.back() += newline;
-    contents.push_back("");  // start a new line
+    contents += newline;
+    lineStarts.push_back(contents.size());  // start a new line
 }
 
 void InputSources::appendText(const char *text) {
@@ -156,7 +158,9 @@ std::string_view InputSources::getLine(unsigned lineNumber) const {
         // don't throw: this code may be called by exceptions
         // reporting on elements that have no source position
     }
-    return contents.at(lineNumber - 1);
+    size_t start = lineStarts.at(lineNumber - 1);
+    size_t end = lineNumber < lineStarts.size() ? lineStarts[lineNumber] : contents.size();
+    return std::string_view(contents).substr(start, end - start);
 }
 
 void InputSources::mapLine(std::string_view file, unsigned originalSourceLineNo) {
@@ -186,11 +190,11 @@ SourceFileLine InputSources::getSourceLine(unsigned line) const {
     return SourceFileLine(it->second.fileName, realLine);
 }
 
-unsigned InputSources::getCurrentLineNumber() const { return contents.size(); }
+unsigned InputSources::getCurrentLineNumber() const { return lineStarts.size(); }
 
 SourcePosition InputSources::getCurrentPosition() const {
     unsigned line = getCurrentLineNumber();
-    unsigned column = contents.back().size();
+    unsigned column = contents.size() - lineStarts.back();
     return SourcePosition(line, column);
 }
 
@@ -305,7 +309,7 @@ cstring InputSources::getBriefSourceFragment(const SourceInfo &position) const {
 
 cstring InputSources::toDebugString() const {
     std::stringstream builder;
-    for (const auto &line : contents) builder << line;
+    builder << contents;
     builder << "---------------" << std::endl;
     for (const auto &lf : line_file_map)
         builder << lf.first << ": " << lf.second.toString() << std::endl;
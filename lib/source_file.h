@@ -309,6 +309,9 @@ class InputSources final {
     /// Prevents further changes; currently not used.
     void seal();
 
+    /// Hint that about @p size more bytes of text will be appended.
+    void reserve(size_t size);
+
     /// Append this text; it is either a newline or a text with no newlines.
     void appendText(const char *text);
 
@@ -343,8 +346,10 @@ class InputSources final {
 
     std::map<unsigned, SourceFileLine> line_file_map;
 
-    /// Each line also stores the end-of-line character(s)
-    std::vector<std::string> contents;
+    /// The text of all lines, each including its end-of-line character(s)
+    std::string contents;
+    /// Offset in 'contents' where each line starts; the last entry is the line being appended
+    std::vector<size_t> lineStarts;
     /// The commends found in the file.
     std::vector<Comment *> comments;
 };
@@ -81,9 +81,10 @@ class SymBitMatrix : private bitvec {
         friend class SymBitMatrix;
         using rowref<SymBitMatrix>::rowref;
         void operator|=(bitvec a) const {
-            for (size_t v : a) {
-                self(row, v) = 1;
-            }
+            // Columns up to the diagonal are contiguous in the triangle and are or'd in a word
+            // at a time, the ones past it are spread over the later rows.
+            self.orslice((row * row + row) / 2, a.getslice(0, row + 1));
+            for (int v = a.ffs(row + 1); v >= 0; v = a.ffs(v + 1)) self(row, v) = 1;
         }
         nonconst_bitref operator[](unsigned col) const { return self(row, col); }
     };
@@ -93,6 +93,51 @@ TEST(Bitvec, getslice) {
     EXPECT_EQ(slice.ffs(80), 96);
 }
 
+TEST(Bitvec, getslice_multiword) {
+    bitvec bv(99, 250);
+    auto slice = bv.getslice(52, 174);
+    EXPECT_EQ(slice.popcount(), 127);
+    EXPECT_EQ(slice.ffs(0), 47);
+    EXPECT_EQ(slice.max().index(), 173);
+}
+
+TEST(Bitvec, orslice) {
+    bitvec bv(0, 3);
+    EXPECT_TRUE(bv.orslice(60, bitvec(0, 10)));
+    EXPECT_EQ(bv, bitvec(0, 3) | bitvec(60, 10));
+    EXPECT_FALSE(bv.orslice(62, bitvec(0, 8)));
+    EXPECT_TRUE(bv.orslice(200, bitvec(3, 70)));
+    EXPECT_EQ(bv.popcount(), 83);
+    EXPECT_EQ(bv.max().index(), 272);
+    EXPECT_FALSE(bv.orslice(5, bitvec()));
+}
+
+TEST(Bitvec, inline_to_heap) {
+    // grow from the inline words to heap storage and back again
+    bitvec bv(0, 1);
+    bv.setbit(bitvec::bits_per_unit * bitvec::inline_units - 1);
+    EXPECT_EQ(bv.popcount(), 2);
+    bitvec big = bv;
+    big.setbit(bitvec::bits_per_unit * bitvec::inline_units + 5);
+    EXPECT_EQ(big.popcount(), 3);
+    EXPECT_NE(big, bv);
+    EXPECT_TRUE(big.contains(bv));
+    EXPECT_FALSE(bv.contains(big));
+    EXPECT_TRUE(big.intersects(bv));
+    EXPECT_FALSE(bv |= bitvec(0, 1));
+    EXPECT_TRUE(bv |= big);
+    EXPECT_EQ(bv, big);
+    EXPECT_TRUE(big -= bitvec(bitvec::bits_per_unit * bitvec::inline_units, 32));
+    EXPECT_EQ(big.popcount(), 2);
+    EXPECT_TRUE(bv &= big);
+    EXPECT_EQ(bv, big);
+    bv >>= bitvec::bits_per_unit * bitvec::inline_units - 1;
+    EXPECT_EQ(bv, bitvec(1));
+    bitvec moved(std::move(big));
+    EXPECT_EQ(moved.popcount(), 2);
+    EXPECT_TRUE(big.empty());
+}
+
 TEST(Bitvec, rotate) {
     bitvec bv;
     bv.setrange(0, 4);
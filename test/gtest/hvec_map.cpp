@@ -18,6 +18,8 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 namespace P4::Test {
 
 TEST(hvec_map, map_equal) {
@@ -177,4 +179,42 @@ TEST(hvec_map, string_map) {
     }
 }
 
+TEST(hvec_map, colliding_keys) {
+    // a weak hash puts many keys into the same probe chains
+    struct weak_hash {
+        size_t operator()(unsigned k) const { return k % 5; }
+    };
+    hvec_map<unsigned, unsigned, weak_hash> m;
+    std::vector<unsigned> order;
+
+    for (unsigned i = 0; i < 400; ++i) {
+        m[i * 7] = i;
+        order.push_back(i * 7);
+    }
+    for (unsigned i = 0; i < 400; i += 3) EXPECT_EQ(m.erase(i * 7), 1U);
+    for (unsigned i = 0; i < 400; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_EQ(m.count(i * 7), 0U);
+        } else {
+            ASSERT_EQ(m.count(i * 7), 1U);
+            EXPECT_EQ(m.at(i * 7), i);
+        }
+    }
+    order.erase(std::remove_if(order.begin(), order.end(), [](unsigned k) { return k % 3 == 0; }),
+                order.end());
+    for (unsigned i = 400; i < 500; ++i) {
+        m.emplace(i * 7, i);
+        order.push_back(i * 7);
+    }
+    EXPECT_EQ(m.size(), order.size());
+    auto it = m.begin();
+    for (auto k : order) {
+        ASSERT_TRUE(it != m.end());
+        EXPECT_EQ(it->first, k);
+        EXPECT_EQ(it->second, k / 7);
+        ++it;
+    }
+    EXPECT_TRUE(it == m.end());
+}
+
 }  // namespace P4::Test
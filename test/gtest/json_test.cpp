@@ -72,4 +72,46 @@ TEST(Util, Json) {
               obj->toString());
 }
 
+TEST(Util, JsonWriter) {
+    auto arr = new JsonArray();
+    arr->append(5)->append("5")->append(new JsonArray());
+    auto obj = new JsonObject();
+    obj->emplace("x", "x");
+    obj->emplace("y", arr);
+    obj->emplace("z", new JsonObject());
+
+    std::stringstream str;
+    JsonWriter writer(str);
+    writer.beginObject()
+        .member("x", "x")
+        .key("y")
+        .beginArray()
+        .value(5)
+        .value("5")
+        .beginArray()
+        .endArray()
+        .endArray()
+        .key("z")
+        .beginObject()
+        .endObject()
+        .endObject();
+    EXPECT_TRUE(writer.complete());
+    EXPECT_EQ(obj->toString(), str.str());
+
+    // streamed members and prebuilt subtrees mix freely
+    std::stringstream mixed;
+    JsonWriter writer1(mixed);
+    writer1.beginArray().value(obj).beginArray(true).value(true).null().endArray().endArray();
+    auto arr1 = new JsonArray();
+    arr1->append(obj);
+    arr1->append((new JsonArray())->append(true)->append(static_cast<IJson *>(nullptr)));
+    EXPECT_EQ(arr1->toString(), mixed.str());
+
+    std::stringstream bad;
+    JsonWriter writer2(bad);
+    writer2.beginObject();
+    EXPECT_THROW(writer2.value(1), std::logic_error);
+    EXPECT_THROW(writer2.endArray(), std::logic_error);
+}
+
 }  // namespace P4::Util
@@ -73,6 +73,9 @@ TEST(UtilSourceFile, InputSources) {
     auto sl = sources.getLine(2);
     EXPECT_EQ("Second line\n", sl);
 
+    EXPECT_EQ("Third line\n", sources.getLine(3));
+    EXPECT_EQ("", sources.getLine(4));
+
     SourceFileLine original = sources.getSourceLine(3);
     EXPECT_EQ("fakesource.p4", original.fileName);
     EXPECT_EQ(5u, original.sourceLine);